@@ -346,6 +346,758 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+// size classes step by a quarter of each power of two, from 64 bytes up to 1G
+// larger blocks bypass the caches
+#define SIZE_CLASS_COUNT 97
+
+static NCNN_FORCEINLINE int size_class_highest_bit(size_t n)
+{
+#if defined __GNUC__
+    return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)n);
+#else
+    int e = 0;
+    while (n >>= 1)
+        e++;
+    return e;
+#endif
+}
+
+static NCNN_FORCEINLINE int size_class_index(size_t size)
+{
+    size_t n = (size < 64 ? 64 : size) - 1;
+    int e = size_class_highest_bit(n);
+    int m = (int)(n >> (e - 2)); // 4 ~ 7
+    int index = (e - 5) * 4 + m - 7;
+    return index < SIZE_CLASS_COUNT ? index : -1;
+}
+
+static NCNN_FORCEINLINE size_t size_class_size(int index)
+{
+    int e = 5 + (index + 7) / 4 - 1;
+    int m = (index + 7) % 4 + 4;
+    return (size_t)(m + 1) << (e - 2);
+}
+
+// lives in front of every block, next is only valid while the block is cached
+struct size_class_block
+{
+    size_class_block* next;
+    int index;
+};
+
+#if NCNN_THREADS && defined __GNUC__
+static NCNN_FORCEINLINE size_class_block* size_class_atomic_load(size_class_block** p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+static NCNN_FORCEINLINE size_class_block* size_class_atomic_exchange(size_class_block** p, size_class_block* v)
+{
+    return __atomic_exchange_n(p, v, __ATOMIC_ACQ_REL);
+}
+static NCNN_FORCEINLINE bool size_class_atomic_cas(size_class_block** p, size_class_block* expected, size_class_block* desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+}
+static NCNN_FORCEINLINE size_t size_class_counter_load(const size_t* p)
+{
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+}
+static NCNN_FORCEINLINE void size_class_counter_add(size_t* p, size_t v)
+{
+    // single writer, the atomic store only keeps readers from tearing
+    __atomic_store_n(p, __atomic_load_n(p, __ATOMIC_RELAXED) + v, __ATOMIC_RELAXED);
+}
+#elif NCNN_THREADS && defined _MSC_VER
+static NCNN_FORCEINLINE size_class_block* size_class_atomic_load(size_class_block** p)
+{
+    return *(size_class_block* volatile*)p;
+}
+static NCNN_FORCEINLINE size_class_block* size_class_atomic_exchange(size_class_block** p, size_class_block* v)
+{
+    return (size_class_block*)InterlockedExchangePointer((PVOID volatile*)p, (PVOID)v);
+}
+static NCNN_FORCEINLINE bool size_class_atomic_cas(size_class_block** p, size_class_block* expected, size_class_block* desired)
+{
+    return InterlockedCompareExchangePointer((PVOID volatile*)p, (PVOID)desired, (PVOID)expected) == (PVOID)expected;
+}
+static NCNN_FORCEINLINE size_t size_class_counter_load(const size_t* p)
+{
+    return *(const volatile size_t*)p;
+}
+static NCNN_FORCEINLINE void size_class_counter_add(size_t* p, size_t v)
+{
+    *(volatile size_t*)p = *(volatile size_t*)p + v;
+}
+#else
+static NCNN_FORCEINLINE size_class_block* size_class_atomic_load(size_class_block** p)
+{
+    return *p;
+}
+static NCNN_FORCEINLINE size_class_block* size_class_atomic_exchange(size_class_block** p, size_class_block* v)
+{
+    size_class_block* old = *p;
+    *p = v;
+    return old;
+}
+static NCNN_FORCEINLINE bool size_class_atomic_cas(size_class_block** p, size_class_block* expected, size_class_block* desired)
+{
+    if (*p != expected)
+        return false;
+    *p = desired;
+    return true;
+}
+static NCNN_FORCEINLINE size_t size_class_counter_load(const size_t* p)
+{
+    return *p;
+}
+static NCNN_FORCEINLINE void size_class_counter_add(size_t* p, size_t v)
+{
+    *p += v;
+}
+#endif
+
+// owned by one thread, other threads only read the counters
+struct size_class_thread_cache
+{
+    size_class_block* heads[SIZE_CLASS_COUNT];
+    int counts[SIZE_CLASS_COUNT];
+
+    size_t hits;
+    size_t misses;
+    size_t bytes_cached;
+    size_t bytes_reused;
+};
+
+class SizeClassPoolAllocatorPrivate
+{
+public:
+    size_class_thread_cache* get_thread_cache();
+
+    int thread_cache_limit;
+
+    // lock-free freelists shared by all threads
+    // blocks are only pushed one by one and popped as a whole chain, so there is no ABA hazard
+    size_class_block* shared_heads[SIZE_CLASS_COUNT];
+
+    ThreadLocalStorage tls_thread_cache;
+
+    // every thread cache ever created, guarded for registration only
+    Mutex thread_caches_lock;
+    std::vector<size_class_thread_cache*> thread_caches;
+};
+
+size_class_thread_cache* SizeClassPoolAllocatorPrivate::get_thread_cache()
+{
+    size_class_thread_cache* cache = (size_class_thread_cache*)tls_thread_cache.get();
+    if (cache)
+        return cache;
+
+    cache = new size_class_thread_cache;
+    for (int i = 0; i < SIZE_CLASS_COUNT; i++)
+    {
+        cache->heads[i] = 0;
+        cache->counts[i] = 0;
+    }
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->bytes_cached = 0;
+    cache->bytes_reused = 0;
+
+    {
+        MutexLockGuard lock(thread_caches_lock);
+        thread_caches.push_back(cache);
+    }
+
+    tls_thread_cache.set(cache);
+
+    return cache;
+}
+
+SizeClassPoolAllocator::SizeClassPoolAllocator()
+    : Allocator(), d(new SizeClassPoolAllocatorPrivate)
+{
+    d->thread_cache_limit = 16;
+
+    for (int i = 0; i < SIZE_CLASS_COUNT; i++)
+    {
+        d->shared_heads[i] = 0;
+    }
+}
+
+SizeClassPoolAllocator::~SizeClassPoolAllocator()
+{
+    clear();
+
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        delete d->thread_caches[i];
+    }
+
+    delete d;
+}
+
+SizeClassPoolAllocator::SizeClassPoolAllocator(const SizeClassPoolAllocator&)
+    : d(0)
+{
+}
+
+SizeClassPoolAllocator& SizeClassPoolAllocator::operator=(const SizeClassPoolAllocator&)
+{
+    return *this;
+}
+
+void SizeClassPoolAllocator::set_thread_cache_limit(int limit)
+{
+    if (limit < 0)
+    {
+        NCNN_LOGE("invalid thread cache limit %d", limit);
+        return;
+    }
+
+    d->thread_cache_limit = limit;
+}
+
+void SizeClassPoolAllocator::clear()
+{
+    MutexLockGuard lock(d->thread_caches_lock);
+
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        size_class_thread_cache* cache = d->thread_caches[i];
+
+        for (int j = 0; j < SIZE_CLASS_COUNT; j++)
+        {
+            size_class_block* blk = cache->heads[j];
+            while (blk)
+            {
+                size_class_block* next = blk->next;
+                ncnn::fastFree(blk);
+                blk = next;
+            }
+
+            cache->heads[j] = 0;
+            cache->counts[j] = 0;
+        }
+
+        cache->bytes_cached = 0;
+        cache->bytes_reused = 0;
+    }
+
+    for (int j = 0; j < SIZE_CLASS_COUNT; j++)
+    {
+        size_class_block* blk = size_class_atomic_exchange(&d->shared_heads[j], 0);
+        while (blk)
+        {
+            size_class_block* next = blk->next;
+            ncnn::fastFree(blk);
+            blk = next;
+        }
+    }
+}
+
+size_t SizeClassPoolAllocator::hit_count() const
+{
+    MutexLockGuard lock(d->thread_caches_lock);
+
+    size_t count = 0;
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        count += size_class_counter_load(&d->thread_caches[i]->hits);
+    }
+
+    return count;
+}
+
+size_t SizeClassPoolAllocator::miss_count() const
+{
+    MutexLockGuard lock(d->thread_caches_lock);
+
+    size_t count = 0;
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        count += size_class_counter_load(&d->thread_caches[i]->misses);
+    }
+
+    return count;
+}
+
+size_t SizeClassPoolAllocator::bytes_held() const
+{
+    MutexLockGuard lock(d->thread_caches_lock);
+
+    // blocks migrate between threads, so only the sum is meaningful
+    size_t cached = 0;
+    size_t reused = 0;
+    for (size_t i = 0; i < d->thread_caches.size(); i++)
+    {
+        cached += size_class_counter_load(&d->thread_caches[i]->bytes_cached);
+        reused += size_class_counter_load(&d->thread_caches[i]->bytes_reused);
+    }
+
+    return cached - reused;
+}
+
+void* SizeClassPoolAllocator::fastMalloc(size_t size)
+{
+    size_class_thread_cache* cache = d->get_thread_cache();
+
+    const int index = size_class_index(size);
+    if (index == -1)
+    {
+        size_class_counter_add(&cache->misses, 1);
+
+        size_class_block* blk = (size_class_block*)ncnn::fastMalloc(NCNN_MALLOC_ALIGN + size);
+        if (!blk)
+            return 0;
+
+        blk->index = -1;
+        return (unsigned char*)blk + NCNN_MALLOC_ALIGN;
+    }
+
+    const size_t class_size = size_class_size(index);
+
+    if (!cache->heads[index])
+    {
+        // refill from the shared freelist
+        size_class_block* chain = size_class_atomic_exchange(&d->shared_heads[index], 0);
+        if (chain)
+        {
+            int count = 1;
+            size_class_block* tail = chain;
+            while (tail->next)
+            {
+                tail = tail->next;
+                count++;
+            }
+
+            cache->heads[index] = chain;
+            cache->counts[index] = count;
+        }
+    }
+
+    size_class_block* blk = cache->heads[index];
+    if (blk)
+    {
+        cache->heads[index] = blk->next;
+        cache->counts[index]--;
+
+        size_class_counter_add(&cache->hits, 1);
+        size_class_counter_add(&cache->bytes_reused, class_size);
+
+        return (unsigned char*)blk + NCNN_MALLOC_ALIGN;
+    }
+
+    size_class_counter_add(&cache->misses, 1);
+
+    blk = (size_class_block*)ncnn::fastMalloc(NCNN_MALLOC_ALIGN + class_size);
+    if (!blk)
+        return 0;
+
+    blk->index = index;
+    return (unsigned char*)blk + NCNN_MALLOC_ALIGN;
+}
+
+void SizeClassPoolAllocator::fastFree(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    size_class_block* blk = (size_class_block*)((unsigned char*)ptr - NCNN_MALLOC_ALIGN);
+
+    const int index = blk->index;
+    if (index == -1)
+    {
+        ncnn::fastFree(blk);
+        return;
+    }
+
+    size_class_thread_cache* cache = d->get_thread_cache();
+
+    size_class_counter_add(&cache->bytes_cached, size_class_size(index));
+
+    if (cache->counts[index] < d->thread_cache_limit)
+    {
+        blk->next = cache->heads[index];
+        cache->heads[index] = blk;
+        cache->counts[index]++;
+        return;
+    }
+
+    // thread cache is full, push to the shared freelist
+    for (;;)
+    {
+        size_class_block* head = size_class_atomic_load(&d->shared_heads[index]);
+        blk->next = head;
+        if (size_class_atomic_cas(&d->shared_heads[index], head, blk))
+            break;
+    }
+}
+
+class ArenaAllocatorPrivate
+{
+public:
+    struct arena_plan
+    {
+        size_t key;
+        size_t arena_size;
+        std::vector<size_t> sizes;
+        std::vector<size_t> offsets;
+    };
+
+    Mutex lock;
+
+    unsigned char* arena;
+    size_t arena_capacity;
+    std::vector<arena_plan> plans;
+
+    // 0 = heap, 1 = record, 2 = replay
+    int mode;
+    size_t key;
+    int plan_index;
+    int cursor;
+
+    // allocation trace of the recording pass
+    int time;
+    std::vector<size_t> trace_sizes;
+    std::vector<int> trace_alloc_times;
+    std::vector<int> trace_free_times;
+
+    // live pointer and its trace index, -1 for allocations outside the trace
+    std::list<std::pair<void*, int> > payouts;
+
+    bool in_arena(const void* ptr) const
+    {
+        return arena && (const unsigned char*)ptr >= arena && (const unsigned char*)ptr < arena + arena_capacity;
+    }
+
+    void finish_pass();
+};
+
+static size_t plan_arena_offsets(const std::vector<size_t>& sizes, const std::vector<int>& alloc_times, const std::vector<int>& free_times, std::vector<size_t>& offsets)
+{
+    const int n = (int)sizes.size();
+
+    // place the larger allocations first, they are the hardest to fit
+    std::vector<int> order(n);
+    for (int i = 0; i < n; i++)
+    {
+        int j = i;
+        while (j > 0 && sizes[order[j - 1]] < sizes[i])
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    offsets.resize(n);
+
+    size_t arena_size = 0;
+    std::vector<int> placed;
+    std::vector<int> overlaps;
+    for (int ii = 0; ii < n; ii++)
+    {
+        const int i = order[ii];
+        const size_t size = alignSize(sizes[i], NCNN_MALLOC_ALIGN);
+
+        // placed allocations alive at the same time, sorted by offset
+        overlaps.clear();
+        for (size_t jj = 0; jj < placed.size(); jj++)
+        {
+            const int j = placed[jj];
+            if (alloc_times[j] >= free_times[i] || alloc_times[i] >= free_times[j])
+                continue;
+
+            overlaps.push_back(j);
+            for (size_t k = overlaps.size() - 1; k > 0 && offsets[overlaps[k - 1]] > offsets[j]; k--)
+            {
+                std::swap(overlaps[k - 1], overlaps[k]);
+            }
+        }
+
+        // first gap large enough
+        size_t offset = 0;
+        for (size_t jj = 0; jj < overlaps.size(); jj++)
+        {
+            const int j = overlaps[jj];
+            if (offsets[j] >= offset + size)
+                break;
+
+            offset = std::max(offset, offsets[j] + alignSize(sizes[j], NCNN_MALLOC_ALIGN));
+        }
+
+        offsets[i] = offset;
+        placed.push_back(i);
+
+        arena_size = std::max(arena_size, offset + size);
+    }
+
+    return arena_size;
+}
+
+void ArenaAllocatorPrivate::finish_pass()
+{
+    if (mode == 1 && !trace_sizes.empty())
+    {
+        // allocations still alive at the end of pass live forever
+        const int n = (int)trace_sizes.size();
+        for (int i = 0; i < n; i++)
+        {
+            if (trace_free_times[i] == -1)
+                trace_free_times[i] = time;
+        }
+
+        arena_plan plan;
+        plan.key = key;
+        plan.sizes = trace_sizes;
+        plan.arena_size = plan_arena_offsets(trace_sizes, trace_alloc_times, trace_free_times, plan.offsets);
+
+        plans.push_back(plan);
+    }
+
+    // the pass was not served from the planned arena
+    // forget the plan so that the next pass with the key records again
+    if (mode == 0 && plan_index != -1)
+    {
+        plans.erase(plans.begin() + plan_index);
+    }
+
+    trace_sizes.clear();
+    trace_alloc_times.clear();
+    trace_free_times.clear();
+
+    // allocations that outlive the pass do not belong to any trace
+    std::list<std::pair<void*, int> >::iterator it = payouts.begin();
+    for (; it != payouts.end(); ++it)
+    {
+        it->second = -1;
+    }
+
+    mode = 0;
+    plan_index = -1;
+    cursor = 0;
+    time = 0;
+}
+
+ArenaAllocator::ArenaAllocator()
+    : Allocator(), d(new ArenaAllocatorPrivate)
+{
+    d->arena = 0;
+    d->arena_capacity = 0;
+    d->mode = 0;
+    d->key = 0;
+    d->plan_index = -1;
+    d->cursor = 0;
+    d->time = 0;
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    clear();
+
+    if (!d->payouts.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! arena allocator destroyed too early");
+#if NCNN_STDIO
+        std::list<std::pair<void*, int> >::iterator it = d->payouts.begin();
+        for (; it != d->payouts.end(); ++it)
+        {
+            void* ptr = it->first;
+            NCNN_LOGE("%p still in use", ptr);
+        }
+#endif
+    }
+
+    delete d;
+}
+
+ArenaAllocator::ArenaAllocator(const ArenaAllocator&)
+    : d(0)
+{
+}
+
+ArenaAllocator& ArenaAllocator::operator=(const ArenaAllocator&)
+{
+    return *this;
+}
+
+void ArenaAllocator::begin(size_t key)
+{
+    MutexLockGuard lock(d->lock);
+
+    d->finish_pass();
+
+    d->key = key;
+
+    for (int i = 0; i < (int)d->plans.size(); i++)
+    {
+        if (d->plans[i].key == key)
+        {
+            d->plan_index = i;
+            break;
+        }
+    }
+
+    if (d->plan_index == -1)
+    {
+        // unseen key, record the allocation trace
+        d->mode = 1;
+        return;
+    }
+
+    const size_t arena_size = d->plans[d->plan_index].arena_size;
+    if (arena_size > d->arena_capacity)
+    {
+        // grow only when nothing lives in the old arena
+        std::list<std::pair<void*, int> >::iterator it = d->payouts.begin();
+        for (; it != d->payouts.end(); ++it)
+        {
+            if (d->in_arena(it->first))
+            {
+                d->plan_index = -1;
+                return;
+            }
+        }
+
+        ncnn::fastFree(d->arena);
+        d->arena = (unsigned char*)ncnn::fastMalloc(arena_size);
+        d->arena_capacity = d->arena ? arena_size : 0;
+        if (!d->arena)
+        {
+            d->plan_index = -1;
+            return;
+        }
+    }
+
+    d->mode = 2;
+}
+
+void ArenaAllocator::clear()
+{
+    MutexLockGuard lock(d->lock);
+
+    d->finish_pass();
+
+    d->plans.clear();
+
+    std::list<std::pair<void*, int> >::iterator it = d->payouts.begin();
+    for (; it != d->payouts.end(); ++it)
+    {
+        if (d->in_arena(it->first))
+        {
+            // keep the arena for the allocations still in use
+            return;
+        }
+    }
+
+    ncnn::fastFree(d->arena);
+    d->arena = 0;
+    d->arena_capacity = 0;
+}
+
+size_t ArenaAllocator::arena_size() const
+{
+    MutexLockGuard lock(d->lock);
+
+    return d->arena_capacity;
+}
+
+void* ArenaAllocator::fastMalloc(size_t size)
+{
+    MutexLockGuard lock(d->lock);
+
+    if (d->mode == 2)
+    {
+        const ArenaAllocatorPrivate::arena_plan& plan = d->plans[d->plan_index];
+
+        if (d->cursor < (int)plan.sizes.size() && plan.sizes[d->cursor] == size)
+        {
+            unsigned char* ptr = d->arena + plan.offsets[d->cursor];
+            const size_t aligned_size = alignSize(size, NCNN_MALLOC_ALIGN);
+
+            // the planned region must not be in use, lifetimes may differ from the recorded pass
+            bool occupied = false;
+            std::list<std::pair<void*, int> >::iterator it = d->payouts.begin();
+            for (; it != d->payouts.end(); ++it)
+            {
+                const unsigned char* p = (const unsigned char*)it->first;
+                if (!d->in_arena(p))
+                    continue;
+
+                // the extent of an arena allocation from an earlier pass is unknown
+                if (it->second == -1)
+                {
+                    occupied = true;
+                    break;
+                }
+
+                const size_t psize = alignSize(plan.sizes[it->second], NCNN_MALLOC_ALIGN);
+                if (p < ptr + aligned_size && ptr < p + psize)
+                {
+                    occupied = true;
+                    break;
+                }
+            }
+
+            if (!occupied)
+            {
+                d->payouts.push_back(std::make_pair((void*)ptr, d->cursor));
+                d->cursor++;
+                return ptr;
+            }
+        }
+
+        // diverged from the plan, serve the rest of this pass from heap
+        d->mode = 0;
+    }
+
+    void* ptr = ncnn::fastMalloc(size);
+
+    if (d->mode == 1)
+    {
+        d->payouts.push_back(std::make_pair(ptr, (int)d->trace_sizes.size()));
+
+        d->trace_sizes.push_back(size);
+        d->trace_alloc_times.push_back(d->time++);
+        d->trace_free_times.push_back(-1);
+    }
+    else
+    {
+        d->payouts.push_back(std::make_pair(ptr, -1));
+    }
+
+    return ptr;
+}
+
+void ArenaAllocator::fastFree(void* ptr)
+{
+    MutexLockGuard lock(d->lock);
+
+    std::list<std::pair<void*, int> >::iterator it = d->payouts.begin();
+    for (; it != d->payouts.end(); ++it)
+    {
+        if (it->first == ptr)
+        {
+            if (d->mode == 1 && it->second != -1)
+            {
+                d->trace_free_times[it->second] = d->time++;
+            }
+
+            d->payouts.erase(it);
+
+            if (!d->in_arena(ptr))
+            {
+                ncnn::fastFree(ptr);
+            }
+
+            return;
+        }
+    }
+
+    NCNN_LOGE("FATAL ERROR! arena allocator get wild %p", ptr);
+    ncnn::fastFree(ptr);
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
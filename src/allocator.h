@@ -205,6 +205,72 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+class SizeClassPoolAllocatorPrivate;
+class NCNN_EXPORT SizeClassPoolAllocator : public Allocator
+{
+public:
+    SizeClassPoolAllocator();
+    ~SizeClassPoolAllocator();
+
+    // max cached blocks of one size class in each thread cache
+    // the surplus is handed over to the shared lock-free freelist
+    // default limit = 16
+    void set_thread_cache_limit(int limit);
+
+    // release all cached blocks immediately
+    // must not be called concurrently with fastMalloc or fastFree
+    void clear();
+
+    // number of fastMalloc calls served from cache
+    size_t hit_count() const;
+
+    // number of fastMalloc calls served from heap
+    size_t miss_count() const;
+
+    // bytes of freed blocks kept in the caches
+    size_t bytes_held() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    SizeClassPoolAllocator(const SizeClassPoolAllocator&);
+    SizeClassPoolAllocator& operator=(const SizeClassPoolAllocator&);
+
+private:
+    SizeClassPoolAllocatorPrivate* const d;
+};
+
+class ArenaAllocatorPrivate;
+class NCNN_EXPORT ArenaAllocator : public Allocator
+{
+public:
+    ArenaAllocator();
+    ~ArenaAllocator();
+
+    // start a new forward pass for the given input shape key
+    // the first pass of a key is served from heap and its allocation trace is recorded
+    // the following passes of the same key are served from one pre-sized arena
+    // with offsets reused between blobs whose lifetimes never overlap
+    void begin(size_t key);
+
+    // release the arena and all the planned passes immediately
+    void clear();
+
+    // bytes of the arena, 0 if no pass is planned yet
+    size_t arena_size() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    ArenaAllocator(const ArenaAllocator&);
+    ArenaAllocator& operator=(const ArenaAllocator&);
+
+private:
+    ArenaAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
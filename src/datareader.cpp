@@ -5,6 +5,18 @@
 
 #include <string.h>
 
+#if NCNN_STDIO
+#if defined _WIN32
+#include <windows.h>
+#elif defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NCNN_DATAREADER_POSIX_MMAP 1
+#endif
+#endif // NCNN_STDIO
+
 namespace ncnn {
 
 DataReader::DataReader()
@@ -76,6 +88,166 @@ size_t DataReaderFromStdio::read(void* buf, size_t size) const
 }
 #endif // NCNN_STDIO
 
+#if NCNN_STDIO
+class DataReaderFromMmapPrivate
+{
+public:
+    DataReaderFromMmapPrivate()
+        : data(0), size(0), offset(0), mapped(false)
+    {
+#if defined _WIN32
+        mapping = 0;
+#endif
+    }
+
+    const unsigned char* data;
+    size_t size;
+    mutable size_t offset;
+
+    // false if data is a heap copy
+    bool mapped;
+#if defined _WIN32
+    HANDLE mapping;
+#endif
+};
+
+DataReaderFromMmap::DataReaderFromMmap(const char* path)
+    : DataReader(), d(new DataReaderFromMmapPrivate)
+{
+#if defined _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER file_size;
+        if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0)
+        {
+            d->mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+            if (d->mapping)
+            {
+                d->data = (const unsigned char*)MapViewOfFile(d->mapping, FILE_MAP_READ, 0, 0, 0);
+                if (d->data)
+                {
+                    d->size = (size_t)file_size.QuadPart;
+                    d->mapped = true;
+                }
+                else
+                {
+                    CloseHandle(d->mapping);
+                    d->mapping = 0;
+                }
+            }
+        }
+        CloseHandle(file);
+    }
+#elif NCNN_DATAREADER_POSIX_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* ptr = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                d->data = (const unsigned char*)ptr;
+                d->size = (size_t)st.st_size;
+                d->mapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    if (!d->mapped)
+    {
+        // no mmap, read the whole file so that reference still works
+        FILE* fp = fopen(path, "rb");
+        if (fp)
+        {
+            fseek(fp, 0, SEEK_END);
+            long len = ftell(fp);
+            rewind(fp);
+
+            if (len > 0)
+            {
+                unsigned char* buf = new unsigned char[len];
+                if (fread(buf, 1, len, fp) == (size_t)len)
+                {
+                    d->data = buf;
+                    d->size = (size_t)len;
+                }
+                else
+                {
+                    delete[] buf;
+                }
+            }
+
+            fclose(fp);
+        }
+    }
+
+    if (!d->data)
+    {
+        NCNN_LOGE("DataReaderFromMmap open %s failed", path);
+    }
+}
+
+DataReaderFromMmap::~DataReaderFromMmap()
+{
+    if (d->mapped)
+    {
+#if defined _WIN32
+        UnmapViewOfFile(d->data);
+        CloseHandle(d->mapping);
+#elif NCNN_DATAREADER_POSIX_MMAP
+        munmap((void*)d->data, d->size);
+#endif
+    }
+    else
+    {
+        delete[] d->data;
+    }
+
+    delete d;
+}
+
+DataReaderFromMmap::DataReaderFromMmap(const DataReaderFromMmap&)
+    : d(0)
+{
+}
+
+DataReaderFromMmap& DataReaderFromMmap::operator=(const DataReaderFromMmap&)
+{
+    return *this;
+}
+
+bool DataReaderFromMmap::empty() const
+{
+    return d->data == 0;
+}
+
+size_t DataReaderFromMmap::read(void* buf, size_t size) const
+{
+    const size_t remain = d->size - d->offset;
+    if (size > remain)
+        size = remain;
+
+    memcpy(buf, d->data + d->offset, size);
+    d->offset += size;
+    return size;
+}
+
+size_t DataReaderFromMmap::reference(size_t size, const void** buf) const
+{
+    if (size > d->size - d->offset)
+        return 0;
+
+    *buf = d->data + d->offset;
+    d->offset += size;
+    return size;
+}
+#endif // NCNN_STDIO
+
 class DataReaderFromMemoryPrivate
 {
 public:
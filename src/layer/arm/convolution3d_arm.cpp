@@ -0,0 +1,211 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolution3d_arm.h"
+
+#include "cpu.h"
+#include "layer_type.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+#include "convolution_im2col_gemm.h"
+
+Convolution3D_arm::Convolution3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+
+    activation = 0;
+    nT = 0;
+}
+
+static void convolution3d_stack_depth(const Mat& bottom_blob, Mat& bottom_blob_stacked, int z0, int dilation_d, const Option& opt)
+{
+    // gather the kernel_d input depth slices as kz-major channels
+    // so that the 3d convolution at one output depth becomes a 2d convolution
+    const int elempack = bottom_blob.elempack;
+    const int channels = bottom_blob.c;
+    const int inch = channels * elempack;
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int out_elempack = bottom_blob_stacked.elempack;
+
+    if (out_elempack == elempack)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < bottom_blob_stacked.c; q++)
+        {
+            const int kz = q / channels;
+            const float* ptr = bottom_blob.channel(q % channels).depth(z0 + kz * dilation_d);
+            float* outptr = bottom_blob_stacked.channel(q);
+
+            memcpy(outptr, ptr, size * elempack * sizeof(float));
+        }
+
+        return;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < bottom_blob_stacked.c; q++)
+    {
+        float* outptr = bottom_blob_stacked.channel(q);
+
+        for (int k = 0; k < out_elempack; k++)
+        {
+            const int p = q * out_elempack + k;
+            const int kz = p / inch;
+            const int pp = p % inch;
+
+            const float* ptr = (const float*)bottom_blob.channel(pp / elempack).depth(z0 + kz * dilation_d) + pp % elempack;
+
+            for (int i = 0; i < size; i++)
+            {
+                outptr[i * out_elempack + k] = ptr[i * elempack];
+            }
+        }
+    }
+}
+
+int Convolution3D_arm::create_pipeline(const Option& opt)
+{
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    nT = opt.num_threads;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    // kw-kh-kd-inch-outch to kw-kh-inch-kd-outch
+    Mat weight_data_r2(maxk * num_input * num_output);
+    {
+        const int maxk2 = kernel_w * kernel_h;
+
+        for (int q = 0; q < num_output; q++)
+        {
+            const float* kptr = (const float*)weight_data + maxk * num_input * q;
+            float* g00 = (float*)weight_data_r2 + maxk * num_input * q;
+
+            for (int z = 0; z < kernel_d; z++)
+            {
+                for (int p = 0; p < num_input; p++)
+                {
+                    memcpy(g00, kptr + maxk * p + maxk2 * z, maxk2 * sizeof(float));
+                    g00 += maxk2;
+                }
+            }
+        }
+    }
+
+    convolution_im2col_gemm_transform_kernel(weight_data_r2, weight_sgemm_data, num_input * kernel_d, num_output, kernel_w, kernel_h, opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Convolution3D_arm::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    return 0;
+}
+
+int Convolution3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+    const int d = bottom_blob_bordered.d;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+    const int outd = (d - kernel_extent_d) / stride_d + 1;
+
+    const int num_input = channels * elempack;
+    const int num_input_stacked = num_input * kernel_d;
+
+    int out_elempack = 1;
+    int stacked_elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+        stacked_elempack = num_input_stacked % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(outw, outh, outd, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    Mat bottom_blob_stacked;
+    if (kernel_d > 1)
+    {
+        bottom_blob_stacked.create(w, h, num_input_stacked / stacked_elempack, elemsize / elempack * stacked_elempack, stacked_elempack, opt.workspace_allocator);
+        if (bottom_blob_stacked.empty())
+            return -100;
+    }
+
+    // pre-packed A/B follow the load-time tile config
+    // the work is spread across opt.num_threads of this forward call
+    int _nT = nT ? nT : opt.num_threads;
+
+    for (int z = 0; z < outd; z++)
+    {
+        Mat bottom_blob_z;
+        if (kernel_d > 1)
+        {
+            convolution3d_stack_depth(bottom_blob_bordered, bottom_blob_stacked, z * stride_d, dilation_d, opt);
+
+            bottom_blob_z = bottom_blob_stacked;
+        }
+        else
+        {
+            // a single input depth slice is already a strided 2d blob
+            bottom_blob_z = Mat(w, h, channels, (float*)bottom_blob_bordered + (size_t)w * h * elempack * z * stride_d, elemsize, elempack);
+            bottom_blob_z.cstep = bottom_blob_bordered.cstep;
+        }
+
+        Mat top_blob_z(outw, outh, top_blob.c, (float*)top_blob + (size_t)outw * outh * out_elempack * z, out_elemsize, out_elempack);
+        top_blob_z.cstep = top_blob.cstep;
+
+        int ret = convolution_im2col_gemm(bottom_blob_z, top_blob_z, weight_sgemm_data, bias_data, kernel_w, kernel_h, dilation_w, dilation_h, stride_w, stride_h, _nT, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
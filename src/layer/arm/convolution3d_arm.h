@@ -0,0 +1,31 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_CONVOLUTION3D_ARM_H
+#define LAYER_CONVOLUTION3D_ARM_H
+
+#include "convolution3d.h"
+
+namespace ncnn {
+
+class Convolution3D_arm : public Convolution3D
+{
+public:
+    Convolution3D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+public:
+    Layer* activation;
+
+    Mat weight_sgemm_data;
+
+    int nT;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_CONVOLUTION3D_ARM_H
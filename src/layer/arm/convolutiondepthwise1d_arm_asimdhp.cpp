@@ -0,0 +1,165 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise1d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+#if __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+int ConvolutionDepthWise1D_arm::create_pipeline_fp16s(const Option& opt)
+{
+    const int channels = group;
+
+    // fp16 blobs may come in pack8 when fp16 arithmetic is enabled
+    // the weights stay in fp32 and the taps accumulate in fp32
+    int elempack = 1;
+    if (opt.use_packing_layout)
+    {
+        elempack = opt.use_fp16_arithmetic && channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+    }
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(kernel_w, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise1D_arm::forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const __fp16* sptr0 = bottom_blob_bordered.row<const __fp16>(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 8;
+            __fp16* outptr = top_blob.row<__fp16>(g);
+
+            float32x4_t _bias0 = bias_term ? vld1q_f32((const float*)bias_data + g * 8) : vdupq_n_f32(0.f);
+            float32x4_t _bias1 = bias_term ? vld1q_f32((const float*)bias_data + g * 8 + 4) : vdupq_n_f32(0.f);
+
+            for (int j = 0; j < outw; j++)
+            {
+                float32x4_t _sum0 = _bias0;
+                float32x4_t _sum1 = _bias1;
+
+                const __fp16* sptr = sptr0 + j * stride_w * 8;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    float16x8_t _val = vld1q_f16(sptr + k * dilation_w * 8);
+                    float32x4_t _w0 = vld1q_f32(kptr + k * 8);
+                    float32x4_t _w1 = vld1q_f32(kptr + k * 8 + 4);
+                    _sum0 = vfmaq_f32(_sum0, vcvt_f32_f16(vget_low_f16(_val)), _w0);
+                    _sum1 = vfmaq_f32(_sum1, vcvt_f32_f16(vget_high_f16(_val)), _w1);
+                }
+
+                _sum0 = activation_ps(_sum0, activation_type, activation_params);
+                _sum1 = activation_ps(_sum1, activation_type, activation_params);
+
+                vst1q_f16(outptr, vcombine_f16(vcvt_f16_f32(_sum0), vcvt_f16_f32(_sum1)));
+                outptr += 8;
+            }
+        }
+    }
+
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const __fp16* sptr0 = bottom_blob_bordered.row<const __fp16>(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 4;
+            __fp16* outptr = top_blob.row<__fp16>(g);
+
+            float32x4_t _bias = bias_term ? vld1q_f32((const float*)bias_data + g * 4) : vdupq_n_f32(0.f);
+
+            for (int j = 0; j < outw; j++)
+            {
+                float32x4_t _sum = _bias;
+
+                const __fp16* sptr = sptr0 + j * stride_w * 4;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    float32x4_t _val = vcvt_f32_f16(vld1_f16(sptr + k * dilation_w * 4));
+                    float32x4_t _w = vld1q_f32(kptr + k * 4);
+                    _sum = vfmaq_f32(_sum, _val, _w);
+                }
+
+                _sum = activation_ps(_sum, activation_type, activation_params);
+
+                vst1_f16(outptr, vcvt_f16_f32(_sum));
+                outptr += 4;
+            }
+        }
+    }
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const __fp16* sptr0 = bottom_blob_bordered.row<const __fp16>(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g;
+            __fp16* outptr = top_blob.row<__fp16>(g);
+
+            const float bias = bias_term ? bias_data[g] : 0.f;
+
+            for (int j = 0; j < outw; j++)
+            {
+                float sum = bias;
+
+                const __fp16* sptr = sptr0 + j * stride_w;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    sum += (float)sptr[k * dilation_w] * kptr[k];
+                }
+
+                outptr[j] = (__fp16)activation_ss(sum, activation_type, activation_params);
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+
+} // namespace ncnn
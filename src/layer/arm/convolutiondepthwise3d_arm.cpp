@@ -0,0 +1,209 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise3d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+ConvolutionDepthWise3D_arm::ConvolutionDepthWise3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int ConvolutionDepthWise3D_arm::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group convolution runs the reference implementation on unpacked blobs
+    if (channels != group || group != num_output)
+        return 0;
+
+    int elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = channels % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (channels * elempack != group || group != num_output)
+    {
+        // group convolution
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_p = opt;
+            opt_p.blob_allocator = opt.workspace_allocator;
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_p);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return ConvolutionDepthWise3D::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+    const int outd = (bottom_blob_bordered.d - kernel_extent_d) / stride_d + 1;
+
+    top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = w * dilation_h - kernel_w * dilation_w;
+        int gap1 = h * w * dilation_d - w * kernel_h * dilation_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += dilation_w;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            float* outptr = top_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 4;
+            const Mat m = bottom_blob_bordered.channel(g);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        float32x4_t _sum = vdupq_n_f32(0.f);
+
+                        if (bias_term)
+                        {
+                            _sum = vld1q_f32((const float*)bias_data + g * 4);
+                        }
+
+                        const float* sptr = sptr0 + j * stride_w * 4;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            float32x4_t _val = vld1q_f32(sptr + space_ofs[k] * 4);
+                            float32x4_t _w = vld1q_f32(kptr + k * 4);
+                            _sum = vmlaq_f32(_sum, _val, _w);
+                        }
+
+                        _sum = activation_ps(_sum, activation_type, activation_params);
+
+                        vst1q_f32(outptr, _sum);
+                        outptr += 4;
+                    }
+                }
+            }
+        }
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            float* outptr = top_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g;
+            const Mat m = bottom_blob_bordered.channel(g);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        float sum = 0.f;
+
+                        if (bias_term)
+                            sum = bias_data[g];
+
+                        const float* sptr = sptr0 + j * stride_w;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            sum += sptr[space_ofs[k]] * kptr[k];
+                        }
+
+                        outptr[j] = activation_ss(sum, activation_type, activation_params);
+                    }
+
+                    outptr += outw;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
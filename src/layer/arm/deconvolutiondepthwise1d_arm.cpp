@@ -0,0 +1,303 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolutiondepthwise1d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+DeconvolutionDepthWise1D_arm::DeconvolutionDepthWise1D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int DeconvolutionDepthWise1D_arm::create_pipeline(const Option& opt)
+{
+    int channels = (weight_data_size / group) / kernel_w / (num_output / group) * group;
+
+    if (dynamic_weight || channels != group || group != num_output)
+    {
+        // dynamic weight and group deconvolution run the reference implementation on unpacked fp32 blobs
+        support_packing = false;
+        support_fp16_storage = false;
+        support_bf16_storage = false;
+        return 0;
+    }
+
+#if NCNN_ARM82
+    if (support_fp16_storage && opt.use_fp16_storage)
+    {
+        return create_pipeline_fp16s(opt);
+    }
+#endif
+
+    int elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = channels % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(kernel_w, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise1D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (weight_data_tm.empty())
+    {
+        // group deconvolution
+        return DeconvolutionDepthWise1D::forward(bottom_blob, top_blob, opt);
+    }
+
+    int elembits = bottom_blob.elembits();
+
+#if NCNN_ARM82
+    if (support_fp16_storage && opt.use_fp16_storage && elembits == 16)
+        return forward_fp16s(bottom_blob, top_blob, opt);
+#endif
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage && elembits == 16)
+        return forward_bf16s(bottom_blob, top_blob, opt);
+#endif
+
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || output_w > 0)
+    {
+        top_blob_bordered.create(outw, h, elemsize, elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const float* sptr = bottom_blob.row(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 4;
+            float* outptr = top_blob_bordered.row(g);
+
+            float32x4_t _bias = bias_term ? vld1q_f32((const float*)bias_data + g * 4) : vdupq_n_f32(0.f);
+
+            for (int j = 0; j < outw; j++)
+            {
+                float32x4_t _sum = _bias;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    int sxs = j - k * dilation_w;
+                    if (sxs < 0)
+                        break;
+
+                    int sx = sxs / stride_w;
+                    if (sx * stride_w != sxs || sx >= w)
+                        continue;
+
+                    float32x4_t _val = vld1q_f32(sptr + sx * 4);
+                    float32x4_t _w = vld1q_f32(kptr + k * 4);
+                    _sum = vmlaq_f32(_sum, _val, _w);
+                }
+
+                _sum = activation_ps(_sum, activation_type, activation_params);
+
+                vst1q_f32(outptr, _sum);
+                outptr += 4;
+            }
+        }
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const float* sptr = bottom_blob.row(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g;
+            float* outptr = top_blob_bordered.row(g);
+
+            const float bias = bias_term ? bias_data[g] : 0.f;
+
+            for (int j = 0; j < outw; j++)
+            {
+                float sum = bias;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    int sxs = j - k * dilation_w;
+                    if (sxs < 0)
+                        break;
+
+                    int sx = sxs / stride_w;
+                    if (sx * stride_w != sxs || sx >= w)
+                        continue;
+
+                    sum += sptr[sx] * kptr[k];
+                }
+
+                outptr[j] = activation_ss(sum, activation_type, activation_params);
+            }
+        }
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+#if NCNN_BF16
+int DeconvolutionDepthWise1D_arm::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || output_w > 0)
+    {
+        top_blob_bordered.create(outw, h, elemsize, elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const unsigned short* sptr = bottom_blob.row<const unsigned short>(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 4;
+            unsigned short* outptr = top_blob_bordered.row<unsigned short>(g);
+
+            float32x4_t _bias = bias_term ? vld1q_f32((const float*)bias_data + g * 4) : vdupq_n_f32(0.f);
+
+            for (int j = 0; j < outw; j++)
+            {
+                float32x4_t _sum = _bias;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    int sxs = j - k * dilation_w;
+                    if (sxs < 0)
+                        break;
+
+                    int sx = sxs / stride_w;
+                    if (sx * stride_w != sxs || sx >= w)
+                        continue;
+
+                    float32x4_t _val = bfloat2float(vld1_u16(sptr + sx * 4));
+                    float32x4_t _w = vld1q_f32(kptr + k * 4);
+                    _sum = vmlaq_f32(_sum, _val, _w);
+                }
+
+                _sum = activation_ps(_sum, activation_type, activation_params);
+
+                vst1_u16(outptr, float2bfloat(_sum));
+                outptr += 4;
+            }
+        }
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const unsigned short* sptr = bottom_blob.row<const unsigned short>(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g;
+            unsigned short* outptr = top_blob_bordered.row<unsigned short>(g);
+
+            const float bias = bias_term ? bias_data[g] : 0.f;
+
+            for (int j = 0; j < outw; j++)
+            {
+                float sum = bias;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    int sxs = j - k * dilation_w;
+                    if (sxs < 0)
+                        break;
+
+                    int sx = sxs / stride_w;
+                    if (sx * stride_w != sxs || sx >= w)
+                        continue;
+
+                    sum += bfloat16_to_float32(sptr[sx]) * kptr[k];
+                }
+
+                outptr[j] = float32_to_bfloat16(activation_ss(sum, activation_type, activation_params));
+            }
+        }
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+#endif // NCNN_BF16
+
+} // namespace ncnn
@@ -0,0 +1,35 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_DECONVOLUTIONDEPTHWISE1D_ARM_H
+#define LAYER_DECONVOLUTIONDEPTHWISE1D_ARM_H
+
+#include "deconvolutiondepthwise1d.h"
+
+namespace ncnn {
+
+class DeconvolutionDepthWise1D_arm : public DeconvolutionDepthWise1D
+{
+public:
+    DeconvolutionDepthWise1D_arm();
+
+    virtual int create_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+protected:
+#if NCNN_ARM82
+    int create_pipeline_fp16s(const Option& opt);
+    int forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
+#if NCNN_BF16
+    int forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
+
+public:
+    Mat weight_data_tm;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_DECONVOLUTIONDEPTHWISE1D_ARM_H
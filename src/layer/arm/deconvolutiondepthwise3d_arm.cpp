@@ -0,0 +1,243 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolutiondepthwise3d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_activation.h"
+#include "arm_usability.h"
+
+namespace ncnn {
+
+DeconvolutionDepthWise3D_arm::DeconvolutionDepthWise3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int DeconvolutionDepthWise3D_arm::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group deconvolution runs the reference implementation on unpacked blobs
+    if (channels != group || group != num_output)
+        return 0;
+
+    int elempack = 1;
+#if __ARM_NEON
+    if (opt.use_packing_layout)
+    {
+        elempack = channels % 4 == 0 ? 4 : 1;
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (channels * elempack != group || group != num_output)
+    {
+        // group deconvolution
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_p = opt;
+            opt_p.blob_allocator = opt.workspace_allocator;
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_p);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return DeconvolutionDepthWise3D::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    const int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    const int outd = (d - 1) * stride_d + kernel_extent_d + output_pad_behind;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0 || (output_w > 0 && output_h > 0 && output_d > 0))
+    {
+        top_blob_bordered.create(outw, outh, outd, channels, elemsize, elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = outw * dilation_h - kernel_w * dilation_w;
+        int gap1 = outh * outw * dilation_d - outw * kernel_h * dilation_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += dilation_w;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+#if __ARM_NEON
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            const float* inptr = bottom_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 4;
+            Mat out = top_blob_bordered.channel(g);
+
+            if (bias_term)
+            {
+                out.fill(vld1q_f32((const float*)bias_data + g * 4));
+            }
+            else
+            {
+                out.fill(vdupq_n_f32(0.f));
+            }
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr0 = out.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr = outptr0 + j * stride_w * 4;
+
+                        float32x4_t _val = vld1q_f32(inptr);
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            float* ptr = outptr + space_ofs[k] * 4;
+                            float32x4_t _w = vld1q_f32(kptr + k * 4);
+                            float32x4_t _sum = vld1q_f32(ptr);
+                            _sum = vmlaq_f32(_sum, _val, _w);
+                            vst1q_f32(ptr, _sum);
+                        }
+
+                        inptr += 4;
+                    }
+                }
+            }
+
+            if (activation_type)
+            {
+                float* outptr = out;
+                const int size = outw * outh * outd;
+
+                for (int i = 0; i < size; i++)
+                {
+                    float32x4_t _sum = vld1q_f32(outptr);
+                    _sum = activation_ps(_sum, activation_type, activation_params);
+                    vst1q_f32(outptr, _sum);
+                    outptr += 4;
+                }
+            }
+        }
+    }
+#endif // __ARM_NEON
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            const float* inptr = bottom_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g;
+            Mat out = top_blob_bordered.channel(g);
+
+            out.fill(bias_term ? bias_data[g] : 0.f);
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr0 = out.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr = outptr0 + j * stride_w;
+
+                        const float val = inptr[0];
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            outptr[space_ofs[k]] += val * kptr[k];
+                        }
+
+                        inptr += 1;
+                    }
+                }
+            }
+
+            if (activation_type)
+            {
+                float* outptr = out;
+                const int size = outw * outh * outd;
+
+                for (int i = 0; i < size; i++)
+                {
+                    outptr[i] = activation_ss(outptr[i], activation_type, activation_params);
+                }
+            }
+        }
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
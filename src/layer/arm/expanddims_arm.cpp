@@ -0,0 +1,88 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "expanddims_arm.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+ExpandDims_arm::ExpandDims_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int ExpandDims_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+
+    bool _expand_w = false;
+    bool _expand_h = false;
+    bool _expand_d = false;
+    bool _expand_c = false;
+
+    if (axes.empty())
+    {
+        _expand_w = expand_w;
+        _expand_h = expand_h;
+        _expand_d = expand_d;
+        _expand_c = expand_c;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        for (int i = 0; i < axes.w; i++)
+        {
+            int axis = axes_ptr[i];
+            if (axis < 0)
+                axis = dims + 1 + axis;
+
+            if (dims == 1 && axis == 0) _expand_h = true;
+            if (dims == 1 && axis == 1) _expand_w = true;
+            if (dims == 2 && axis == 0) _expand_c = true;
+            if (dims == 2 && axis == 1) _expand_h = true;
+            if (dims == 2 && axis == 2) _expand_w = true;
+            if (dims == 3 && axis == 0) _expand_c = true;
+            if (dims == 3 && axis == 1) _expand_d = true;
+            if (dims == 3 && axis == 2) _expand_h = true;
+            if (dims == 3 && axis == 3) _expand_w = true;
+        }
+    }
+
+    // a new outermost axis would take over the packing
+    // the reference picks the first of w h d c to expand for 2d and 3d blobs
+    bool new_outer_axis = false;
+    if (dims == 1)
+        new_outer_axis = _expand_h;
+    if (dims == 2)
+        new_outer_axis = !_expand_w && !_expand_h && _expand_c;
+    if (dims == 3)
+        new_outer_axis = !_expand_w && !_expand_h && !_expand_d && _expand_c;
+
+    if (bottom_blob.elempack == 1 || !new_outer_axis)
+    {
+        // reshape in pack units, zero copy
+        return ExpandDims::forward(bottom_blob, top_blob, opt);
+    }
+
+    Option opt_pack = opt;
+    opt_pack.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_unpacked;
+    convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+    if (bottom_blob_unpacked.empty())
+        return -100;
+
+    return ExpandDims::forward(bottom_blob_unpacked, top_blob, opt);
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_EXPANDDIMS_ARM_H
+#define LAYER_EXPANDDIMS_ARM_H
+
+#include "expanddims.h"
+
+namespace ncnn {
+
+class ExpandDims_arm : public ExpandDims
+{
+public:
+    ExpandDims_arm();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_EXPANDDIMS_ARM_H
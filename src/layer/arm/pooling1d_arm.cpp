@@ -0,0 +1,396 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling1d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+Pooling1D_arm::Pooling1D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Pooling1D_arm::create_pipeline(const Option& /*opt*/)
+{
+    if (adaptive_pooling)
+    {
+        support_packing = false;
+
+        support_bf16_storage = false;
+        support_fp16_storage = false;
+        support_int8_storage = false;
+        support_tensor_storage = false;
+    }
+    return 0;
+}
+
+int Pooling1D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // max value in N window
+    // avg value in N window
+
+    if (adaptive_pooling)
+    {
+        return Pooling1D::forward(bottom_blob, top_blob, opt);
+    }
+
+    int elembits = bottom_blob.elembits();
+
+#if NCNN_ARM82
+    if (support_fp16_storage && opt.use_fp16_storage && elembits == 16)
+        return forward_fp16s(bottom_blob, top_blob, opt);
+#endif
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage && elembits == 16)
+        return forward_bf16s(bottom_blob, top_blob, opt);
+#endif
+
+    int elempack = bottom_blob.elempack;
+
+    if (elempack == 1)
+    {
+        return Pooling1D::forward(bottom_blob, top_blob, opt);
+    }
+
+#if __ARM_NEON
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        top_blob.create(h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        if (elempack == 4)
+        {
+            if (pooling_type == PoolMethod_MAX)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    float32x4_t _max = vld1q_f32(ptr);
+                    for (int i = 0; i < w; i++)
+                    {
+                        float32x4_t _val = vld1q_f32(ptr);
+                        _max = vmaxq_f32(_max, _val);
+                        ptr += 4;
+                    }
+
+                    float* outptr = top_blob;
+                    vst1q_f32(outptr + q * 4, _max);
+                }
+            }
+            else if (pooling_type == PoolMethod_AVE)
+            {
+                float32x4_t _inv_w = vdupq_n_f32(1.f / w);
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    float32x4_t _sum = vdupq_n_f32(0.f);
+                    for (int i = 0; i < w; i++)
+                    {
+                        float32x4_t _val = vld1q_f32(ptr);
+                        _sum = vaddq_f32(_sum, _val);
+                        ptr += 4;
+                    }
+
+                    float32x4_t _avg = vmulq_f32(_sum, _inv_w);
+
+                    float* outptr = top_blob;
+                    vst1q_f32(outptr + q * 4, _avg);
+                }
+            }
+
+            return 0;
+        }
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+
+    int outw = (w - kernel_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int wtailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+    }
+
+    if (elempack == 4)
+    {
+        if (pooling_type == PoolMethod_MAX)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 4;
+
+                    float32x4_t _max = vld1q_f32(sptr);
+                    for (int k = 1; k < kernel_w; k++)
+                    {
+                        float32x4_t _val = vld1q_f32(sptr + k * 4);
+                        _max = vmaxq_f32(_max, _val);
+                    }
+
+                    vst1q_f32(outptr + j * 4, _max);
+                }
+            }
+        }
+        else if (avgpool_count_include_pad == 0)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    int sx0 = j * stride_w;
+
+                    float32x4_t _sum = vdupq_n_f32(0.f);
+                    int area = 0;
+
+                    for (int kj = 0; kj < kernel_w; kj++)
+                    {
+                        int sx = sx0 + kj;
+
+                        if (sx < pad_left)
+                            continue;
+
+                        if (sx >= w - pad_right - wtailpad)
+                            break;
+
+                        float32x4_t _val = vld1q_f32(ptr + sx * 4);
+                        _sum = vaddq_f32(_sum, _val);
+                        area += 1;
+                    }
+
+                    float32x4_t _inv_area = vdupq_n_f32(1.f / area);
+                    float32x4_t _avg = vmulq_f32(_sum, _inv_area);
+                    vst1q_f32(outptr + j * 4, _avg);
+                }
+            }
+        }
+        else // if (avgpool_count_include_pad == 1)
+        {
+            float32x4_t _inv_maxk = vdupq_n_f32(1.f / kernel_w);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 4;
+
+                    float32x4_t _sum = vdupq_n_f32(0.f);
+                    for (int k = 0; k < kernel_w; k++)
+                    {
+                        float32x4_t _val = vld1q_f32(sptr + k * 4);
+                        _sum = vaddq_f32(_sum, _val);
+                    }
+
+                    float32x4_t _avg = vmulq_f32(_sum, _inv_maxk);
+                    vst1q_f32(outptr + j * 4, _avg);
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __ARM_NEON
+
+    return 0;
+}
+
+#if NCNN_BF16
+int Pooling1D_arm::forward_bf16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (global_pooling)
+    {
+        top_blob.create(h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < h; q++)
+        {
+            const unsigned short* ptr0 = bottom_blob.row<const unsigned short>(q);
+            unsigned short* outptr = (unsigned short*)top_blob + q * elempack;
+
+            int l = 0;
+#if __ARM_NEON
+            for (; l + 3 < elempack; l += 4)
+            {
+                const unsigned short* ptr = ptr0 + l;
+
+                float32x4_t _max = bfloat2float(vld1_u16(ptr));
+                float32x4_t _sum = vdupq_n_f32(0.f);
+                for (int i = 0; i < w; i++)
+                {
+                    float32x4_t _val = bfloat2float(vld1_u16(ptr));
+                    _max = vmaxq_f32(_max, _val);
+                    _sum = vaddq_f32(_sum, _val);
+                    ptr += elempack;
+                }
+
+                float32x4_t _out = pooling_type == PoolMethod_MAX ? _max : vmulq_f32(_sum, vdupq_n_f32(1.f / w));
+                vst1_u16(outptr + l, float2bfloat(_out));
+            }
+#endif // __ARM_NEON
+            for (; l < elempack; l++)
+            {
+                const unsigned short* ptr = ptr0 + l;
+
+                float max = bfloat16_to_float32(ptr[0]);
+                float sum = 0.f;
+                for (int i = 0; i < w; i++)
+                {
+                    float val = bfloat16_to_float32(ptr[0]);
+                    max = std::max(max, val);
+                    sum += val;
+                    ptr += elempack;
+                }
+
+                outptr[l] = float32_to_bfloat16(pooling_type == PoolMethod_MAX ? max : sum / w);
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+
+    int outw = (w - kernel_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int wtailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+    }
+
+    // the taps of one output cover [sx0, sx1) of the bordered row
+    // average pooling without counting pad skips the padded taps
+    const int count_pad = pooling_type == PoolMethod_MAX || avgpool_count_include_pad;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < h; q++)
+    {
+        const unsigned short* ptr0 = bottom_blob_bordered.row<const unsigned short>(q);
+        unsigned short* outptr0 = top_blob.row<unsigned short>(q);
+
+        for (int j = 0; j < outw; j++)
+        {
+            int sx0 = j * stride_w;
+            int sx1 = sx0 + kernel_w;
+            if (!count_pad)
+            {
+                sx0 = std::max(sx0, pad_left);
+                sx1 = std::min(sx1, w - pad_right - wtailpad);
+            }
+
+            const float inv_area = 1.f / (count_pad ? kernel_w : sx1 - sx0);
+
+            unsigned short* outptr = outptr0 + j * elempack;
+
+            int l = 0;
+#if __ARM_NEON
+            for (; l + 3 < elempack; l += 4)
+            {
+                const unsigned short* sptr = ptr0 + sx0 * elempack + l;
+
+                float32x4_t _max = bfloat2float(vld1_u16(sptr));
+                float32x4_t _sum = vdupq_n_f32(0.f);
+                for (int sx = sx0; sx < sx1; sx++)
+                {
+                    float32x4_t _val = bfloat2float(vld1_u16(sptr));
+                    _max = vmaxq_f32(_max, _val);
+                    _sum = vaddq_f32(_sum, _val);
+                    sptr += elempack;
+                }
+
+                float32x4_t _out = pooling_type == PoolMethod_MAX ? _max : vmulq_f32(_sum, vdupq_n_f32(inv_area));
+                vst1_u16(outptr + l, float2bfloat(_out));
+            }
+#endif // __ARM_NEON
+            for (; l < elempack; l++)
+            {
+                const unsigned short* sptr = ptr0 + sx0 * elempack + l;
+
+                float max = bfloat16_to_float32(sptr[0]);
+                float sum = 0.f;
+                for (int sx = sx0; sx < sx1; sx++)
+                {
+                    float val = bfloat16_to_float32(sptr[0]);
+                    max = std::max(max, val);
+                    sum += val;
+                    sptr += elempack;
+                }
+
+                outptr[l] = float32_to_bfloat16(pooling_type == PoolMethod_MAX ? max : sum * inv_area);
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_BF16
+
+} // namespace ncnn
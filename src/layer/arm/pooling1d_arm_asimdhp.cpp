@@ -0,0 +1,161 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling1d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+#if __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+int Pooling1D_arm::forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    // elempack 8 from fp16 arithmetic runs as two interleaved 4-lane halves
+    if (global_pooling)
+    {
+        top_blob.create(h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < h; q++)
+        {
+            const __fp16* ptr0 = bottom_blob.row<const __fp16>(q);
+            __fp16* outptr = (__fp16*)top_blob + q * elempack;
+
+            int l = 0;
+#if __ARM_NEON
+            for (; l + 3 < elempack; l += 4)
+            {
+                const __fp16* ptr = ptr0 + l;
+
+                float32x4_t _max = vcvt_f32_f16(vld1_f16(ptr));
+                float32x4_t _sum = vdupq_n_f32(0.f);
+                for (int i = 0; i < w; i++)
+                {
+                    float32x4_t _val = vcvt_f32_f16(vld1_f16(ptr));
+                    _max = vmaxq_f32(_max, _val);
+                    _sum = vaddq_f32(_sum, _val);
+                    ptr += elempack;
+                }
+
+                float32x4_t _out = pooling_type == PoolMethod_MAX ? _max : vmulq_f32(_sum, vdupq_n_f32(1.f / w));
+                vst1_f16(outptr + l, vcvt_f16_f32(_out));
+            }
+#endif // __ARM_NEON
+            for (; l < elempack; l++)
+            {
+                const __fp16* ptr = ptr0 + l;
+
+                float max = (float)ptr[0];
+                float sum = 0.f;
+                for (int i = 0; i < w; i++)
+                {
+                    float val = (float)ptr[0];
+                    max = std::max(max, val);
+                    sum += val;
+                    ptr += elempack;
+                }
+
+                outptr[l] = (__fp16)(pooling_type == PoolMethod_MAX ? max : sum / w);
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+
+    int outw = (w - kernel_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int wtailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+    }
+
+    // the taps of one output cover [sx0, sx1) of the bordered row
+    // average pooling without counting pad skips the padded taps
+    const int count_pad = pooling_type == PoolMethod_MAX || avgpool_count_include_pad;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < h; q++)
+    {
+        const __fp16* ptr0 = bottom_blob_bordered.row<const __fp16>(q);
+        __fp16* outptr0 = top_blob.row<__fp16>(q);
+
+        for (int j = 0; j < outw; j++)
+        {
+            int sx0 = j * stride_w;
+            int sx1 = sx0 + kernel_w;
+            if (!count_pad)
+            {
+                sx0 = std::max(sx0, pad_left);
+                sx1 = std::min(sx1, w - pad_right - wtailpad);
+            }
+
+            const float inv_area = 1.f / (count_pad ? kernel_w : sx1 - sx0);
+
+            __fp16* outptr = outptr0 + j * elempack;
+
+            int l = 0;
+#if __ARM_NEON
+            for (; l + 3 < elempack; l += 4)
+            {
+                const __fp16* sptr = ptr0 + sx0 * elempack + l;
+
+                float32x4_t _max = vcvt_f32_f16(vld1_f16(sptr));
+                float32x4_t _sum = vdupq_n_f32(0.f);
+                for (int sx = sx0; sx < sx1; sx++)
+                {
+                    float32x4_t _val = vcvt_f32_f16(vld1_f16(sptr));
+                    _max = vmaxq_f32(_max, _val);
+                    _sum = vaddq_f32(_sum, _val);
+                    sptr += elempack;
+                }
+
+                float32x4_t _out = pooling_type == PoolMethod_MAX ? _max : vmulq_f32(_sum, vdupq_n_f32(inv_area));
+                vst1_f16(outptr + l, vcvt_f16_f32(_out));
+            }
+#endif // __ARM_NEON
+            for (; l < elempack; l++)
+            {
+                const __fp16* sptr = ptr0 + sx0 * elempack + l;
+
+                float max = (float)sptr[0];
+                float sum = 0.f;
+                for (int sx = sx0; sx < sx1; sx++)
+                {
+                    float val = (float)sptr[0];
+                    max = std::max(max, val);
+                    sum += val;
+                    sptr += elempack;
+                }
+
+                outptr[l] = (__fp16)(pooling_type == PoolMethod_MAX ? max : sum * inv_area);
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // __ARM_FEATURE_FP16_VECTOR_ARITHMETIC
+
+} // namespace ncnn
@@ -0,0 +1,311 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling3d_arm.h"
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#endif // __ARM_NEON
+
+namespace ncnn {
+
+Pooling3D_arm::Pooling3D_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#endif // __ARM_NEON
+}
+
+int Pooling3D_arm::create_pipeline(const Option& /*opt*/)
+{
+    if (adaptive_pooling)
+    {
+        support_packing = false;
+
+        support_bf16_storage = false;
+        support_fp16_storage = false;
+        support_int8_storage = false;
+        support_tensor_storage = false;
+    }
+    return 0;
+}
+
+int Pooling3D_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // max value in NxNxN window
+    // avg value in NxNxN window
+
+    if (adaptive_pooling)
+    {
+        return Pooling3D::forward(bottom_blob, top_blob, opt);
+    }
+
+#if __ARM_NEON
+    int elempack = bottom_blob.elempack;
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    int d = bottom_blob.d;
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+
+    if (elempack == 4)
+    {
+        if (global_pooling)
+        {
+            top_blob.create(channels, elemsize, elempack, opt.blob_allocator);
+            if (top_blob.empty())
+                return -100;
+
+            int size = w * h * d;
+
+            if (pooling_type == PoolMethod_MAX)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const float* ptr = bottom_blob.channel(q);
+
+                    float32x4_t _max = vld1q_f32(ptr);
+                    for (int i = 0; i < size; i++)
+                    {
+                        float32x4_t _val = vld1q_f32(ptr);
+                        _max = vmaxq_f32(_max, _val);
+                        ptr += 4;
+                    }
+
+                    float* outptr = top_blob;
+                    vst1q_f32(outptr + q * 4, _max);
+                }
+            }
+            else if (pooling_type == PoolMethod_AVE)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const float* ptr = bottom_blob.channel(q);
+
+                    float32x4_t _sum = vdupq_n_f32(0.f);
+                    for (int i = 0; i < size; i++)
+                    {
+                        float32x4_t _val = vld1q_f32(ptr);
+                        _sum = vaddq_f32(_sum, _val);
+                        ptr += 4;
+                    }
+
+                    float32x4_t _inv_size = vdupq_n_f32(1.f / size);
+                    float32x4_t _avg = vmulq_f32(_sum, _inv_size);
+
+                    float* outptr = top_blob;
+                    vst1q_f32(outptr + q * 4, _avg);
+                }
+            }
+
+            return 0;
+        }
+
+        Mat bottom_blob_bordered;
+        make_padding(bottom_blob, bottom_blob_bordered, opt);
+        if (bottom_blob_bordered.empty())
+            return -100;
+
+        w = bottom_blob_bordered.w;
+        h = bottom_blob_bordered.h;
+        d = bottom_blob_bordered.d;
+
+        int outw = (w - kernel_w) / stride_w + 1;
+        int outh = (h - kernel_h) / stride_h + 1;
+        int outd = (d - kernel_d) / stride_d + 1;
+
+        top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        const int maxk = kernel_w * kernel_h * kernel_d;
+
+        // kernel offsets
+        std::vector<int> _space_ofs(maxk);
+        int* space_ofs = &_space_ofs[0];
+        {
+            int p1 = 0;
+            int p2 = 0;
+            int gap0 = w - kernel_w;
+            int gap1 = h * w - w * kernel_h;
+            for (int z = 0; z < kernel_d; z++)
+            {
+                for (int i = 0; i < kernel_h; i++)
+                {
+                    for (int j = 0; j < kernel_w; j++)
+                    {
+                        space_ofs[p1] = p2;
+                        p1++;
+                        p2++;
+                    }
+                    p2 += gap0;
+                }
+                p2 += gap1;
+            }
+        }
+
+        if (pooling_type == PoolMethod_MAX)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < channels; q++)
+            {
+                const Mat m = bottom_blob_bordered.channel(q);
+                float* outptr = top_blob.channel(q);
+
+                for (int z = 0; z < outd; z++)
+                {
+                    for (int i = 0; i < outh; i++)
+                    {
+                        const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                        for (int j = 0; j < outw; j++)
+                        {
+                            const float* sptr = sptr0 + j * stride_w * 4;
+
+                            float32x4_t _max = vld1q_f32(sptr);
+
+                            for (int k = 0; k < maxk; k++)
+                            {
+                                float32x4_t _val = vld1q_f32(sptr + space_ofs[k] * 4);
+                                _max = vmaxq_f32(_max, _val);
+                            }
+
+                            vst1q_f32(outptr, _max);
+                            outptr += 4;
+                        }
+                    }
+                }
+            }
+        }
+        else if (pooling_type == PoolMethod_AVE)
+        {
+            if (avgpool_count_include_pad == 0)
+            {
+                int wtailpad = 0;
+                int htailpad = 0;
+                int dtailpad = 0;
+
+                if (pad_mode == 0) // full padding
+                {
+                    wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+                    htailpad = bottom_blob_bordered.h - bottom_blob.h - pad_top - pad_bottom;
+                    dtailpad = bottom_blob_bordered.d - bottom_blob.d - pad_front - pad_behind;
+                }
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const Mat m = bottom_blob_bordered.channel(q);
+                    float* outptr = top_blob.channel(q);
+
+                    for (int z = 0; z < outd; z++)
+                    {
+                        int sz0 = z * stride_d;
+
+                        for (int i = 0; i < outh; i++)
+                        {
+                            int sy0 = i * stride_h;
+
+                            for (int j = 0; j < outw; j++)
+                            {
+                                int sx0 = j * stride_w;
+
+                                float32x4_t _sum = vdupq_n_f32(0.f);
+                                int area = 0;
+
+                                for (int kd = 0; kd < kernel_d; kd++)
+                                {
+                                    int sz = sz0 + kd;
+
+                                    if (sz < pad_front)
+                                        continue;
+
+                                    if (sz >= d - pad_behind - dtailpad)
+                                        break;
+
+                                    for (int ki = 0; ki < kernel_h; ki++)
+                                    {
+                                        int sy = sy0 + ki;
+
+                                        if (sy < pad_top)
+                                            continue;
+
+                                        if (sy >= h - pad_bottom - htailpad)
+                                            break;
+
+                                        const float* sptr = m.depth(sz).row(sy);
+
+                                        for (int kj = 0; kj < kernel_w; kj++)
+                                        {
+                                            int sx = sx0 + kj;
+
+                                            if (sx < pad_left)
+                                                continue;
+
+                                            if (sx >= w - pad_right - wtailpad)
+                                                break;
+
+                                            float32x4_t _val = vld1q_f32(sptr + sx * 4);
+                                            _sum = vaddq_f32(_sum, _val);
+                                            area += 1;
+                                        }
+                                    }
+                                }
+
+                                float32x4_t _inv_area = vdupq_n_f32(1.f / area);
+                                float32x4_t _avg = vmulq_f32(_sum, _inv_area);
+                                vst1q_f32(outptr, _avg);
+                                outptr += 4;
+                            }
+                        }
+                    }
+                }
+            }
+            else // if (avgpool_count_include_pad == 1)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < channels; q++)
+                {
+                    const Mat m = bottom_blob_bordered.channel(q);
+                    float* outptr = top_blob.channel(q);
+
+                    float32x4_t _inv_maxk = vdupq_n_f32(1.f / maxk);
+
+                    for (int z = 0; z < outd; z++)
+                    {
+                        for (int i = 0; i < outh; i++)
+                        {
+                            const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                            for (int j = 0; j < outw; j++)
+                            {
+                                const float* sptr = sptr0 + j * stride_w * 4;
+
+                                float32x4_t _sum = vdupq_n_f32(0.f);
+
+                                for (int k = 0; k < maxk; k++)
+                                {
+                                    float32x4_t _val = vld1q_f32(sptr + space_ofs[k] * 4);
+                                    _sum = vaddq_f32(_sum, _val);
+                                }
+
+                                float32x4_t _avg = vmulq_f32(_sum, _inv_maxk);
+                                vst1q_f32(outptr, _avg);
+                                outptr += 4;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __ARM_NEON
+
+    return Pooling3D::forward(bottom_blob, top_blob, opt);
+}
+
+} // namespace ncnn
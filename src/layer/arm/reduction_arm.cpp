@@ -0,0 +1,669 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "reduction_arm.h"
+
+#include <float.h>
+
+#if __ARM_NEON
+#include <arm_neon.h>
+#include "neon_mathfun.h"
+#endif // __ARM_NEON
+
+#include "arm_usability.h"
+#include "cpu.h"
+
+namespace ncnn {
+
+Reduction_arm::Reduction_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+struct reduction_op_add
+{
+    float func(const float& x, const float& y) const
+    {
+        return x + y;
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vaddq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_mul
+{
+    float func(const float& x, const float& y) const
+    {
+        return x * y;
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vmulq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_asum
+{
+    float func(const float& x, const float& y) const
+    {
+        return x + fabsf(y);
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vaddq_f32(x, vabsq_f32(y));
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_sumsq
+{
+    float func(const float& x, const float& y) const
+    {
+        return x + y * y;
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vmlaq_f32(x, y, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_sumexp
+{
+    float func(const float& x, const float& y) const
+    {
+        return x + expf(y);
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vaddq_f32(x, exp_ps(y));
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_max
+{
+    float func(const float& x, const float& y) const
+    {
+        return std::max(x, y);
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vmaxq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+struct reduction_op_min
+{
+    float func(const float& x, const float& y) const
+    {
+        return std::min(x, y);
+    }
+#if __ARM_NEON
+    float32x4_t func_pack4(const float32x4_t& x, const float32x4_t& y) const
+    {
+        return vminq_f32(x, y);
+    }
+#endif // __ARM_NEON
+};
+
+// outptr[i] = op(outptr[i], ptr[i])
+template<typename Op>
+static void reduction_elementwise(float* outptr, const float* ptr, int size)
+{
+    Op op;
+
+    int i = 0;
+#if __ARM_NEON
+    for (; i + 7 < size; i += 8)
+    {
+        float32x4_t _out0 = vld1q_f32(outptr);
+        float32x4_t _out1 = vld1q_f32(outptr + 4);
+        float32x4_t _p0 = vld1q_f32(ptr);
+        float32x4_t _p1 = vld1q_f32(ptr + 4);
+        vst1q_f32(outptr, op.func_pack4(_out0, _p0));
+        vst1q_f32(outptr + 4, op.func_pack4(_out1, _p1));
+        outptr += 8;
+        ptr += 8;
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        float32x4_t _out = vld1q_f32(outptr);
+        float32x4_t _p = vld1q_f32(ptr);
+        vst1q_f32(outptr, op.func_pack4(_out, _p));
+        outptr += 4;
+        ptr += 4;
+    }
+#endif // __ARM_NEON
+    for (; i < size; i++)
+    {
+        *outptr = op.func(*outptr, *ptr);
+        outptr++;
+        ptr++;
+    }
+}
+
+// reduce size contiguous floats into elempack lanes, then merge them into outptr with op2
+// two independent accumulators hide the latency of the dependent chain
+template<typename Op, typename Op2>
+static void reduction_row(const float* ptr, int size, int elempack, float v0, float* outptr)
+{
+    Op op;
+    Op2 op2;
+
+    int i = 0;
+#if __ARM_NEON
+    float32x4_t _sum0 = vdupq_n_f32(v0);
+    float32x4_t _sum1 = vdupq_n_f32(v0);
+    for (; i + 7 < size; i += 8)
+    {
+        float32x4_t _p0 = vld1q_f32(ptr);
+        float32x4_t _p1 = vld1q_f32(ptr + 4);
+        _sum0 = op.func_pack4(_sum0, _p0);
+        _sum1 = op.func_pack4(_sum1, _p1);
+        ptr += 8;
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        float32x4_t _p = vld1q_f32(ptr);
+        _sum0 = op.func_pack4(_sum0, _p);
+        ptr += 4;
+    }
+    _sum0 = op2.func_pack4(_sum0, _sum1);
+    if (elempack == 4)
+    {
+        vst1q_f32(outptr, op2.func_pack4(vld1q_f32(outptr), _sum0));
+        return;
+    }
+#endif // __ARM_NEON
+    float sum = v0;
+    for (; i < size; i++)
+    {
+        sum = op.func(sum, *ptr);
+        ptr++;
+    }
+#if __ARM_NEON
+    float sums[4];
+    vst1q_f32(sums, _sum0);
+    sum = op2.func(sum, op2.func(op2.func(sums[0], sums[1]), op2.func(sums[2], sums[3])));
+#endif // __ARM_NEON
+    outptr[0] = op2.func(outptr[0], sum);
+}
+
+template<typename Op, typename Op2>
+static int reduction(const Mat& a, Mat& b, bool reduce_w, bool reduce_h, bool reduce_d, bool reduce_c, int keepdims, float v0, const Option& opt)
+{
+    const int dims = a.dims;
+    const int elempack = a.elempack;
+    const size_t out_elemsize = a.elemsize / elempack;
+
+    if (dims == 1)
+    {
+        b.create(1, out_elemsize, opt.blob_allocator);
+        if (b.empty())
+            return -100;
+
+        b[0] = v0;
+        reduction_row<Op, Op2>(a, a.w * elempack, 1, v0, b);
+
+        return 0;
+    }
+
+    // view the blob as outer x d x h x w, the packed axis is always the outermost one
+    const int outer = dims == 2 ? a.h : a.c;
+    int d = dims == 4 ? a.d : 1;
+    int h = dims >= 3 ? a.h : 1;
+    int w = a.w;
+    const size_t outer_stride = dims == 2 ? (size_t)a.w * elempack : a.cstep * elempack;
+
+    const bool reduce_outer = dims == 2 ? reduce_h : reduce_c;
+    bool rd = dims == 4 && reduce_d;
+    bool rh = dims >= 3 && reduce_h;
+    const bool rw = reduce_w;
+    const bool reduce_inner = rd || rh || rw;
+
+    int outd = rd ? 1 : d;
+    int outh = rh ? 1 : h;
+    int outw = rw ? 1 : w;
+
+    // the outermost axis keeps its packing as long as it is not reduced
+    const int out_elempack = reduce_outer ? 1 : elempack;
+    const int out_outer = reduce_outer ? 1 : outer;
+
+    if (keepdims)
+    {
+        if (dims == 2)
+            b.create(outw, out_outer, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (dims == 3)
+            b.create(outw, outh, out_outer, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (dims == 4)
+            b.create(outw, outh, outd, out_outer, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+    }
+    else
+    {
+        // outermost first
+        int shape[4];
+        int out_dims = 0;
+        if (!reduce_outer) shape[out_dims++] = outer;
+        if (dims == 4 && !rd) shape[out_dims++] = d;
+        if (dims >= 3 && !rh) shape[out_dims++] = h;
+        if (!rw) shape[out_dims++] = w;
+
+        if (out_dims == 0)
+            b.create(1, out_elemsize, opt.blob_allocator);
+        if (out_dims == 1)
+            b.create(shape[0], out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (out_dims == 2)
+            b.create(shape[1], shape[0], out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (out_dims == 3)
+            b.create(shape[2], shape[1], shape[0], out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+    }
+    if (b.empty())
+        return -100;
+
+    // merge adjacent inner axes that are both reduced or both kept, they are contiguous in memory
+    if (rh == rw)
+    {
+        w *= h;
+        h = 1;
+        rh = rw;
+    }
+    if (h == 1 && rd == rw)
+    {
+        w *= d;
+        d = 1;
+        rd = rw;
+    }
+    if (d != 1 && rd == rh)
+    {
+        h *= d;
+        d = 1;
+    }
+
+    outd = rd ? 1 : d;
+    outh = rh ? 1 : h;
+    outw = rw ? 1 : w;
+    const int inner_size = outd * outh * outw;
+
+    // reduce the inner axes of each outer slice, all packed lanes at once
+    Mat sums;
+    if (reduce_outer && reduce_inner)
+    {
+        sums.create(inner_size * elempack, outer, 4u, opt.workspace_allocator);
+        if (sums.empty())
+            return -100;
+    }
+
+    if (reduce_inner)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < outer; q++)
+        {
+            const float* ptr = (const float*)a.data + q * outer_stride;
+
+            float* outptr;
+            if (reduce_outer)
+                outptr = sums.row(q);
+            else if (b.dims >= 3)
+                outptr = b.channel(q);
+            else if (b.dims == 2)
+                outptr = b.row(q);
+            else
+                outptr = (float*)b + q * elempack;
+
+            for (int i = 0; i < inner_size * elempack; i++)
+            {
+                outptr[i] = v0;
+            }
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int y = 0; y < h; y++)
+                {
+                    float* outptr0 = outptr + ((rd ? 0 : z) * outh + (rh ? 0 : y)) * outw * elempack;
+
+                    if (rw)
+                        reduction_row<Op, Op2>(ptr, w * elempack, elempack, v0, outptr0);
+                    else
+                        reduction_elementwise<Op>(outptr0, ptr, w * elempack);
+
+                    ptr += w * elempack;
+                }
+            }
+        }
+    }
+
+    if (!reduce_outer)
+        return 0;
+
+    // reduce across the outer slices, then across the packed lanes
+    const int size = inner_size * elempack;
+
+    Mat acc(size, 4u, opt.workspace_allocator);
+    if (acc.empty())
+        return -100;
+
+    acc.fill(v0);
+
+    if (reduce_inner && inner_size == 1)
+    {
+        reduction_row<Op2, Op2>(sums, outer * elempack, elempack, v0, acc);
+    }
+    else
+    {
+        const float* src = reduce_inner ? (const float*)sums : (const float*)a;
+        const size_t src_stride = reduce_inner ? (size_t)sums.w : outer_stride;
+
+        const int nn_size = (size + 15) / 16;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ii = 0; ii < nn_size; ii++)
+        {
+            const int i = ii * 16;
+            const int n = std::min(16, size - i);
+
+            float* outptr = (float*)acc + i;
+
+            for (int q = 0; q < outer; q++)
+            {
+                const float* ptr = src + q * src_stride + i;
+
+                if (reduce_inner)
+                    reduction_elementwise<Op2>(outptr, ptr, n);
+                else
+                    reduction_elementwise<Op>(outptr, ptr, n);
+            }
+        }
+    }
+
+    const int plane = b.w * b.h * b.d;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < inner_size; i++)
+    {
+        float sum = v0;
+        reduction_row<Op2, Op2>((const float*)acc + i * elempack, elempack, 1, v0, &sum);
+
+        float* outptr = (float*)b.data + (i / plane) * b.cstep + i % plane;
+        *outptr = sum;
+    }
+
+    return 0;
+}
+
+static int reduction_op(const Mat& a, Mat& b, bool reduce_w, bool reduce_h, bool reduce_d, bool reduce_c, int keepdims, int operation, float coeff, const Option& opt)
+{
+    int ret = 0;
+
+    switch (operation)
+    {
+    case Reduction::ReductionOp_SUM:
+    case Reduction::ReductionOp_MEAN:
+    case Reduction::ReductionOp_LogSum:
+        ret = reduction<reduction_op_add, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    case Reduction::ReductionOp_ASUM:
+    case Reduction::ReductionOp_L1:
+        ret = reduction<reduction_op_asum, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    case Reduction::ReductionOp_SUMSQ:
+    case Reduction::ReductionOp_L2:
+        ret = reduction<reduction_op_sumsq, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    case Reduction::ReductionOp_MAX:
+        ret = reduction<reduction_op_max, reduction_op_max>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, -FLT_MAX, opt);
+        break;
+    case Reduction::ReductionOp_MIN:
+        ret = reduction<reduction_op_min, reduction_op_min>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, FLT_MAX, opt);
+        break;
+    case Reduction::ReductionOp_PROD:
+        ret = reduction<reduction_op_mul, reduction_op_mul>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 1.f, opt);
+        break;
+    case Reduction::ReductionOp_LogSumExp:
+        ret = reduction<reduction_op_sumexp, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    default:
+        // should never reach here
+        break;
+    }
+
+    if (ret != 0)
+        return ret;
+
+    const int size = (int)b.total() * b.elempack;
+
+    if (operation == Reduction::ReductionOp_LogSum || operation == Reduction::ReductionOp_LogSumExp)
+    {
+        float* ptr = b;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            ptr[i] = logf(ptr[i]);
+        }
+    }
+
+    if (operation == Reduction::ReductionOp_L2)
+    {
+        float* ptr = b;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            // flush subnormal input to zero, see the note in reduction.cpp
+            ptr[i] = sqrtf(ptr[i] < FLT_MIN ? 0.f : ptr[i]);
+        }
+    }
+
+    if (operation == Reduction::ReductionOp_MEAN)
+    {
+        const int dims = a.dims;
+        const int elempack = a.elempack;
+
+        int scale = 1;
+        if (dims == 1)
+        {
+            scale = a.w * elempack;
+        }
+        if (dims == 2)
+        {
+            if (reduce_w) scale *= a.w;
+            if (reduce_h) scale *= a.h * elempack;
+        }
+        if (dims == 3)
+        {
+            if (reduce_w) scale *= a.w;
+            if (reduce_h) scale *= a.h;
+            if (reduce_c) scale *= a.c * elempack;
+        }
+        if (dims == 4)
+        {
+            if (reduce_w) scale *= a.w;
+            if (reduce_h) scale *= a.h;
+            if (reduce_d) scale *= a.d;
+            if (reduce_c) scale *= a.c * elempack;
+        }
+
+        coeff = coeff / scale;
+    }
+
+    if (coeff != 1.f)
+    {
+        float* ptr = b;
+
+        int i = 0;
+#if __ARM_NEON
+        float32x4_t _coeff = vdupq_n_f32(coeff);
+        for (; i + 3 < size; i += 4)
+        {
+            vst1q_f32(ptr + i, vmulq_f32(vld1q_f32(ptr + i), _coeff));
+        }
+#endif // __ARM_NEON
+        for (; i < size; i++)
+        {
+            ptr[i] *= coeff;
+        }
+    }
+
+    return 0;
+}
+
+int Reduction_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int elembits = bottom_blob.elembits();
+
+#if NCNN_ARM82
+    if (support_fp16_storage && opt.use_fp16_storage && elembits == 16)
+        return forward_bf16s_fp16s(bottom_blob, top_blob, opt);
+#endif
+
+#if NCNN_BF16
+    if (opt.use_bf16_storage && elembits == 16)
+        return forward_bf16s_fp16s(bottom_blob, top_blob, opt);
+#endif
+
+    int dims = bottom_blob.dims;
+    int axes_flag[4] = {0};
+    bool reduce_w = false;
+    bool reduce_h = false;
+    bool reduce_d = false;
+    bool reduce_c = false;
+
+    if (reduce_all)
+    {
+        reduce_w = true;
+        reduce_h = true;
+        reduce_d = true;
+        reduce_c = true;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        int reduced_axes_num = axes.w;
+
+        for (int i = 0; i < reduced_axes_num; i++)
+        {
+            int axis = axes_ptr[i];
+            // handle negative axis
+            if (axis < 0)
+                axis += dims;
+            axes_flag[axis] = 1;
+        }
+
+        if (dims == 1)
+        {
+            reduce_w = true;
+        }
+        else if (dims == 2)
+        {
+            if (axes_flag[0] == 1) reduce_h = true;
+            if (axes_flag[1] == 1) reduce_w = true;
+        }
+        else if (dims == 3)
+        {
+            if (axes_flag[0] == 1) reduce_c = true;
+            if (axes_flag[1] == 1) reduce_h = true;
+            if (axes_flag[2] == 1) reduce_w = true;
+        }
+        else if (dims == 4)
+        {
+            if (axes_flag[0] == 1) reduce_c = true;
+            if (axes_flag[1] == 1) reduce_d = true;
+            if (axes_flag[2] == 1) reduce_h = true;
+            if (axes_flag[3] == 1) reduce_w = true;
+        }
+    }
+
+    if (!reduce_w && !reduce_h && !reduce_d && !reduce_c)
+    {
+        // nothing to reduce, keep the reference behavior
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (bottom_blob.elempack != 1)
+        {
+            Option opt_pack = opt;
+            opt_pack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return Reduction::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    return reduction_op(bottom_blob, top_blob, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, operation, coeff, opt);
+}
+
+#if NCNN_ARM82 || NCNN_BF16
+int Reduction_arm::forward_bf16s_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // accumulate in fp32, long sums lose too much precision in 16bit
+    bool fp16 = false;
+#if NCNN_ARM82
+    fp16 = support_fp16_storage && opt.use_fp16_storage;
+#endif
+
+    Option opt_fp32 = opt;
+    opt_fp32.blob_allocator = opt.workspace_allocator;
+    opt_fp32.use_fp16_storage = false;
+    opt_fp32.use_bf16_storage = false;
+
+    Mat bottom_blob_fp32;
+    if (fp16)
+        cast_float16_to_float32(bottom_blob, bottom_blob_fp32, opt_fp32);
+    else
+        cast_bfloat16_to_float32(bottom_blob, bottom_blob_fp32, opt_fp32);
+    if (bottom_blob_fp32.empty())
+        return -100;
+
+    // fp16 arithmetic may hand us pack8
+    if (bottom_blob_fp32.elempack == 8)
+    {
+        Mat bottom_blob_fp32_pack4;
+        convert_packing(bottom_blob_fp32, bottom_blob_fp32_pack4, 4, opt_fp32);
+        if (bottom_blob_fp32_pack4.empty())
+            return -100;
+
+        bottom_blob_fp32 = bottom_blob_fp32_pack4;
+    }
+
+    Mat top_blob_fp32;
+    int ret = forward(bottom_blob_fp32, top_blob_fp32, opt_fp32);
+    if (ret != 0)
+        return ret;
+
+    if (top_blob_fp32.empty())
+        return 0;
+
+    if (fp16)
+        cast_float32_to_float16(top_blob_fp32, top_blob, opt);
+    else
+        cast_float32_to_bfloat16(top_blob_fp32, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+#endif // NCNN_ARM82 || NCNN_BF16
+
+} // namespace ncnn
@@ -0,0 +1,26 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_REDUCTION_ARM_H
+#define LAYER_REDUCTION_ARM_H
+
+#include "reduction.h"
+
+namespace ncnn {
+
+class Reduction_arm : public Reduction
+{
+public:
+    Reduction_arm();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+protected:
+#if NCNN_ARM82 || NCNN_BF16
+    int forward_bf16s_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
+};
+
+} // namespace ncnn
+
+#endif // LAYER_REDUCTION_ARM_H
@@ -0,0 +1,116 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "squeeze_arm.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+Squeeze_arm::Squeeze_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Squeeze_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    if (bottom_blob.elempack == 1)
+        return Squeeze::forward(bottom_blob, top_blob, opt);
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+    const int channels = bottom_blob.c;
+    const int dims = bottom_blob.dims;
+
+    // the packed outermost axis holds at least elempack elements and never gets squeezed
+    // so the result keeps the packing and is a reshape in pack units
+    bool _squeeze_w = false;
+    bool _squeeze_h = false;
+    bool _squeeze_d = false;
+
+    if (axes.empty())
+    {
+        _squeeze_w = w == 1 && squeeze_w;
+        _squeeze_h = h == 1 && squeeze_h;
+        _squeeze_d = d == 1 && squeeze_d;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        for (int i = 0; i < axes.w; i++)
+        {
+            int axis = axes_ptr[i];
+            if (axis < 0)
+                axis = dims + axis;
+
+            if (dims == 2 && axis == 1) _squeeze_w = w == 1;
+            if (dims == 3 && axis == 1) _squeeze_h = h == 1;
+            if (dims == 3 && axis == 2) _squeeze_w = w == 1;
+            if (dims == 4 && axis == 1) _squeeze_d = d == 1;
+            if (dims == 4 && axis == 2) _squeeze_h = h == 1;
+            if (dims == 4 && axis == 3) _squeeze_w = w == 1;
+        }
+    }
+
+    if (dims == 1)
+    {
+        top_blob = bottom_blob;
+    }
+
+    if (dims == 2)
+    {
+        if (_squeeze_w)
+            top_blob = bottom_blob.reshape(h, opt.blob_allocator);
+        else
+            top_blob = bottom_blob;
+    }
+
+    if (dims == 3)
+    {
+        if (_squeeze_w && _squeeze_h)
+            top_blob = bottom_blob.reshape(channels, opt.blob_allocator);
+        else if (_squeeze_w)
+            top_blob = bottom_blob.reshape(h, channels, opt.blob_allocator);
+        else if (_squeeze_h)
+            top_blob = bottom_blob.reshape(w, channels, opt.blob_allocator);
+        else
+            top_blob = bottom_blob;
+    }
+
+    if (dims == 4)
+    {
+        if (_squeeze_w && _squeeze_h && _squeeze_d)
+            top_blob = bottom_blob.reshape(channels, opt.blob_allocator);
+        else if (_squeeze_w && _squeeze_h)
+            top_blob = bottom_blob.reshape(d, channels, opt.blob_allocator);
+        else if (_squeeze_w && _squeeze_d)
+            top_blob = bottom_blob.reshape(h, channels, opt.blob_allocator);
+        else if (_squeeze_h && _squeeze_d)
+            top_blob = bottom_blob.reshape(w, channels, opt.blob_allocator);
+        else if (_squeeze_w)
+            top_blob = bottom_blob.reshape(h, d, channels, opt.blob_allocator);
+        else if (_squeeze_h)
+            top_blob = bottom_blob.reshape(w, d, channels, opt.blob_allocator);
+        else if (_squeeze_d)
+            top_blob = bottom_blob.reshape(w, h, channels, opt.blob_allocator);
+        else
+            top_blob = bottom_blob;
+    }
+
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,41 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "tile_arm.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+Tile_arm::Tile_arm()
+{
+#if __ARM_NEON
+    support_packing = true;
+#if NCNN_ARM82
+    support_fp16_storage = cpu_support_arm_asimdhp();
+#endif
+#endif // __ARM_NEON
+
+#if NCNN_BF16
+    support_bf16_storage = true;
+#endif
+}
+
+int Tile_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // repeating packs keeps the packed axis outermost unless new leading axes appear
+    if (bottom_blob.elempack == 1 || repeats.w <= bottom_blob.dims)
+        return Tile::forward(bottom_blob, top_blob, opt);
+
+    Option opt_pack = opt;
+    opt_pack.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_unpacked;
+    convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+    if (bottom_blob_unpacked.empty())
+        return -100;
+
+    return Tile::forward(bottom_blob_unpacked, top_blob, opt);
+}
+
+} // namespace ncnn
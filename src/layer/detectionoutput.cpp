@@ -35,22 +35,8 @@ struct BBoxRect
     int label;
 };
 
-static inline float intersection_area(const BBoxRect& a, const BBoxRect& b)
-{
-    if (a.xmin > b.xmax || a.xmax < b.xmin || a.ymin > b.ymax || a.ymax < b.ymin)
-    {
-        // no intersection
-        return 0.f;
-    }
-
-    float inter_width = std::min(a.xmax, b.xmax) - std::max(a.xmin, b.xmin);
-    float inter_height = std::min(a.ymax, b.ymax) - std::max(a.ymin, b.ymin);
-
-    return inter_width * inter_height;
-}
-
 template<typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right)
+static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right, int top_k)
 {
     int i = left;
     int j = right;
@@ -76,57 +62,78 @@ static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& sco
     }
 
     if (left < j)
-        qsort_descent_inplace(datas, scores, left, j);
+        qsort_descent_inplace(datas, scores, left, j, top_k);
 
-    if (i < right)
-        qsort_descent_inplace(datas, scores, i, right);
+    // the partition beyond top_k keeps its elements unordered
+    if (i < right && i < top_k)
+        qsort_descent_inplace(datas, scores, i, right, top_k);
 }
 
+// sort descending until the first top_k elements are in place, all of them when top_k <= 0
+// the leading top_k elements come out exactly as a full sort would order them
 template<typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores)
+static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int top_k = 0)
 {
     if (datas.empty() || scores.empty())
         return;
 
-    qsort_descent_inplace(datas, scores, 0, static_cast<int>(scores.size() - 1));
+    const int size = static_cast<int>(scores.size());
+    if (top_k <= 0 || top_k > size)
+        top_k = size;
+
+    qsort_descent_inplace(datas, scores, 0, size - 1, top_k);
 }
 
 static void nms_sorted_bboxes(const std::vector<BBoxRect>& bboxes, std::vector<size_t>& picked, float nms_threshold)
 {
     picked.clear();
 
-    const size_t n = bboxes.size();
-
-    std::vector<float> areas(n);
-    for (size_t i = 0; i < n; i++)
-    {
-        const BBoxRect& r = bboxes[i];
+    const int n = static_cast<int>(bboxes.size());
+    if (n == 0)
+        return;
 
-        float width = r.xmax - r.xmin;
-        float height = r.ymax - r.ymin;
+    // picked boxes in planar layout so that the iou against all of them vectorizes
+    std::vector<float> picked_boxes(n * 5);
+    float* picked_xmin = &picked_boxes[0];
+    float* picked_ymin = picked_xmin + n;
+    float* picked_xmax = picked_ymin + n;
+    float* picked_ymax = picked_xmax + n;
+    float* picked_areas = picked_ymax + n;
+    int picked_count = 0;
 
-        areas[i] = width * height;
-    }
-
-    for (size_t i = 0; i < n; i++)
+    for (int i = 0; i < n; i++)
     {
         const BBoxRect& a = bboxes[i];
+        const float area = (a.xmax - a.xmin) * (a.ymax - a.ymin);
 
-        int keep = 1;
-        for (int j = 0; j < (int)picked.size(); j++)
+        // compare against the picked boxes 16 at a time and stop at the first overlap
+        int suppressed = 0;
+        for (int j0 = 0; j0 < picked_count && !suppressed; j0 += 16)
         {
-            const BBoxRect& b = bboxes[picked[j]];
-
-            // intersection over union
-            float inter_area = intersection_area(a, b);
-            float union_area = areas[i] + areas[picked[j]] - inter_area;
-            //             float IoU = inter_area / union_area
-            if (inter_area / union_area > nms_threshold)
-                keep = 0;
+            const int j1 = std::min(j0 + 16, picked_count);
+            for (int j = j0; j < j1; j++)
+            {
+                // intersection over union
+                const bool no_intersection = (a.xmin > picked_xmax[j]) | (a.xmax < picked_xmin[j]) | (a.ymin > picked_ymax[j]) | (a.ymax < picked_ymin[j]);
+                const float inter_width = std::min(a.xmax, picked_xmax[j]) - std::max(a.xmin, picked_xmin[j]);
+                const float inter_height = std::min(a.ymax, picked_ymax[j]) - std::max(a.ymin, picked_ymin[j]);
+                const float inter_area = no_intersection ? 0.f : inter_width * inter_height;
+                const float union_area = area + picked_areas[j] - inter_area;
+                suppressed |= inter_area / union_area > nms_threshold;
+            }
         }
 
-        if (keep)
-            picked.push_back(i);
+        if (suppressed)
+            continue;
+
+        picked_xmin[picked_count] = a.xmin;
+        picked_ymin[picked_count] = a.ymin;
+        picked_xmax[picked_count] = a.xmax;
+        picked_ymax[picked_count] = a.ymax;
+        picked_areas[picked_count] = area;
+        picked_count++;
+
+        picked.push_back(i);
     }
 }
 
@@ -215,8 +222,8 @@ int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<M
             }
         }
 
-        // sort inplace
-        qsort_descent_inplace(class_bbox_rects, class_bbox_scores);
+        // sort inplace, only the leading nms_top_k matter
+        qsort_descent_inplace(class_bbox_rects, class_bbox_scores, nms_top_k);
 
         // keep nms_top_k
         if (nms_top_k < (int)class_bbox_rects.size())
@@ -251,8 +258,8 @@ int DetectionOutput::forward(const std::vector<Mat>& bottom_blobs, std::vector<M
         bbox_scores.insert(bbox_scores.end(), class_bbox_scores.begin(), class_bbox_scores.end());
     }
 
-    // global sort inplace
-    qsort_descent_inplace(bbox_rects, bbox_scores);
+    // global sort inplace, only the leading keep_top_k matter
+    qsort_descent_inplace(bbox_rects, bbox_scores, keep_top_k);
 
     // keep_top_k
     if (keep_top_k < (int)bbox_rects.size())
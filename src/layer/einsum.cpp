@@ -14,6 +14,8 @@ Einsum::Einsum()
 
 int Einsum::load_param(const ParamDict& pd)
 {
+    gemm_lowering = 0;
+
     Mat equation_mat = pd.get(0, Mat());
 
     const int equation_len = equation_mat.w;
@@ -88,9 +90,127 @@ int Einsum::load_param(const ParamDict& pd)
         }
     }
 
+    resolve_gemm_lowering();
+
     return 0;
 }
 
+static bool token_has(const std::string& token, char c)
+{
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (token[i] == c)
+            return true;
+    }
+
+    return false;
+}
+
+// the letters of token that also appear in filter, in token order
+static std::string token_filter(const std::string& token, const std::string& filter)
+{
+    std::string t;
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        if (token_has(filter, token[i]))
+            t.push_back(token[i]);
+    }
+
+    return t;
+}
+
+static bool token_has_duplicate(const std::string& token)
+{
+    for (size_t i = 0; i < token.size(); i++)
+    {
+        for (size_t j = i + 1; j < token.size(); j++)
+        {
+            if (token[i] == token[j])
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void Einsum::resolve_gemm_lowering()
+{
+    gemm_lowering = 0;
+
+    if (lhs_tokens.size() != 2 || rhs_token.empty())
+        return;
+
+    const std::string& a = lhs_tokens[0];
+    const std::string& b = lhs_tokens[1];
+    const std::string& out = rhs_token;
+
+    if (token_has_duplicate(a) || token_has_duplicate(b) || token_has_duplicate(out))
+        return;
+
+    // classify the indices
+    //   batch  in a b out
+    //   m      in a out
+    //   n      in b out
+    //   k      in a b
+    // an index summed over a single operand is not a gemm
+    std::string ab = a + b;
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        if (!token_has(ab, out[i]))
+            return;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (!token_has(b, a[i]) && !token_has(out, a[i]))
+            return;
+    }
+    for (size_t i = 0; i < b.size(); i++)
+    {
+        if (!token_has(a, b[i]) && !token_has(out, b[i]))
+            return;
+    }
+
+    std::string a_batch;
+    std::string a_m;
+    std::string a_k;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        const bool in_b = token_has(b, a[i]);
+        const bool in_out = token_has(out, a[i]);
+        if (in_b && in_out) a_batch.push_back(a[i]);
+        if (!in_b && in_out) a_m.push_back(a[i]);
+        if (in_b && !in_out) a_k.push_back(a[i]);
+    }
+
+    std::string b_batch = token_filter(b, a_batch);
+    std::string b_k = token_filter(b, a_k);
+    std::string b_n;
+    for (size_t i = 0; i < b.size(); i++)
+    {
+        if (!token_has(a, b[i]))
+            b_n.push_back(b[i]);
+    }
+
+    // prefer the batch and k order under which an operand is already laid out for gemm
+    const bool a_direct = a == a_batch + a_m + a_k || a == a_batch + a_k + a_m;
+    const bool b_direct = b == b_batch + b_k + b_n || b == b_batch + b_n + b_k;
+
+    batch_token = a_direct || !b_direct ? a_batch : b_batch;
+    k_token = a_direct || !b_direct ? a_k : b_k;
+    m_token = a_m;
+    n_token = b_n;
+
+    gemm_transA = a == batch_token + k_token + m_token && a != batch_token + m_token + k_token ? 1 : 0;
+    gemm_transB = b == batch_token + n_token + k_token && b != batch_token + k_token + n_token ? 1 : 0;
+    gemm_output_transpose = out == batch_token + n_token + m_token && out != batch_token + m_token + n_token ? 1 : 0;
+
+    gemm_a_token = gemm_transA ? batch_token + k_token + m_token : batch_token + m_token + k_token;
+    gemm_b_token = gemm_transB ? batch_token + n_token + k_token : batch_token + k_token + n_token;
+    gemm_out_token = gemm_output_transpose ? batch_token + n_token + m_token : batch_token + m_token + n_token;
+
+    gemm_lowering = 1;
+}
+
 static float get_indexed_value(const Mat& m, const std::string& token, std::vector<int>& indexes)
 {
     const int dims = m.dims;
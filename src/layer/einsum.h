@@ -17,10 +17,30 @@ public:
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+protected:
+    void resolve_gemm_lowering();
+
 public:
     // equation tokens
     std::vector<std::string> lhs_tokens;
     std::string rhs_token;
+
+    // two operand contraction lowered to batched gemm, resolved at load_param
+    int gemm_lowering;
+    int gemm_transA;
+    int gemm_transB;
+    int gemm_output_transpose;
+
+    // index classes, in the order they are laid out for gemm
+    std::string batch_token;
+    std::string m_token;
+    std::string n_token;
+    std::string k_token;
+
+    // per batch gemm layout of A, B and the output
+    std::string gemm_a_token;
+    std::string gemm_b_token;
+    std::string gemm_out_token;
 };
 
 } // namespace ncnn
@@ -84,22 +84,8 @@ struct Rect
     float y2;
 };
 
-static inline float intersection_area(const Rect& a, const Rect& b)
-{
-    if (a.x1 > b.x2 || a.x2 < b.x1 || a.y1 > b.y2 || a.y2 < b.y1)
-    {
-        // no intersection
-        return 0.f;
-    }
-
-    float inter_width = std::min(a.x2, b.x2) - std::max(a.x1, b.x1);
-    float inter_height = std::min(a.y2, b.y2) - std::max(a.y1, b.y1);
-
-    return inter_width * inter_height;
-}
-
 template<typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right)
+static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int left, int right, int top_k)
 {
     int i = left;
     int j = right;
@@ -125,57 +111,81 @@ static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& sco
     }
 
     if (left < j)
-        qsort_descent_inplace(datas, scores, left, j);
+        qsort_descent_inplace(datas, scores, left, j, top_k);
 
-    if (i < right)
-        qsort_descent_inplace(datas, scores, i, right);
+    // the partition beyond top_k keeps its elements unordered
+    if (i < right && i < top_k)
+        qsort_descent_inplace(datas, scores, i, right, top_k);
 }
 
+// sort descending until the first top_k elements are in place, all of them when top_k <= 0
+// the leading top_k elements come out exactly as a full sort would order them
 template<typename T>
-static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores)
+static void qsort_descent_inplace(std::vector<T>& datas, std::vector<float>& scores, int top_k = 0)
 {
     if (datas.empty() || scores.empty())
         return;
 
-    qsort_descent_inplace(datas, scores, 0, static_cast<int>(scores.size() - 1));
+    const int size = static_cast<int>(scores.size());
+    if (top_k <= 0 || top_k > size)
+        top_k = size;
+
+    qsort_descent_inplace(datas, scores, 0, size - 1, top_k);
 }
 
-static void nms_sorted_bboxes(const std::vector<Rect>& bboxes, std::vector<size_t>& picked, float nms_threshold)
+static void nms_sorted_bboxes(const std::vector<Rect>& bboxes, std::vector<size_t>& picked, float nms_threshold, int max_picked)
 {
     picked.clear();
 
-    const size_t n = bboxes.size();
-
-    std::vector<float> areas(n);
-    for (size_t i = 0; i < n; i++)
-    {
-        const Rect& r = bboxes[i];
-
-        float width = r.x2 - r.x1;
-        float height = r.y2 - r.y1;
+    const int n = static_cast<int>(bboxes.size());
+    if (n == 0)
+        return;
 
-        areas[i] = width * height;
-    }
+    // picked boxes in planar layout so that the iou against all of them vectorizes
+    std::vector<float> picked_boxes(n * 5);
+    float* picked_x1 = &picked_boxes[0];
+    float* picked_y1 = picked_x1 + n;
+    float* picked_x2 = picked_y1 + n;
+    float* picked_y2 = picked_x2 + n;
+    float* picked_areas = picked_y2 + n;
+    int picked_count = 0;
 
-    for (size_t i = 0; i < n; i++)
+    for (int i = 0; i < n; i++)
     {
+        if (max_picked > 0 && picked_count >= max_picked)
+            break;
+
         const Rect& a = bboxes[i];
+        const float area = (a.x2 - a.x1) * (a.y2 - a.y1);
 
-        int keep = 1;
-        for (size_t j = 0; j < picked.size(); j++)
+        // compare against the picked boxes 16 at a time and stop at the first overlap
+        int suppressed = 0;
+        for (int j0 = 0; j0 < picked_count && !suppressed; j0 += 16)
         {
-            const Rect& b = bboxes[picked[j]];
-
-            // intersection over union
-            float inter_area = intersection_area(a, b);
-            float union_area = areas[i] + areas[picked[j]] - inter_area;
-            //             float IoU = inter_area / union_area
-            if (inter_area / union_area > nms_threshold)
-                keep = 0;
+            const int j1 = std::min(j0 + 16, picked_count);
+            for (int j = j0; j < j1; j++)
+            {
+                // intersection over union
+                const bool no_intersection = (a.x1 > picked_x2[j]) | (a.x2 < picked_x1[j]) | (a.y1 > picked_y2[j]) | (a.y2 < picked_y1[j]);
+                const float inter_width = std::min(a.x2, picked_x2[j]) - std::max(a.x1, picked_x1[j]);
+                const float inter_height = std::min(a.y2, picked_y2[j]) - std::max(a.y1, picked_y1[j]);
+                const float inter_area = no_intersection ? 0.f : inter_width * inter_height;
+                const float union_area = area + picked_areas[j] - inter_area;
+                suppressed |= inter_area / union_area > nms_threshold;
+            }
         }
 
-        if (keep)
-            picked.push_back(i);
+        if (suppressed)
+            continue;
+
+        picked_x1[picked_count] = a.x1;
+        picked_y1[picked_count] = a.y1;
+        picked_x2[picked_count] = a.x2;
+        picked_y2[picked_count] = a.y2;
+        picked_areas[picked_count] = area;
+        picked_count++;
+
+        picked.push_back(i);
     }
 }
 
@@ -274,12 +284,13 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     }
 
     // remove predicted boxes with either height or width < threshold
-    std::vector<Rect> proposal_boxes;
-    std::vector<float> scores;
+    std::vector<std::vector<Rect> > anchor_proposal_boxes(num_anchors);
+    std::vector<std::vector<float> > anchor_scores(num_anchors);
 
     float im_scale = im_info_blob[2];
     float min_boxsize = min_size * im_scale;
 
+    #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < num_anchors; q++)
     {
         Mat pbs = proposals.channel(q);
@@ -295,14 +306,24 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
             if (pb_w >= min_boxsize && pb_h >= min_boxsize)
             {
                 Rect r = {pb[0], pb[1], pb[2], pb[3]};
-                proposal_boxes.push_back(r);
-                scores.push_back(scoreptr[i]);
+                anchor_proposal_boxes[q].push_back(r);
+                anchor_scores[q].push_back(scoreptr[i]);
             }
         }
     }
 
-    // sort all (proposal, score) pairs by score from highest to lowest
-    qsort_descent_inplace(proposal_boxes, scores);
+    // gather in anchor order
+    std::vector<Rect> proposal_boxes;
+    std::vector<float> scores;
+
+    for (int q = 0; q < num_anchors; q++)
+    {
+        proposal_boxes.insert(proposal_boxes.end(), anchor_proposal_boxes[q].begin(), anchor_proposal_boxes[q].end());
+        scores.insert(scores.end(), anchor_scores[q].begin(), anchor_scores[q].end());
+    }
+
+    // sort all (proposal, score) pairs by score from highest to lowest, only the leading pre_nms_topN matter
+    qsort_descent_inplace(proposal_boxes, scores, pre_nms_topN);
 
     // take top pre_nms_topN
     if (pre_nms_topN > 0 && pre_nms_topN < (int)proposal_boxes.size())
@@ -313,7 +334,7 @@ int Proposal::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
 
     // apply nms with nms_thresh
     std::vector<size_t> picked;
-    nms_sorted_bboxes(proposal_boxes, picked, nms_thresh);
+    nms_sorted_bboxes(proposal_boxes, picked, nms_thresh, after_nms_topN);
 
     // take after_nms_topN
     int picked_count = std::min((int)picked.size(), after_nms_topN);
@@ -98,39 +98,40 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
     int d = bottom_blob.d;
     int channels = bottom_blob.c;
     size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
 
     const int outdims = std::max(dims, repeats_num);
     if (repeat_w != 1 && repeat_h == 1 && repeat_d == 1 && repeat_c == 1)
     {
         if (outdims == 1)
-            top_blob.create(w * repeat_w, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, elemsize, elempack, opt.blob_allocator);
         if (outdims == 2)
-            top_blob.create(w * repeat_w, h, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h, elemsize, elempack, opt.blob_allocator);
         if (outdims == 3)
-            top_blob.create(w * repeat_w, h, channels, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h, channels, elemsize, elempack, opt.blob_allocator);
         if (outdims == 4)
-            top_blob.create(w * repeat_w, h, d, channels, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h, d, channels, elemsize, elempack, opt.blob_allocator);
     }
     else if (repeat_h != 1 && repeat_d == 1 && repeat_c == 1)
     {
         if (outdims == 2)
-            top_blob.create(w * repeat_w, h * repeat_h, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, elemsize, elempack, opt.blob_allocator);
         if (outdims == 3)
-            top_blob.create(w * repeat_w, h * repeat_h, channels, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, channels, elemsize, elempack, opt.blob_allocator);
         if (outdims == 4)
-            top_blob.create(w * repeat_w, h * repeat_h, d, channels, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, d, channels, elemsize, elempack, opt.blob_allocator);
     }
     else if (repeat_d == 1 && repeat_c != 1)
     {
         if (outdims == 3)
-            top_blob.create(w * repeat_w, h * repeat_h, channels * repeat_c, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
         if (outdims == 4)
-            top_blob.create(w * repeat_w, h * repeat_h, d, channels * repeat_c, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, d, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
     }
     else if (repeat_d != 1 && repeat_c != 1)
     {
         if (outdims == 4)
-            top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, channels * repeat_c, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
     }
     else // all ones
     {
@@ -141,15 +142,16 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
         }
 
         if (outdims == 2)
-            top_blob.create(w * repeat_w, h * repeat_h, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, elemsize, elempack, opt.blob_allocator);
         if (outdims == 3)
-            top_blob.create(w * repeat_w, h * repeat_h, channels * repeat_c, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
         if (outdims == 4)
-            top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, channels * repeat_c, elemsize, opt.blob_allocator);
+            top_blob.create(w * repeat_w, h * repeat_h, d * repeat_d, channels * repeat_c, elemsize, elempack, opt.blob_allocator);
     }
     if (top_blob.empty())
         return -100;
 
+    // the packed axis is always the outermost one, so whole packs are repeated
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < channels; q++)
     {
@@ -158,13 +160,13 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
         {
             for (int y = 0; y < h; y++)
             {
-                const float* ptr = bottom_blob.channel(q).depth(z).row(y);
-                float* outptr = top_blob.channel(q).depth(z).row(y);
+                const unsigned char* ptr = bottom_blob.channel(q).depth(z).row<unsigned char>(y);
+                unsigned char* outptr = top_blob.channel(q).depth(z).row<unsigned char>(y);
 
                 for (int p = 0; p < repeat_w; p++)
                 {
-                    memcpy(outptr, ptr, w * sizeof(float));
-                    outptr += w;
+                    memcpy(outptr, ptr, w * elemsize);
+                    outptr += w * elemsize;
                 }
             }
         }
@@ -172,26 +174,26 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
         // repeat 1-h
         for (int z = 0; z < d; z++)
         {
-            const float* ptr = top_blob.channel(q).depth(z);
-            float* outptr = top_blob.channel(q).depth(z).row(h);
+            const unsigned char* ptr = top_blob.channel(q).depth(z);
+            unsigned char* outptr = top_blob.channel(q).depth(z).row<unsigned char>(h);
 
-            const int size = w * repeat_w * h;
+            const size_t size = (size_t)w * repeat_w * h * elemsize;
             for (int p = 1; p < repeat_h; p++)
             {
-                memcpy(outptr, ptr, size * sizeof(float));
+                memcpy(outptr, ptr, size);
                 outptr += size;
             }
         }
 
         // repeat 1-d
         {
-            const float* ptr = top_blob.channel(q);
-            float* outptr = top_blob.channel(q).depth(d);
+            const unsigned char* ptr = top_blob.channel(q);
+            unsigned char* outptr = top_blob.channel(q).depth(d);
 
-            const int size = w * repeat_w * h * repeat_h * d;
+            const size_t size = (size_t)w * repeat_w * h * repeat_h * d * elemsize;
             for (int p = 1; p < repeat_d; p++)
             {
-                memcpy(outptr, ptr, size * sizeof(float));
+                memcpy(outptr, ptr, size);
                 outptr += size;
             }
         }
@@ -201,10 +203,10 @@ int Tile::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) cons
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int p = 1; p < repeat_c; p++)
     {
-        const float* ptr = top_blob.channel_range(0, channels);
-        float* outptr = top_blob.channel_range(p * channels, channels);
+        const unsigned char* ptr = top_blob.channel_range(0, channels);
+        unsigned char* outptr = top_blob.channel_range(p * channels, channels);
 
-        memcpy(outptr, ptr, top_blob.cstep * channels * sizeof(float));
+        memcpy(outptr, ptr, top_blob.cstep * channels * elemsize);
     }
 
     return 0;
@@ -0,0 +1,239 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise1d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+ConvolutionDepthWise1D_x86::ConvolutionDepthWise1D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int ConvolutionDepthWise1D_x86::create_pipeline(const Option& opt)
+{
+    if (dynamic_weight)
+    {
+        // dynamic weight runs the reference implementation on unpacked blobs
+        support_packing = false;
+        return 0;
+    }
+
+    int channels = (weight_data_size / group) / kernel_w / (num_output / group) * group;
+
+    // group convolution runs the reference implementation on unpacked blobs
+    if (channels != group || group != num_output)
+        return 0;
+
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        elempack = channels % 16 == 0 ? 16 : channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        elempack = channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#else
+        elempack = channels % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(kernel_w, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise1D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (weight_data_tm.empty())
+    {
+        // group convolution
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_p = opt;
+            opt_p.blob_allocator = opt.workspace_allocator;
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_p);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return ConvolutionDepthWise1D::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const float* sptr0 = bottom_blob_bordered.row(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 16;
+            float* outptr = top_blob.row(g);
+
+            __m512 _bias = bias_term ? _mm512_loadu_ps((const float*)bias_data + g * 16) : _mm512_setzero_ps();
+
+            for (int j = 0; j < outw; j++)
+            {
+                __m512 _sum = _bias;
+
+                const float* sptr = sptr0 + j * stride_w * 16;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    __m512 _val = _mm512_loadu_ps(sptr + k * dilation_w * 16);
+                    __m512 _w = _mm512_loadu_ps(kptr + k * 16);
+                    _sum = _mm512_fmadd_ps(_val, _w, _sum);
+                }
+
+                _sum = activation_avx512(_sum, activation_type, activation_params);
+
+                _mm512_storeu_ps(outptr, _sum);
+                outptr += 16;
+            }
+        }
+    }
+#endif // __AVX512F__
+
+    if (elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const float* sptr0 = bottom_blob_bordered.row(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 8;
+            float* outptr = top_blob.row(g);
+
+            __m256 _bias = bias_term ? _mm256_loadu_ps((const float*)bias_data + g * 8) : _mm256_setzero_ps();
+
+            for (int j = 0; j < outw; j++)
+            {
+                __m256 _sum = _bias;
+
+                const float* sptr = sptr0 + j * stride_w * 8;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    __m256 _val = _mm256_loadu_ps(sptr + k * dilation_w * 8);
+                    __m256 _w = _mm256_loadu_ps(kptr + k * 8);
+                    _sum = _mm256_comp_fmadd_ps(_val, _w, _sum);
+                }
+
+                _sum = activation_avx(_sum, activation_type, activation_params);
+
+                _mm256_storeu_ps(outptr, _sum);
+                outptr += 8;
+            }
+        }
+    }
+#endif // __AVX__
+
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const float* sptr0 = bottom_blob_bordered.row(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g * 4;
+            float* outptr = top_blob.row(g);
+
+            __m128 _bias = bias_term ? _mm_loadu_ps((const float*)bias_data + g * 4) : _mm_setzero_ps();
+
+            for (int j = 0; j < outw; j++)
+            {
+                __m128 _sum = _bias;
+
+                const float* sptr = sptr0 + j * stride_w * 4;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    __m128 _val = _mm_loadu_ps(sptr + k * dilation_w * 4);
+                    __m128 _w = _mm_loadu_ps(kptr + k * 4);
+                    _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                }
+
+                _sum = activation_sse(_sum, activation_type, activation_params);
+
+                _mm_storeu_ps(outptr, _sum);
+                outptr += 4;
+            }
+        }
+    }
+#endif // __SSE2__
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < h; g++)
+        {
+            const float* sptr0 = bottom_blob_bordered.row(g);
+            const float* kptr = (const float*)weight_data_tm + kernel_w * g;
+            float* outptr = top_blob.row(g);
+
+            const float bias = bias_term ? bias_data[g] : 0.f;
+
+            for (int j = 0; j < outw; j++)
+            {
+                float sum = bias;
+
+                const float* sptr = sptr0 + j * stride_w;
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    sum += sptr[k * dilation_w] * kptr[k];
+                }
+
+                outptr[j] = activation_ss(sum, activation_type, activation_params);
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,308 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolutiondepthwise3d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+ConvolutionDepthWise3D_x86::ConvolutionDepthWise3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int ConvolutionDepthWise3D_x86::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group convolution runs the reference implementation on unpacked blobs
+    if (channels != group || group != num_output)
+        return 0;
+
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        elempack = channels % 16 == 0 ? 16 : channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        elempack = channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#else
+        elempack = channels % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int ConvolutionDepthWise3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (channels * elempack != group || group != num_output)
+    {
+        // group convolution
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_p = opt;
+            opt_p.blob_allocator = opt.workspace_allocator;
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_p);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return ConvolutionDepthWise3D::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+    const int outd = (bottom_blob_bordered.d - kernel_extent_d) / stride_d + 1;
+
+    top_blob.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = w * dilation_h - kernel_w * dilation_w;
+        int gap1 = h * w * dilation_d - w * kernel_h * dilation_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += dilation_w;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            float* outptr = top_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 16;
+            const Mat m = bottom_blob_bordered.channel(g);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        __m512 _sum = _mm512_setzero_ps();
+
+                        if (bias_term)
+                        {
+                            _sum = _mm512_loadu_ps((const float*)bias_data + g * 16);
+                        }
+
+                        const float* sptr = sptr0 + j * stride_w * 16;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            __m512 _val = _mm512_loadu_ps(sptr + space_ofs[k] * 16);
+                            __m512 _w = _mm512_loadu_ps(kptr + k * 16);
+                            _sum = _mm512_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _sum = activation_avx512(_sum, activation_type, activation_params);
+
+                        _mm512_storeu_ps(outptr, _sum);
+                        outptr += 16;
+                    }
+                }
+            }
+        }
+    }
+#endif // __AVX512F__
+
+    if (elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            float* outptr = top_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 8;
+            const Mat m = bottom_blob_bordered.channel(g);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        __m256 _sum = _mm256_setzero_ps();
+
+                        if (bias_term)
+                        {
+                            _sum = _mm256_loadu_ps((const float*)bias_data + g * 8);
+                        }
+
+                        const float* sptr = sptr0 + j * stride_w * 8;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            __m256 _val = _mm256_loadu_ps(sptr + space_ofs[k] * 8);
+                            __m256 _w = _mm256_loadu_ps(kptr + k * 8);
+                            _sum = _mm256_comp_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _sum = activation_avx(_sum, activation_type, activation_params);
+
+                        _mm256_storeu_ps(outptr, _sum);
+                        outptr += 8;
+                    }
+                }
+            }
+        }
+    }
+#endif // __AVX__
+
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            float* outptr = top_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 4;
+            const Mat m = bottom_blob_bordered.channel(g);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        __m128 _sum = _mm_setzero_ps();
+
+                        if (bias_term)
+                        {
+                            _sum = _mm_loadu_ps((const float*)bias_data + g * 4);
+                        }
+
+                        const float* sptr = sptr0 + j * stride_w * 4;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            __m128 _val = _mm_loadu_ps(sptr + space_ofs[k] * 4);
+                            __m128 _w = _mm_loadu_ps(kptr + k * 4);
+                            _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                        }
+
+                        _sum = activation_sse(_sum, activation_type, activation_params);
+
+                        _mm_storeu_ps(outptr, _sum);
+                        outptr += 4;
+                    }
+                }
+            }
+        }
+    }
+#endif // __SSE2__
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            float* outptr = top_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g;
+            const Mat m = bottom_blob_bordered.channel(g);
+
+            for (int z = 0; z < outd; z++)
+            {
+                for (int i = 0; i < outh; i++)
+                {
+                    const float* sptr0 = m.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < outw; j++)
+                    {
+                        float sum = 0.f;
+
+                        if (bias_term)
+                            sum = bias_data[g];
+
+                        const float* sptr = sptr0 + j * stride_w;
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            sum += sptr[space_ofs[k]] * kptr[k];
+                        }
+
+                        outptr[j] = activation_ss(sum, activation_type, activation_params);
+                    }
+
+                    outptr += outw;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,325 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolution1d_x86.h"
+
+#include "layer_type.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Deconvolution1D_x86::Deconvolution1D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    activation = 0;
+    gemm = 0;
+}
+
+int Deconvolution1D_x86::create_pipeline(const Option& opt)
+{
+    if (dynamic_weight)
+    {
+        // dynamic weight runs the reference implementation on unpacked blobs
+        support_packing = false;
+        return 0;
+    }
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    int num_input = weight_data_size / kernel_w / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, 1);                     // transA
+    pd.set(3, 0);                     // transB
+    pd.set(4, 1);                     // constantA
+    pd.set(5, 0);                     // constantB
+    pd.set(6, 1);                     // constantC
+    pd.set(7, kernel_w * num_output); // M = kernel_w*num_output
+    pd.set(8, 0);                     // N = w
+    pd.set(9, num_input);             // K = inch
+    pd.set(10, -1);                   // constant_broadcast_type_C = null
+    pd.set(11, 0);                    // output_N1M
+    pd.set(12, out_elempack);
+
+    gemm->load_param(pd);
+
+    // kw-inch-outch to pa-kw-outch/pa-inch
+    Mat tmp;
+    {
+        Mat weight_data_r2 = weight_data.reshape(kernel_w, num_input, num_output);
+
+        tmp.create(kernel_w * num_output, num_input);
+
+        for (int p = 0; p < num_input; p += 1)
+        {
+            float* g00 = tmp.row(p);
+
+            for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+            {
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    for (int i = 0; i < out_elempack; i++)
+                    {
+                        const float* k00 = weight_data_r2.channel(q + i).row(p);
+                        g00[0] = k00[k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    ncnn::Mat weights[1];
+    weights[0] = tmp;
+
+    gemm->load_model(ModelBinFromMatArray(weights));
+
+    gemm->create_pipeline(opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Deconvolution1D_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+int Deconvolution1D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int w = bottom_blob.w;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    int outh = num_output / out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || output_w > 0)
+    {
+        top_blob_bordered.create(outw, outh, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    // sgemm
+    Mat top_col2im;
+    Option opt_b = opt;
+    opt_b.blob_allocator = opt.workspace_allocator;
+    int ret = gemm->forward(bottom_blob, top_col2im, opt_b);
+    if (ret != 0)
+        return ret;
+
+    {
+        // col2im
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (out_elempack == 16)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < outh; p++)
+            {
+                float* outptr = top_blob_bordered.row(p);
+
+                __m512 _bias = bias_data.empty() ? _mm512_setzero_ps() : _mm512_loadu_ps((const float*)bias_data + p * 16);
+                for (int i = 0; i < outw; i++)
+                {
+                    _mm512_storeu_ps(outptr + i * 16, _bias);
+                }
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    const float* sptr = top_col2im.row(p * kernel_w + k);
+                    float* ptr = outptr + dilation_w * k * 16;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        __m512 _val = _mm512_loadu_ps(ptr);
+                        __m512 _s = _mm512_loadu_ps(sptr);
+                        _val = _mm512_add_ps(_val, _s);
+                        _mm512_storeu_ps(ptr, _val);
+
+                        ptr += stride_w * 16;
+                        sptr += 16;
+                    }
+                }
+            }
+        }
+#endif // __AVX512F__
+
+        if (out_elempack == 8)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < outh; p++)
+            {
+                float* outptr = top_blob_bordered.row(p);
+
+                __m256 _bias = bias_data.empty() ? _mm256_setzero_ps() : _mm256_loadu_ps((const float*)bias_data + p * 8);
+                for (int i = 0; i < outw; i++)
+                {
+                    _mm256_storeu_ps(outptr + i * 8, _bias);
+                }
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    const float* sptr = top_col2im.row(p * kernel_w + k);
+                    float* ptr = outptr + dilation_w * k * 8;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        __m256 _val = _mm256_loadu_ps(ptr);
+                        __m256 _s = _mm256_loadu_ps(sptr);
+                        _val = _mm256_add_ps(_val, _s);
+                        _mm256_storeu_ps(ptr, _val);
+
+                        ptr += stride_w * 8;
+                        sptr += 8;
+                    }
+                }
+            }
+        }
+#endif // __AVX__
+
+        if (out_elempack == 4)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < outh; p++)
+            {
+                float* outptr = top_blob_bordered.row(p);
+
+                __m128 _bias = bias_data.empty() ? _mm_setzero_ps() : _mm_loadu_ps((const float*)bias_data + p * 4);
+                for (int i = 0; i < outw; i++)
+                {
+                    _mm_storeu_ps(outptr + i * 4, _bias);
+                }
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    const float* sptr = top_col2im.row(p * kernel_w + k);
+                    float* ptr = outptr + dilation_w * k * 4;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        __m128 _val = _mm_loadu_ps(ptr);
+                        __m128 _s = _mm_loadu_ps(sptr);
+                        _val = _mm_add_ps(_val, _s);
+                        _mm_storeu_ps(ptr, _val);
+
+                        ptr += stride_w * 4;
+                        sptr += 4;
+                    }
+                }
+            }
+        }
+#endif // __SSE2__
+
+        if (out_elempack == 1)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int p = 0; p < outh; p++)
+            {
+                float* outptr = top_blob_bordered.row(p);
+
+                const float bias = bias_data.empty() ? 0.f : bias_data[p];
+                for (int i = 0; i < outw; i++)
+                {
+                    outptr[i] = bias;
+                }
+
+                for (int k = 0; k < kernel_w; k++)
+                {
+                    const float* sptr = top_col2im.row(p * kernel_w + k);
+                    float* ptr = outptr + dilation_w * k;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        ptr[0] += sptr[0];
+
+                        ptr += stride_w;
+                        sptr += 1;
+                    }
+                }
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt);
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,376 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolutiondepthwise3d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+DeconvolutionDepthWise3D_x86::DeconvolutionDepthWise3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int DeconvolutionDepthWise3D_x86::create_pipeline(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
+
+    // group deconvolution runs the reference implementation on unpacked blobs
+    if (channels != group || group != num_output)
+        return 0;
+
+    int elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        elempack = channels % 16 == 0 ? 16 : channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        elempack = channels % 8 == 0 ? 8 : channels % 4 == 0 ? 4 : 1;
+#else
+        elempack = channels % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    if (elempack == 1)
+    {
+        weight_data_tm = weight_data;
+    }
+    else
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, group);
+        convert_packing(weight_data_r2, weight_data_tm, elempack, opt);
+    }
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int DeconvolutionDepthWise3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int channels = bottom_blob.c;
+    size_t elemsize = bottom_blob.elemsize;
+    int elempack = bottom_blob.elempack;
+
+    if (channels * elempack != group || group != num_output)
+    {
+        // group deconvolution
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_p = opt;
+            opt_p.blob_allocator = opt.workspace_allocator;
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_p);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return DeconvolutionDepthWise3D::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int d = bottom_blob.d;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    const int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    const int outd = (d - 1) * stride_d + kernel_extent_d + output_pad_behind;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || pad_front > 0 || pad_behind > 0 || (output_w > 0 && output_h > 0 && output_d > 0))
+    {
+        top_blob_bordered.create(outw, outh, outd, channels, elemsize, elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, outd, channels, elemsize, elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = outw * dilation_h - kernel_w * dilation_w;
+        int gap1 = outh * outw * dilation_d - outw * kernel_h * dilation_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += dilation_w;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            const float* inptr = bottom_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 16;
+            Mat out = top_blob_bordered.channel(g);
+
+            if (bias_term)
+            {
+                out.fill(_mm512_loadu_ps((const float*)bias_data + g * 16));
+            }
+            else
+            {
+                out.fill(_mm512_setzero_ps());
+            }
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr0 = out.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr = outptr0 + j * stride_w * 16;
+
+                        __m512 _val = _mm512_loadu_ps(inptr);
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            float* ptr = outptr + space_ofs[k] * 16;
+                            __m512 _w = _mm512_loadu_ps(kptr + k * 16);
+                            __m512 _sum = _mm512_loadu_ps(ptr);
+                            _sum = _mm512_fmadd_ps(_val, _w, _sum);
+                            _mm512_storeu_ps(ptr, _sum);
+                        }
+
+                        inptr += 16;
+                    }
+                }
+            }
+
+            if (activation_type)
+            {
+                float* outptr = out;
+                const int size = outw * outh * outd;
+
+                for (int i = 0; i < size; i++)
+                {
+                    __m512 _sum = _mm512_loadu_ps(outptr);
+                    _sum = activation_avx512(_sum, activation_type, activation_params);
+                    _mm512_storeu_ps(outptr, _sum);
+                    outptr += 16;
+                }
+            }
+        }
+    }
+#endif // __AVX512F__
+
+    if (elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            const float* inptr = bottom_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 8;
+            Mat out = top_blob_bordered.channel(g);
+
+            if (bias_term)
+            {
+                out.fill(_mm256_loadu_ps((const float*)bias_data + g * 8));
+            }
+            else
+            {
+                out.fill(_mm256_setzero_ps());
+            }
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr0 = out.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr = outptr0 + j * stride_w * 8;
+
+                        __m256 _val = _mm256_loadu_ps(inptr);
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            float* ptr = outptr + space_ofs[k] * 8;
+                            __m256 _w = _mm256_loadu_ps(kptr + k * 8);
+                            __m256 _sum = _mm256_loadu_ps(ptr);
+                            _sum = _mm256_comp_fmadd_ps(_val, _w, _sum);
+                            _mm256_storeu_ps(ptr, _sum);
+                        }
+
+                        inptr += 8;
+                    }
+                }
+            }
+
+            if (activation_type)
+            {
+                float* outptr = out;
+                const int size = outw * outh * outd;
+
+                for (int i = 0; i < size; i++)
+                {
+                    __m256 _sum = _mm256_loadu_ps(outptr);
+                    _sum = activation_avx(_sum, activation_type, activation_params);
+                    _mm256_storeu_ps(outptr, _sum);
+                    outptr += 8;
+                }
+            }
+        }
+    }
+#endif // __AVX__
+
+    if (elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            const float* inptr = bottom_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g * 4;
+            Mat out = top_blob_bordered.channel(g);
+
+            if (bias_term)
+            {
+                out.fill(_mm_loadu_ps((const float*)bias_data + g * 4));
+            }
+            else
+            {
+                out.fill(_mm_setzero_ps());
+            }
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr0 = out.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr = outptr0 + j * stride_w * 4;
+
+                        __m128 _val = _mm_loadu_ps(inptr);
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            float* ptr = outptr + space_ofs[k] * 4;
+                            __m128 _w = _mm_loadu_ps(kptr + k * 4);
+                            __m128 _sum = _mm_loadu_ps(ptr);
+                            _sum = _mm_comp_fmadd_ps(_val, _w, _sum);
+                            _mm_storeu_ps(ptr, _sum);
+                        }
+
+                        inptr += 4;
+                    }
+                }
+            }
+
+            if (activation_type)
+            {
+                float* outptr = out;
+                const int size = outw * outh * outd;
+
+                for (int i = 0; i < size; i++)
+                {
+                    __m128 _sum = _mm_loadu_ps(outptr);
+                    _sum = activation_sse(_sum, activation_type, activation_params);
+                    _mm_storeu_ps(outptr, _sum);
+                    outptr += 4;
+                }
+            }
+        }
+    }
+#endif // __SSE2__
+
+    if (elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int g = 0; g < channels; g++)
+        {
+            const float* inptr = bottom_blob.channel(g);
+            const float* kptr = (const float*)weight_data_tm + maxk * g;
+            Mat out = top_blob_bordered.channel(g);
+
+            out.fill(bias_term ? bias_data[g] : 0.f);
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr0 = out.depth(z * stride_d).row(i * stride_h);
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        float* outptr = outptr0 + j * stride_w;
+
+                        const float val = inptr[0];
+
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            outptr[space_ofs[k]] += val * kptr[k];
+                        }
+
+                        inptr += 1;
+                    }
+                }
+            }
+
+            if (activation_type)
+            {
+                float* outptr = out;
+                const int size = outw * outh * outd;
+
+                for (int i = 0; i < size; i++)
+                {
+                    outptr[i] = activation_ss(outptr[i], activation_type, activation_params);
+                }
+            }
+        }
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
+} // namespace ncnn
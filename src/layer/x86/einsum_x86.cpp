@@ -0,0 +1,354 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "einsum_x86.h"
+
+#include "layer_type.h"
+
+namespace ncnn {
+
+Einsum_x86::Einsum_x86()
+{
+    gemm = 0;
+}
+
+int Einsum_x86::create_pipeline(const Option& opt)
+{
+    if (!gemm_lowering)
+        return 0;
+
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, gemm_transA);            // transA
+    pd.set(3, gemm_transB);            // transB
+    pd.set(4, 0);                      // constantA
+    pd.set(5, 0);                      // constantB
+    pd.set(6, 1);                      // constantC
+    pd.set(7, 0);                      // M
+    pd.set(8, 0);                      // N
+    pd.set(9, 0);                      // K
+    pd.set(10, -1);                    // constant_broadcast_type_C = null
+    pd.set(11, 0);                     // output_N1M
+    pd.set(12, 1);                     // output_elempack
+    pd.set(14, gemm_output_transpose); // output_transpose
+
+    gemm->load_param(pd);
+
+    gemm->load_model(ModelBinFromMatArray(0));
+
+    gemm->create_pipeline(opt);
+
+    return 0;
+}
+
+int Einsum_x86::destroy_pipeline(const Option& opt)
+{
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+// sizes and element strides of the blob axes, outermost first
+static void resolve_shape(const Mat& m, int* sizes, size_t* strides)
+{
+    const int dims = m.dims;
+
+    if (dims == 1)
+    {
+        sizes[0] = m.w;
+    }
+    if (dims == 2)
+    {
+        sizes[0] = m.h;
+        sizes[1] = m.w;
+    }
+    if (dims == 3)
+    {
+        sizes[0] = m.c;
+        sizes[1] = m.h;
+        sizes[2] = m.w;
+    }
+    if (dims == 4)
+    {
+        sizes[0] = m.c;
+        sizes[1] = m.d;
+        sizes[2] = m.h;
+        sizes[3] = m.w;
+    }
+
+    strides[dims - 1] = 1;
+    for (int i = dims - 2; i >= 0; i--)
+    {
+        strides[i] = strides[i + 1] * sizes[i + 1];
+    }
+    if (dims >= 3)
+    {
+        strides[0] = m.cstep;
+    }
+}
+
+// the stride of each letter of order, 0 when the letter is absent
+static void resolve_letter_strides(const std::string& token, const size_t* strides, const std::string& order, size_t* letter_strides)
+{
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        letter_strides[i] = 0;
+        for (size_t j = 0; j < token.size(); j++)
+        {
+            if (token[j] == order[i])
+                letter_strides[i] = strides[j];
+        }
+    }
+}
+
+// copy between two strided layouts of up to four axes, the innermost one last
+static void einsum_permute(const float* ptr, const size_t* strides, float* outptr, const size_t* out_strides, const int* sizes, int naxes, const Option& opt)
+{
+    int n[4];
+    size_t s[4];
+    size_t os[4];
+    for (int i = 0; i < 4; i++)
+    {
+        const int a = naxes - 4 + i;
+        n[i] = a >= 0 ? sizes[a] : 1;
+        s[i] = a >= 0 ? strides[a] : 0;
+        os[i] = a >= 0 ? out_strides[a] : 0;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i0 = 0; i0 < n[0]; i0++)
+    {
+        for (int i1 = 0; i1 < n[1]; i1++)
+        {
+            for (int i2 = 0; i2 < n[2]; i2++)
+            {
+                const float* p = ptr + i0 * s[0] + i1 * s[1] + i2 * s[2];
+                float* outp = outptr + i0 * os[0] + i1 * os[1] + i2 * os[2];
+
+                if (s[3] == 1 && os[3] == 1)
+                {
+                    memcpy(outp, p, n[3] * sizeof(float));
+                    continue;
+                }
+
+                for (int i3 = 0; i3 < n[3]; i3++)
+                {
+                    outp[i3 * os[3]] = p[i3 * s[3]];
+                }
+            }
+        }
+    }
+}
+
+// whether the last tail axes are densely packed in memory
+static bool is_contiguous_tail(const std::string& token, const int* sizes, const size_t* strides, int tail)
+{
+    const int dims = (int)token.size();
+    size_t expected = 1;
+    for (int i = dims - 1; i >= dims - tail; i--)
+    {
+        if (strides[i] != expected)
+            return false;
+
+        expected *= sizes[i];
+    }
+
+    return true;
+}
+
+int Einsum_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    if (!gemm_lowering)
+        return Einsum::forward(bottom_blobs, top_blobs, opt);
+
+    const Mat& A = bottom_blobs[0];
+    const Mat& B = bottom_blobs[1];
+    Mat& top_blob = top_blobs[0];
+
+    const size_t elemsize = A.elemsize;
+
+    const std::string& a_token = lhs_tokens[0];
+    const std::string& b_token = lhs_tokens[1];
+
+    int a_sizes[4];
+    size_t a_strides[4];
+    resolve_shape(A, a_sizes, a_strides);
+
+    int b_sizes[4];
+    size_t b_strides[4];
+    resolve_shape(B, b_sizes, b_strides);
+
+    // letter -> size
+    int dim_sizes[16];
+    for (int i = 0; i < 16; i++)
+    {
+        dim_sizes[i] = 1;
+    }
+    for (size_t i = 0; i < a_token.size(); i++)
+    {
+        dim_sizes[a_token[i] - 'i'] = a_sizes[i];
+    }
+    for (size_t i = 0; i < b_token.size(); i++)
+    {
+        dim_sizes[b_token[i] - 'i'] = b_sizes[i];
+    }
+
+    int batch = 1;
+    int M = 1;
+    int N = 1;
+    int K = 1;
+    for (size_t i = 0; i < batch_token.size(); i++)
+        batch *= dim_sizes[batch_token[i] - 'i'];
+    for (size_t i = 0; i < m_token.size(); i++)
+        M *= dim_sizes[m_token[i] - 'i'];
+    for (size_t i = 0; i < n_token.size(); i++)
+        N *= dim_sizes[n_token[i] - 'i'];
+    for (size_t i = 0; i < k_token.size(); i++)
+        K *= dim_sizes[k_token[i] - 'i'];
+
+    const int out_dims = (int)rhs_token.size();
+    if (out_dims == 1)
+        top_blob.create(dim_sizes[rhs_token[0] - 'i'], elemsize, opt.blob_allocator);
+    if (out_dims == 2)
+        top_blob.create(dim_sizes[rhs_token[1] - 'i'], dim_sizes[rhs_token[0] - 'i'], elemsize, opt.blob_allocator);
+    if (out_dims == 3)
+        top_blob.create(dim_sizes[rhs_token[2] - 'i'], dim_sizes[rhs_token[1] - 'i'], dim_sizes[rhs_token[0] - 'i'], elemsize, opt.blob_allocator);
+    if (out_dims == 4)
+        top_blob.create(dim_sizes[rhs_token[3] - 'i'], dim_sizes[rhs_token[2] - 'i'], dim_sizes[rhs_token[1] - 'i'], dim_sizes[rhs_token[0] - 'i'], elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int out_sizes[4];
+    size_t out_strides[4];
+    resolve_shape(top_blob, out_sizes, out_strides);
+
+    const int batch_dims = (int)batch_token.size();
+
+    // gemm reads the operands in place when the per batch matrix is a contiguous tail
+    // otherwise the operand is gathered into the gemm layout in workspace
+    const bool a_direct = a_token == gemm_a_token && is_contiguous_tail(a_token, a_sizes, a_strides, (int)a_token.size() - batch_dims);
+    const bool b_direct = b_token == gemm_b_token && is_contiguous_tail(b_token, b_sizes, b_strides, (int)b_token.size() - batch_dims);
+    const bool out_direct = rhs_token == gemm_out_token && is_contiguous_tail(rhs_token, out_sizes, out_strides, out_dims - batch_dims);
+
+    Mat A_gathered;
+    if (!a_direct)
+    {
+        A_gathered.create(K * M * batch, elemsize, opt.workspace_allocator);
+        if (A_gathered.empty())
+            return -100;
+
+        int sizes[4];
+        size_t strides[4];
+        size_t gathered_strides[4];
+        const int naxes = (int)gemm_a_token.size();
+        resolve_letter_strides(a_token, a_strides, gemm_a_token, strides);
+        gathered_strides[naxes - 1] = 1;
+        for (int i = naxes - 1; i >= 0; i--)
+        {
+            sizes[i] = dim_sizes[gemm_a_token[i] - 'i'];
+            if (i > 0) gathered_strides[i - 1] = gathered_strides[i] * sizes[i];
+        }
+
+        einsum_permute(A, strides, A_gathered, gathered_strides, sizes, naxes, opt);
+    }
+
+    Mat B_gathered;
+    if (!b_direct)
+    {
+        B_gathered.create(N * K * batch, elemsize, opt.workspace_allocator);
+        if (B_gathered.empty())
+            return -100;
+
+        int sizes[4];
+        size_t strides[4];
+        size_t gathered_strides[4];
+        const int naxes = (int)gemm_b_token.size();
+        resolve_letter_strides(b_token, b_strides, gemm_b_token, strides);
+        gathered_strides[naxes - 1] = 1;
+        for (int i = naxes - 1; i >= 0; i--)
+        {
+            sizes[i] = dim_sizes[gemm_b_token[i] - 'i'];
+            if (i > 0) gathered_strides[i - 1] = gathered_strides[i] * sizes[i];
+        }
+
+        einsum_permute(B, strides, B_gathered, gathered_strides, sizes, naxes, opt);
+    }
+
+    Mat out_gemm;
+    if (!out_direct)
+    {
+        out_gemm.create(N * M * batch, elemsize, opt.workspace_allocator);
+        if (out_gemm.empty())
+            return -100;
+    }
+
+    Option opt_gemm = opt;
+    if (!out_direct)
+        opt_gemm.blob_allocator = opt.workspace_allocator;
+
+    // batch letter strides in the operands and the output
+    size_t a_batch_strides[4];
+    size_t b_batch_strides[4];
+    size_t out_batch_strides[4];
+    resolve_letter_strides(a_token, a_strides, batch_token, a_batch_strides);
+    resolve_letter_strides(b_token, b_strides, batch_token, b_batch_strides);
+    resolve_letter_strides(rhs_token, out_strides, batch_token, out_batch_strides);
+
+    for (int p = 0; p < batch; p++)
+    {
+        const float* ptrA = a_direct ? (const float*)A : (const float*)A_gathered + (size_t)M * K * p;
+        const float* ptrB = b_direct ? (const float*)B : (const float*)B_gathered + (size_t)K * N * p;
+        float* outptr = out_direct ? (float*)top_blob : (float*)out_gemm + (size_t)M * N * p;
+
+        // batch coordinates, the last batch letter is the fastest
+        int q = p;
+        for (int i = batch_dims - 1; i >= 0; i--)
+        {
+            const int size = dim_sizes[batch_token[i] - 'i'];
+            const int x = q % size;
+            q /= size;
+
+            if (a_direct) ptrA += x * a_batch_strides[i];
+            if (b_direct) ptrB += x * b_batch_strides[i];
+            if (out_direct) outptr += x * out_batch_strides[i];
+        }
+
+        std::vector<Mat> _bottom_blobs(2);
+        _bottom_blobs[0] = gemm_transA ? Mat(M, K, (void*)ptrA, elemsize) : Mat(K, M, (void*)ptrA, elemsize);
+        _bottom_blobs[1] = gemm_transB ? Mat(K, N, (void*)ptrB, elemsize) : Mat(N, K, (void*)ptrB, elemsize);
+        std::vector<Mat> _top_blobs(1);
+        _top_blobs[0] = gemm_output_transpose ? Mat(M, N, outptr, elemsize, opt_gemm.blob_allocator) : Mat(N, M, outptr, elemsize, opt_gemm.blob_allocator);
+
+        int ret = gemm->forward(_bottom_blobs, _top_blobs, opt_gemm);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (!out_direct)
+    {
+        // scatter the gemm output into the rhs layout
+        int sizes[4];
+        size_t strides[4];
+        size_t gemm_strides[4];
+        const int naxes = (int)gemm_out_token.size();
+        resolve_letter_strides(rhs_token, out_strides, gemm_out_token, strides);
+        gemm_strides[naxes - 1] = 1;
+        for (int i = naxes - 1; i >= 0; i--)
+        {
+            sizes[i] = dim_sizes[gemm_out_token[i] - 'i'];
+            if (i > 0) gemm_strides[i - 1] = gemm_strides[i] * sizes[i];
+        }
+
+        einsum_permute(out_gemm, gemm_strides, top_blob, strides, sizes, naxes, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
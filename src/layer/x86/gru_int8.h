@@ -0,0 +1,484 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+void gru_transform_weight_int8_avx512vnni(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_xc_tm, Mat& weight_hc_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt);
+float gru_dynamic_quantize_avx512vnni(const float* ptr, int size, signed char* outptr, int outsize);
+void gru_int8_gemm_avx512vnni(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+void gru_transform_weight_int8_avxvnni(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_xc_tm, Mat& weight_hc_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt);
+float gru_dynamic_quantize_avxvnni(const float* ptr, int size, signed char* outptr, int outsize);
+void gru_int8_gemm_avxvnni(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void gru_transform_weight_int8_avx2(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_xc_tm, Mat& weight_hc_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt);
+void gru_int8_gemm_avx2(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt);
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_XOP && __SSE2__ && !__XOP__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+void gru_int8_gemm_xop(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt);
+#endif
+
+// gate rows R U N are packed in blocks of elempack rows
+// every 4 consecutive k of a row stay together, so that one 32bit lane takes a 4-way int8 dot product
+static void gru_transform_weight_int8_block(const Mat& weight, int r0, int num_rows, int K, int K4, int elempack, signed char* kptr)
+{
+    for (int k = 0; k < K4; k += 4)
+    {
+        for (int j = 0; j < elempack; j++)
+        {
+            const int r = r0 + j;
+            const signed char* wptr = weight.row<const signed char>(std::min(r, num_rows - 1));
+
+            for (int l = 0; l < 4; l++)
+            {
+                kptr[l] = r < num_rows && k + l < K ? wptr[k + l] : 0;
+            }
+
+            kptr += 4;
+        }
+    }
+
+#if __AVXVNNI__ || __AVX512VNNI__
+    // the inputs are shifted by 127 to unsigned for vpdpbusd, keep 127 * sum(w) to take it back
+    int* w_shift = (int*)kptr;
+    for (int j = 0; j < elempack; j++)
+    {
+        const int r = r0 + j;
+
+        int sum = 0;
+        if (r < num_rows)
+        {
+            const signed char* wptr = weight.row<const signed char>(r);
+            for (int k = 0; k < K; k++)
+            {
+                sum += wptr[k];
+            }
+        }
+
+        w_shift[j] = sum * 127;
+    }
+#endif // __AVXVNNI__ || __AVX512VNNI__
+}
+
+static void gru_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_xc_tm, Mat& weight_hc_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        gru_transform_weight_int8_avx512vnni(weight_xc, weight_xc_int8_scales, weight_hc, weight_hc_int8_scales, bias_c, weight_xc_tm, weight_hc_tm, weight_data_tm_int8_descales, bias_c_tm, size, num_output, num_directions, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        gru_transform_weight_int8_avxvnni(weight_xc, weight_xc_int8_scales, weight_hc, weight_hc_int8_scales, bias_c, weight_xc_tm, weight_hc_tm, weight_data_tm_int8_descales, bias_c_tm, size, num_output, num_directions, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        gru_transform_weight_int8_avx2(weight_xc, weight_xc_int8_scales, weight_hc, weight_hc_int8_scales, bias_c, weight_xc_tm, weight_hc_tm, weight_data_tm_int8_descales, bias_c_tm, size, num_output, num_directions, opt);
+        return;
+    }
+#endif
+
+#if __AVX512F__
+    const int elempack = 16;
+#elif __AVX2__
+    const int elempack = 8;
+#else
+    const int elempack = 4;
+#endif
+
+#if __AVXVNNI__ || __AVX512VNNI__
+    const int w_shift_size = elempack * 4;
+#else
+    const int w_shift_size = 0;
+#endif
+
+    const int num_rows = num_output * 3;
+    const int nn_rows = (num_rows + elempack - 1) / elempack;
+
+    const int size4 = (size + 3) / 4 * 4;
+    const int num_output4 = (num_output + 3) / 4 * 4;
+
+    weight_xc_tm.create(size4 * elempack + w_shift_size, nn_rows, num_directions, 1u, 1);
+    weight_hc_tm.create(num_output4 * elempack + w_shift_size, nn_rows, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(nn_rows * elempack, 2, num_directions);
+    bias_c_tm.create(nn_rows * elempack, num_directions);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const Mat bias_c_dr = bias_c.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_xc_tm_dr = weight_xc_tm.channel(dr);
+        Mat weight_hc_tm_dr = weight_hc_tm.channel(dr);
+        float* descales_xc = weight_data_tm_int8_descales.channel(dr).row(0);
+        float* descales_hc = weight_data_tm_int8_descales.channel(dr).row(1);
+        float* bias_c_RUN = bias_c_tm.row(dr);
+
+        for (int i = 0; i < nn_rows; i++)
+        {
+            gru_transform_weight_int8_block(weight_xc_dr, i * elempack, num_rows, size, size4, elempack, weight_xc_tm_dr.row<signed char>(i));
+            gru_transform_weight_int8_block(weight_hc_dr, i * elempack, num_rows, num_output, num_output4, elempack, weight_hc_tm_dr.row<signed char>(i));
+        }
+
+        for (int r = 0; r < nn_rows * elempack; r++)
+        {
+            descales_xc[r] = r < num_rows ? 1.f / weight_xc_int8_scales_ptr[r] : 0.f;
+            descales_hc[r] = r < num_rows ? 1.f / weight_hc_int8_scales_ptr[r] : 0.f;
+
+            // input side bias of gate R U N, the hidden side bias of gate N is applied after reset
+            bias_c_RUN[r] = r < num_rows ? bias_c_dr.row(r / num_output)[r % num_output] : 0.f;
+        }
+    }
+}
+
+static float gru_dynamic_quantize_get_absmax(const float* ptr, int size)
+{
+    float absmax = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _absmax_avx512 = _mm512_set1_ps(0.f);
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = _mm512_loadu_ps(ptr);
+        _absmax_avx512 = _mm512_max_ps(_absmax_avx512, abs512_ps(_p));
+        ptr += 16;
+    }
+    absmax = std::max(absmax, _mm512_comp_reduce_max_ps(_absmax_avx512));
+#endif // __AVX512F__
+    __m256 _absmax_avx = _mm256_set1_ps(0.f);
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = _mm256_loadu_ps(ptr);
+        _absmax_avx = _mm256_max_ps(_absmax_avx, abs256_ps(_p));
+        ptr += 8;
+    }
+    absmax = std::max(absmax, _mm256_reduce_max_ps(_absmax_avx));
+#endif // __AVX__
+    __m128 _absmax = _mm_set1_ps(0.f);
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _absmax = _mm_max_ps(_absmax, abs_ps(_p));
+        ptr += 4;
+    }
+    absmax = std::max(absmax, _mm_reduce_max_ps(_absmax));
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(*ptr));
+        ptr++;
+    }
+
+    return absmax;
+}
+
+// quantize size floats to int8 and zero pad to outsize, return the descale
+static float gru_dynamic_quantize(const float* ptr, int size, signed char* outptr, int outsize)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        return gru_dynamic_quantize_avx512vnni(ptr, size, outptr, outsize);
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        return gru_dynamic_quantize_avxvnni(ptr, size, outptr, outsize);
+    }
+#endif
+
+    const float absmax = gru_dynamic_quantize_get_absmax(ptr, size);
+
+    // all zero hidden state at the first step
+    const float scale = absmax == 0.f ? 1.f : 127.f / absmax;
+    const float descale = absmax == 0.f ? 1.f : absmax / 127.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _scale_avx512 = _mm512_set1_ps(scale);
+#if __AVX512VNNI__
+    __m128i _v127 = _mm_set1_epi8(127);
+#endif
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = _mm512_loadu_ps(ptr);
+        _p = _mm512_mul_ps(_p, _scale_avx512);
+        __m128i _outp = float2int8_avx512(_p);
+#if __AVX512VNNI__
+        _outp = _mm_add_epi8(_outp, _v127);
+#endif
+        _mm_storeu_si128((__m128i*)outptr, _outp);
+        ptr += 16;
+        outptr += 16;
+    }
+#endif // __AVX512F__
+    __m256 _scale_avx = _mm256_set1_ps(scale);
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = _mm256_loadu_ps(ptr);
+        _p = _mm256_mul_ps(_p, _scale_avx);
+        *(int64_t*)outptr = float2int8_avx(_p);
+#if __AVXVNNI__ || __AVX512VNNI__
+        for (int j = 0; j < 8; j++)
+        {
+            outptr[j] += 127;
+        }
+#endif
+        ptr += 8;
+        outptr += 8;
+    }
+#endif // __AVX__
+    __m128 _scale = _mm_set1_ps(scale);
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _p = _mm_mul_ps(_p, _scale);
+        *(int32_t*)outptr = float2int8_sse(_p);
+#if __AVXVNNI__ || __AVX512VNNI__
+        for (int j = 0; j < 4; j++)
+        {
+            outptr[j] += 127;
+        }
+#endif
+        ptr += 4;
+        outptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+#if __AVXVNNI__ || __AVX512VNNI__
+        *outptr++ = float2int8(*ptr++ * scale) + 127;
+#else
+        *outptr++ = float2int8(*ptr++ * scale);
+#endif
+    }
+    for (; i < outsize; i++)
+    {
+        *outptr++ = 0;
+    }
+
+    return descale;
+}
+
+// top_blob row i = (bottom_blob_int8 row i dot weight rows) * descales + bias
+// one gemm for the input projection of all timesteps, or one gemv for the hidden projection per step
+static void gru_int8_gemm(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt)
+{
+#if NCNN_RUNTIME_CPU && NCNN_AVX512VNNI && __AVX512F__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx512_vnni())
+    {
+        gru_int8_gemm_avx512vnni(bottom_blob_int8, bottom_blob_int8_descales, weight_tm, weight_tm_int8_descales, bias, top_blob, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVXVNNI && __AVX__ && !__AVX512F__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx_vnni())
+    {
+        gru_int8_gemm_avxvnni(bottom_blob_int8, bottom_blob_int8_descales, weight_tm, weight_tm_int8_descales, bias, top_blob, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_AVX2 && __AVX__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_avx2())
+    {
+        gru_int8_gemm_avx2(bottom_blob_int8, bottom_blob_int8_descales, weight_tm, weight_tm_int8_descales, bias, top_blob, opt);
+        return;
+    }
+#endif
+
+#if NCNN_RUNTIME_CPU && NCNN_XOP && __SSE2__ && !__XOP__ && !__AVX2__ && !__AVXVNNI__ && !__AVX512VNNI__
+    if (ncnn::cpu_support_x86_xop())
+    {
+        gru_int8_gemm_xop(bottom_blob_int8, bottom_blob_int8_descales, weight_tm, weight_tm_int8_descales, bias, top_blob, opt);
+        return;
+    }
+#endif
+
+#if __AVX512F__
+    const int elempack = 16;
+#elif __AVX2__
+    const int elempack = 8;
+#else
+    const int elempack = 4;
+#endif
+
+    const int K = bottom_blob_int8.w / 4;
+    const int rows = bottom_blob_int8.h;
+    const int nn_rows = weight_tm.h;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ij = 0; ij < rows * nn_rows; ij++)
+    {
+        const int i = ij / nn_rows;
+        const int j = ij % nn_rows;
+
+        // 4 int8 per int
+        const int* x = bottom_blob_int8.row<const int>(i);
+        const signed char* kptr = weight_tm.row<const signed char>(j);
+
+        const float descale_x = bottom_blob_int8_descales[i];
+        const float* descales = weight_tm_int8_descales + j * elempack;
+        const float* biasptr = bias ? bias + j * elempack : 0;
+        float* outptr = top_blob.row(i) + j * elempack;
+
+#if __AVX512F__
+        __m512i _sum0 = _mm512_setzero_si512();
+        __m512i _sum1 = _mm512_setzero_si512();
+#if __AVX512VNNI__
+        int k = 0;
+        for (; k + 1 < K; k += 2)
+        {
+            _sum0 = _mm512_dpbusd_epi32(_sum0, _mm512_set1_epi32(x[k]), _mm512_loadu_si512((const __m512i*)kptr));
+            _sum1 = _mm512_dpbusd_epi32(_sum1, _mm512_set1_epi32(x[k + 1]), _mm512_loadu_si512((const __m512i*)(kptr + 64)));
+            kptr += 128;
+        }
+        for (; k < K; k++)
+        {
+            _sum0 = _mm512_dpbusd_epi32(_sum0, _mm512_set1_epi32(x[k]), _mm512_loadu_si512((const __m512i*)kptr));
+            kptr += 64;
+        }
+        _sum0 = _mm512_add_epi32(_sum0, _sum1);
+
+        __m512i _w_shift = _mm512_loadu_si512((const __m512i*)kptr);
+        _sum0 = _mm512_sub_epi32(_sum0, _w_shift);
+#else  // __AVX512VNNI__
+        for (int k = 0; k < K; k++)
+        {
+            __m512i _x = _mm512_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(x[k])));
+            __m512i _w = _mm512_loadu_si512((const __m512i*)kptr);
+            __m512i _w0 = _mm512_cvtepi8_epi16(_mm512_castsi512_si256(_w));
+            __m512i _w1 = _mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64(_w, 1));
+            _sum0 = _mm512_comp_dpwssd_epi32(_sum0, _w0, _x);
+            _sum1 = _mm512_comp_dpwssd_epi32(_sum1, _w1, _x);
+            kptr += 64;
+        }
+
+        // each row has two partial sums in a 64bit lane
+        _sum0 = _mm512_add_epi32(_sum0, _mm512_srli_epi64(_sum0, 32));
+        _sum1 = _mm512_add_epi32(_sum1, _mm512_srli_epi64(_sum1, 32));
+        _sum0 = _mm512_permutex2var_epi32(_sum0, _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), _sum1);
+#endif // __AVX512VNNI__
+
+        __m512 _out = _mm512_mul_ps(_mm512_cvtepi32_ps(_sum0), _mm512_mul_ps(_mm512_loadu_ps(descales), _mm512_set1_ps(descale_x)));
+        if (biasptr)
+            _out = _mm512_add_ps(_out, _mm512_loadu_ps(biasptr));
+        _mm512_storeu_ps(outptr, _out);
+#elif __AVX2__
+        __m256i _sum0 = _mm256_setzero_si256();
+        __m256i _sum1 = _mm256_setzero_si256();
+#if __AVXVNNI__
+        int k = 0;
+        for (; k + 1 < K; k += 2)
+        {
+            _sum0 = _mm256_comp_dpbusd_epi32(_sum0, _mm256_set1_epi32(x[k]), _mm256_loadu_si256((const __m256i*)kptr));
+            _sum1 = _mm256_comp_dpbusd_epi32(_sum1, _mm256_set1_epi32(x[k + 1]), _mm256_loadu_si256((const __m256i*)(kptr + 32)));
+            kptr += 64;
+        }
+        for (; k < K; k++)
+        {
+            _sum0 = _mm256_comp_dpbusd_epi32(_sum0, _mm256_set1_epi32(x[k]), _mm256_loadu_si256((const __m256i*)kptr));
+            kptr += 32;
+        }
+        _sum0 = _mm256_add_epi32(_sum0, _sum1);
+
+        __m256i _w_shift = _mm256_loadu_si256((const __m256i*)kptr);
+        _sum0 = _mm256_sub_epi32(_sum0, _w_shift);
+#else  // __AVXVNNI__
+        for (int k = 0; k < K; k++)
+        {
+            __m256i _x = _mm256_broadcastq_epi64(_mm_cvtepi8_epi16(_mm_cvtsi32_si128(x[k])));
+            __m256i _w = _mm256_loadu_si256((const __m256i*)kptr);
+            __m256i _w0 = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(_w));
+            __m256i _w1 = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(_w, 1));
+            _sum0 = _mm256_comp_dpwssd_epi32(_sum0, _w0, _x);
+            _sum1 = _mm256_comp_dpwssd_epi32(_sum1, _w1, _x);
+            kptr += 32;
+        }
+
+        // r0 r1 r4 r5 r2 r3 r6 r7 -> r0 ... r7
+        _sum0 = _mm256_hadd_epi32(_sum0, _sum1);
+        _sum0 = _mm256_permute4x64_epi64(_sum0, _MM_SHUFFLE(3, 1, 2, 0));
+#endif // __AVXVNNI__
+
+        __m256 _out = _mm256_mul_ps(_mm256_cvtepi32_ps(_sum0), _mm256_mul_ps(_mm256_loadu_ps(descales), _mm256_set1_ps(descale_x)));
+        if (biasptr)
+            _out = _mm256_add_ps(_out, _mm256_loadu_ps(biasptr));
+        _mm256_storeu_ps(outptr, _out);
+#elif __SSE2__
+        __m128i _sum0 = _mm_setzero_si128();
+        __m128i _sum1 = _mm_setzero_si128();
+        for (int k = 0; k < K; k++)
+        {
+            __m128i _x = _mm_cvtsi32_si128(x[k]);
+            __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+#if __SSE4_1__
+            _x = _mm_cvtepi8_epi16(_x);
+            __m128i _w0 = _mm_cvtepi8_epi16(_w);
+            __m128i _w1 = _mm_cvtepi8_epi16(_mm_unpackhi_epi64(_w, _w));
+#else
+            _x = _mm_unpacklo_epi8(_x, _mm_cmpgt_epi8(_mm_setzero_si128(), _x));
+            __m128i _w_sign = _mm_cmpgt_epi8(_mm_setzero_si128(), _w);
+            __m128i _w0 = _mm_unpacklo_epi8(_w, _w_sign);
+            __m128i _w1 = _mm_unpackhi_epi8(_w, _w_sign);
+#endif
+            _x = _mm_unpacklo_epi64(_x, _x);
+            _sum0 = _mm_comp_dpwssd_epi32(_sum0, _w0, _x);
+            _sum1 = _mm_comp_dpwssd_epi32(_sum1, _w1, _x);
+            kptr += 16;
+        }
+
+        // r0 r0 r1 r1 + r2 r2 r3 r3 -> r0 r1 r2 r3
+        __m128 _even = _mm_shuffle_ps(_mm_castsi128_ps(_sum0), _mm_castsi128_ps(_sum1), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 _odd = _mm_shuffle_ps(_mm_castsi128_ps(_sum0), _mm_castsi128_ps(_sum1), _MM_SHUFFLE(3, 1, 3, 1));
+        __m128i _sum = _mm_add_epi32(_mm_castps_si128(_even), _mm_castps_si128(_odd));
+
+        __m128 _out = _mm_mul_ps(_mm_cvtepi32_ps(_sum), _mm_mul_ps(_mm_loadu_ps(descales), _mm_set1_ps(descale_x)));
+        if (biasptr)
+            _out = _mm_add_ps(_out, _mm_loadu_ps(biasptr));
+        _mm_storeu_ps(outptr, _out);
+#else  // __SSE2__
+        const signed char* xptr = (const signed char*)x;
+
+        int sum[4] = {0, 0, 0, 0};
+        for (int k = 0; k < K; k++)
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                sum[r] += kptr[0] * xptr[0] + kptr[1] * xptr[1] + kptr[2] * xptr[2] + kptr[3] * xptr[3];
+                kptr += 4;
+            }
+            xptr += 4;
+        }
+
+        for (int r = 0; r < 4; r++)
+        {
+            outptr[r] = sum[r] * (descales[r] * descale_x) + (biasptr ? biasptr[r] : 0.f);
+        }
+#endif // __SSE2__
+    }
+}
@@ -0,0 +1,46 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_GRU_X86_H
+#define LAYER_GRU_X86_H
+
+#include "gru.h"
+
+namespace ncnn {
+
+class GRU_x86 : public GRU
+{
+public:
+    GRU_x86();
+
+    virtual int create_pipeline(const Option& opt);
+    virtual int destroy_pipeline(const Option& opt);
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+
+    virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
+
+protected:
+    int forward_fp32(const Mat& bottom_blob, Mat& top_blob, Mat& hidden, const Option& opt) const;
+#if NCNN_INT8
+    int create_pipeline_int8(const Option& opt);
+    int forward_int8(const Mat& bottom_blob, Mat& top_blob, Mat& hidden, const Option& opt) const;
+#endif
+
+public:
+    // input projection of all timesteps and directions in one gemm
+    Layer* gemm_xc;
+
+    Mat weight_hc_data_packed;
+
+#if NCNN_INT8
+    Mat weight_xc_data_tm;
+    Mat weight_hc_data_tm;
+    Mat weight_data_tm_int8_descales;
+    Mat bias_c_data_packed;
+#endif
+};
+
+} // namespace ncnn
+
+#endif // LAYER_GRU_X86_H
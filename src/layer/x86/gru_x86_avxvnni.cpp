@@ -0,0 +1,29 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "cpu.h"
+#include "mat.h"
+#include "layer.h"
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#include "gru_int8.h"
+
+void gru_transform_weight_int8_avxvnni(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_xc_tm, Mat& weight_hc_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+    gru_transform_weight_int8(weight_xc, weight_xc_int8_scales, weight_hc, weight_hc_int8_scales, bias_c, weight_xc_tm, weight_hc_tm, weight_data_tm_int8_descales, bias_c_tm, size, num_output, num_directions, opt);
+}
+
+float gru_dynamic_quantize_avxvnni(const float* ptr, int size, signed char* outptr, int outsize)
+{
+    return gru_dynamic_quantize(ptr, size, outptr, outsize);
+}
+
+void gru_int8_gemm_avxvnni(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt)
+{
+    gru_int8_gemm(bottom_blob_int8, bottom_blob_int8_descales, weight_tm, weight_tm_int8_descales, bias, top_blob, opt);
+}
+
+} // namespace ncnn
@@ -0,0 +1,19 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "cpu.h"
+#include "mat.h"
+#include "layer.h"
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+#include "gru_int8.h"
+
+void gru_int8_gemm_xop(const Mat& bottom_blob_int8, const float* bottom_blob_int8_descales, const Mat& weight_tm, const float* weight_tm_int8_descales, const float* bias, Mat& top_blob, const Option& opt)
+{
+    gru_int8_gemm(bottom_blob_int8, bottom_blob_int8_descales, weight_tm, weight_tm_int8_descales, bias, top_blob, opt);
+}
+
+} // namespace ncnn
@@ -575,12 +575,12 @@ int LSTM_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
     int num_directions = direction == 2 ? 2 : 1;
 
     // initial hidden state
-    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    Mat hidden(num_output, num_directions, 4u, opt.workspace_allocator);
     if (hidden.empty())
         return -100;
     hidden.fill(0.f);
 
-    Mat cell(hidden_size, 4u, opt.workspace_allocator);
+    Mat cell(hidden_size, num_directions, 4u, opt.workspace_allocator);
     if (cell.empty())
         return -100;
     cell.fill(0.f);
@@ -607,19 +607,45 @@ int LSTM_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         if (top_blob_reverse.empty())
             return -100;
 
-        {
-            int ret = lstm(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden, cell, opt);
-            if (ret != 0)
-                return ret;
-        }
+        Mat hidden0 = hidden.row_range(0, 1);
+        Mat cell0 = cell.row_range(0, 1);
+        Mat hidden1 = hidden.row_range(1, 1);
+        Mat cell1 = cell.row_range(1, 1);
 
-        hidden.fill(0.0f);
-        cell.fill(0.0f);
+        if (opt.num_threads > 1 && hidden_size < 256)
+        {
+            // the two directions are independent and the per timestep fork join dominates small hidden size
+            // run them concurrently on split thread teams
+            Option opt_dr = opt;
+            opt_dr.num_threads = opt.num_threads / 2;
+            // user allocators are not required to be thread-safe
+            opt_dr.workspace_allocator = 0;
+
+            int rets[2];
+            #pragma omp parallel for num_threads(2)
+            for (int dr = 0; dr < 2; dr++)
+            {
+                rets[dr] = lstm(bottom_blob, dr == 0 ? top_blob_forward : top_blob_reverse, dr, weight_xc_data_packed.channel(dr), bias_c_data_packed.channel(dr), weight_hc_data_packed.channel(dr), num_output == hidden_size ? Mat() : weight_hr_data.channel(dr), dr == 0 ? hidden0 : hidden1, dr == 0 ? cell0 : cell1, opt_dr);
+            }
 
+            if (rets[0] != 0)
+                return rets[0];
+            if (rets[1] != 0)
+                return rets[1];
+        }
+        else
         {
-            int ret = lstm(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden, cell, opt);
-            if (ret != 0)
-                return ret;
+            {
+                int ret = lstm(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
+                if (ret != 0)
+                    return ret;
+            }
+
+            {
+                int ret = lstm(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden1, cell1, opt);
+                if (ret != 0)
+                    return ret;
+            }
         }
 
         // concat w
@@ -696,18 +722,43 @@ int LSTM_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
 
         Mat hidden0 = hidden.row_range(0, 1);
         Mat cell0 = cell.row_range(0, 1);
-        {
-            int ret = lstm(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
-            if (ret != 0)
-                return ret;
-        }
-
         Mat hidden1 = hidden.row_range(1, 1);
         Mat cell1 = cell.row_range(1, 1);
+
+        if (opt.num_threads > 1 && hidden_size < 256)
         {
-            int ret = lstm(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden1, cell1, opt);
-            if (ret != 0)
-                return ret;
+            // the two directions are independent and the per timestep fork join dominates small hidden size
+            // run them concurrently on split thread teams
+            Option opt_dr = opt;
+            opt_dr.num_threads = opt.num_threads / 2;
+            // user allocators are not required to be thread-safe
+            opt_dr.workspace_allocator = 0;
+
+            int rets[2];
+            #pragma omp parallel for num_threads(2)
+            for (int dr = 0; dr < 2; dr++)
+            {
+                rets[dr] = lstm(bottom_blob, dr == 0 ? top_blob_forward : top_blob_reverse, dr, weight_xc_data_packed.channel(dr), bias_c_data_packed.channel(dr), weight_hc_data_packed.channel(dr), num_output == hidden_size ? Mat() : weight_hr_data.channel(dr), dr == 0 ? hidden0 : hidden1, dr == 0 ? cell0 : cell1, opt_dr);
+            }
+
+            if (rets[0] != 0)
+                return rets[0];
+            if (rets[1] != 0)
+                return rets[1];
+        }
+        else
+        {
+            {
+                int ret = lstm(bottom_blob, top_blob_forward, 0, weight_xc_data_packed.channel(0), bias_c_data_packed.channel(0), weight_hc_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
+                if (ret != 0)
+                    return ret;
+            }
+
+            {
+                int ret = lstm(bottom_blob, top_blob_reverse, 1, weight_xc_data_packed.channel(1), bias_c_data_packed.channel(1), weight_hc_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden1, cell1, opt);
+                if (ret != 0)
+                    return ret;
+            }
         }
 
         // concat w
@@ -784,12 +835,12 @@ int LSTM_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option&
     int num_directions = direction == 2 ? 2 : 1;
 
     // initial hidden state
-    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    Mat hidden(num_output, num_directions, 4u, opt.workspace_allocator);
     if (hidden.empty())
         return -100;
     hidden.fill(0.f);
 
-    Mat cell(hidden_size, 4u, opt.workspace_allocator);
+    Mat cell(hidden_size, num_directions, 4u, opt.workspace_allocator);
     if (cell.empty())
         return -100;
     cell.fill(0.f);
@@ -824,15 +875,30 @@ int LSTM_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option&
         if (top_blob_reverse.empty())
             return -100;
 
+        Mat hidden0 = hidden.row_range(0, 1);
+        Mat cell0 = cell.row_range(0, 1);
+        Mat hidden1 = hidden.row_range(1, 1);
+        Mat cell1 = cell.row_range(1, 1);
+
+        if (opt.num_threads > 1 && hidden_size < 256)
         {
-            lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden, cell, opt);
+            // the two directions are independent and the per timestep fork join dominates small hidden size
+            // run them concurrently on split thread teams
+            Option opt_dr = opt;
+            opt_dr.num_threads = opt.num_threads / 2;
+            // user allocators are not required to be thread-safe
+            opt_dr.workspace_allocator = 0;
+
+            #pragma omp parallel for num_threads(2)
+            for (int dr = 0; dr < 2; dr++)
+            {
+                lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, dr == 0 ? top_blob_forward : top_blob_reverse, dr, weight_data_tm.channel(dr), weight_data_tm_int8_descales.channel(dr), bias_c_data_packed.channel(dr), num_output == hidden_size ? Mat() : weight_hr_data.channel(dr), dr == 0 ? hidden0 : hidden1, dr == 0 ? cell0 : cell1, opt_dr);
+            }
         }
-
-        hidden.fill(0.f);
-        cell.fill(0.0f);
-
+        else
         {
-            lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden, cell, opt);
+            lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
+            lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden1, cell1, opt);
         }
 
         // concat w
@@ -911,13 +977,27 @@ int LSTM_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat
 
         Mat hidden0 = hidden.row_range(0, 1);
         Mat cell0 = cell.row_range(0, 1);
-        {
-            lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
-        }
-
         Mat hidden1 = hidden.row_range(1, 1);
         Mat cell1 = cell.row_range(1, 1);
+
+        if (opt.num_threads > 1 && hidden_size < 256)
+        {
+            // the two directions are independent and the per timestep fork join dominates small hidden size
+            // run them concurrently on split thread teams
+            Option opt_dr = opt;
+            opt_dr.num_threads = opt.num_threads / 2;
+            // user allocators are not required to be thread-safe
+            opt_dr.workspace_allocator = 0;
+
+            #pragma omp parallel for num_threads(2)
+            for (int dr = 0; dr < 2; dr++)
+            {
+                lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, dr == 0 ? top_blob_forward : top_blob_reverse, dr, weight_data_tm.channel(dr), weight_data_tm_int8_descales.channel(dr), bias_c_data_packed.channel(dr), num_output == hidden_size ? Mat() : weight_hr_data.channel(dr), dr == 0 ? hidden0 : hidden1, dr == 0 ? cell0 : cell1, opt_dr);
+            }
+        }
+        else
         {
+            lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), num_output == hidden_size ? Mat() : weight_hr_data.channel(0), hidden0, cell0, opt);
             lstm_int8(bottom_blob_int8, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), num_output == hidden_size ? Mat() : weight_hr_data.channel(1), hidden1, cell1, opt);
         }
 
@@ -3,6 +3,22 @@
 
 #include "multiheadattention_x86.h"
 
+#include <float.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
@@ -300,12 +316,501 @@ int MultiHeadAttention_x86::destroy_pipeline(const Option& _opt)
     return 0;
 }
 
+// the cache keeps the projected k or v of all positions, one row per channel and one column per position
+static int concat_kv_cache(const Mat& cache_blob, const Mat& affine, Mat& out_cache_blob, const Option& opt)
+{
+    if (cache_blob.empty())
+    {
+        out_cache_blob = affine;
+        return 0;
+    }
+
+    Mat cache_blob_unpacked = cache_blob;
+    if (cache_blob.elempack != 1)
+    {
+        Option opt_pack = opt;
+        opt_pack.blob_allocator = opt.workspace_allocator;
+
+        convert_packing(cache_blob, cache_blob_unpacked, 1, opt_pack);
+        if (cache_blob_unpacked.empty())
+            return -100;
+    }
+
+    const int past_seqlen = cache_blob_unpacked.w;
+    const int cur_seqlen = affine.w;
+    const size_t elemsize = affine.elemsize;
+
+    out_cache_blob.create(past_seqlen + cur_seqlen, affine.h, elemsize, opt.blob_allocator);
+    if (out_cache_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < affine.h; i++)
+    {
+        unsigned char* outptr = out_cache_blob.row<unsigned char>(i);
+
+        memcpy(outptr, cache_blob_unpacked.row<const unsigned char>(i), past_seqlen * elemsize);
+        memcpy(outptr + past_seqlen * elemsize, affine.row<const unsigned char>(i), cur_seqlen * elemsize);
+    }
+
+    return 0;
+}
+
+// outptr[r * 16 + ii] = outptr[r * 16 + ii] * scale[ii] + sum_t a[r * a_step + t * a_stride] * b[t * 16 + ii] for r in 0..8
+// outptr starts from zero when scale is null
+static void attention_dot16_8(const float* a, int a_stride, int a_step, const float* b, int n, const float* scale, float* outptr)
+{
+    const float* a0 = a;
+    const float* a1 = a + a_step;
+    const float* a2 = a + a_step * 2;
+    const float* a3 = a + a_step * 3;
+    const float* a4 = a + a_step * 4;
+    const float* a5 = a + a_step * 5;
+    const float* a6 = a + a_step * 6;
+    const float* a7 = a + a_step * 7;
+
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 15 < 16; ii += 16)
+    {
+        __m512 _sum0 = _mm512_setzero_ps();
+        __m512 _sum1 = _mm512_setzero_ps();
+        __m512 _sum2 = _mm512_setzero_ps();
+        __m512 _sum3 = _mm512_setzero_ps();
+        __m512 _sum4 = _mm512_setzero_ps();
+        __m512 _sum5 = _mm512_setzero_ps();
+        __m512 _sum6 = _mm512_setzero_ps();
+        __m512 _sum7 = _mm512_setzero_ps();
+        if (scale)
+        {
+            __m512 _scale = _mm512_loadu_ps(scale + ii);
+            _sum0 = _mm512_mul_ps(_mm512_loadu_ps(outptr + ii), _scale);
+            _sum1 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 16 + ii), _scale);
+            _sum2 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 32 + ii), _scale);
+            _sum3 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 48 + ii), _scale);
+            _sum4 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 64 + ii), _scale);
+            _sum5 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 80 + ii), _scale);
+            _sum6 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 96 + ii), _scale);
+            _sum7 = _mm512_mul_ps(_mm512_loadu_ps(outptr + 112 + ii), _scale);
+        }
+        for (int t = 0; t < n; t++)
+        {
+            __m512 _b = _mm512_loadu_ps(b + t * 16 + ii);
+            _sum0 = _mm512_fmadd_ps(_mm512_set1_ps(a0[t * a_stride]), _b, _sum0);
+            _sum1 = _mm512_fmadd_ps(_mm512_set1_ps(a1[t * a_stride]), _b, _sum1);
+            _sum2 = _mm512_fmadd_ps(_mm512_set1_ps(a2[t * a_stride]), _b, _sum2);
+            _sum3 = _mm512_fmadd_ps(_mm512_set1_ps(a3[t * a_stride]), _b, _sum3);
+            _sum4 = _mm512_fmadd_ps(_mm512_set1_ps(a4[t * a_stride]), _b, _sum4);
+            _sum5 = _mm512_fmadd_ps(_mm512_set1_ps(a5[t * a_stride]), _b, _sum5);
+            _sum6 = _mm512_fmadd_ps(_mm512_set1_ps(a6[t * a_stride]), _b, _sum6);
+            _sum7 = _mm512_fmadd_ps(_mm512_set1_ps(a7[t * a_stride]), _b, _sum7);
+        }
+        _mm512_storeu_ps(outptr + ii, _sum0);
+        _mm512_storeu_ps(outptr + 16 + ii, _sum1);
+        _mm512_storeu_ps(outptr + 32 + ii, _sum2);
+        _mm512_storeu_ps(outptr + 48 + ii, _sum3);
+        _mm512_storeu_ps(outptr + 64 + ii, _sum4);
+        _mm512_storeu_ps(outptr + 80 + ii, _sum5);
+        _mm512_storeu_ps(outptr + 96 + ii, _sum6);
+        _mm512_storeu_ps(outptr + 112 + ii, _sum7);
+    }
+#endif // __AVX512F__
+    for (; ii + 7 < 16; ii += 8)
+    {
+        __m256 _sum0 = _mm256_setzero_ps();
+        __m256 _sum1 = _mm256_setzero_ps();
+        __m256 _sum2 = _mm256_setzero_ps();
+        __m256 _sum3 = _mm256_setzero_ps();
+        __m256 _sum4 = _mm256_setzero_ps();
+        __m256 _sum5 = _mm256_setzero_ps();
+        __m256 _sum6 = _mm256_setzero_ps();
+        __m256 _sum7 = _mm256_setzero_ps();
+        if (scale)
+        {
+            __m256 _scale = _mm256_loadu_ps(scale + ii);
+            _sum0 = _mm256_mul_ps(_mm256_loadu_ps(outptr + ii), _scale);
+            _sum1 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 16 + ii), _scale);
+            _sum2 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 32 + ii), _scale);
+            _sum3 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 48 + ii), _scale);
+            _sum4 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 64 + ii), _scale);
+            _sum5 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 80 + ii), _scale);
+            _sum6 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 96 + ii), _scale);
+            _sum7 = _mm256_mul_ps(_mm256_loadu_ps(outptr + 112 + ii), _scale);
+        }
+        for (int t = 0; t < n; t++)
+        {
+            __m256 _b = _mm256_loadu_ps(b + t * 16 + ii);
+            _sum0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a0[t * a_stride]), _b, _sum0);
+            _sum1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a1[t * a_stride]), _b, _sum1);
+            _sum2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a2[t * a_stride]), _b, _sum2);
+            _sum3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a3[t * a_stride]), _b, _sum3);
+            _sum4 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a4[t * a_stride]), _b, _sum4);
+            _sum5 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a5[t * a_stride]), _b, _sum5);
+            _sum6 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a6[t * a_stride]), _b, _sum6);
+            _sum7 = _mm256_comp_fmadd_ps(_mm256_set1_ps(a7[t * a_stride]), _b, _sum7);
+        }
+        _mm256_storeu_ps(outptr + ii, _sum0);
+        _mm256_storeu_ps(outptr + 16 + ii, _sum1);
+        _mm256_storeu_ps(outptr + 32 + ii, _sum2);
+        _mm256_storeu_ps(outptr + 48 + ii, _sum3);
+        _mm256_storeu_ps(outptr + 64 + ii, _sum4);
+        _mm256_storeu_ps(outptr + 80 + ii, _sum5);
+        _mm256_storeu_ps(outptr + 96 + ii, _sum6);
+        _mm256_storeu_ps(outptr + 112 + ii, _sum7);
+    }
+#endif // __AVX__
+    for (; ii + 3 < 16; ii += 4)
+    {
+        __m128 _sum0 = _mm_setzero_ps();
+        __m128 _sum1 = _mm_setzero_ps();
+        __m128 _sum2 = _mm_setzero_ps();
+        __m128 _sum3 = _mm_setzero_ps();
+        __m128 _sum4 = _mm_setzero_ps();
+        __m128 _sum5 = _mm_setzero_ps();
+        __m128 _sum6 = _mm_setzero_ps();
+        __m128 _sum7 = _mm_setzero_ps();
+        if (scale)
+        {
+            __m128 _scale = _mm_loadu_ps(scale + ii);
+            _sum0 = _mm_mul_ps(_mm_loadu_ps(outptr + ii), _scale);
+            _sum1 = _mm_mul_ps(_mm_loadu_ps(outptr + 16 + ii), _scale);
+            _sum2 = _mm_mul_ps(_mm_loadu_ps(outptr + 32 + ii), _scale);
+            _sum3 = _mm_mul_ps(_mm_loadu_ps(outptr + 48 + ii), _scale);
+            _sum4 = _mm_mul_ps(_mm_loadu_ps(outptr + 64 + ii), _scale);
+            _sum5 = _mm_mul_ps(_mm_loadu_ps(outptr + 80 + ii), _scale);
+            _sum6 = _mm_mul_ps(_mm_loadu_ps(outptr + 96 + ii), _scale);
+            _sum7 = _mm_mul_ps(_mm_loadu_ps(outptr + 112 + ii), _scale);
+        }
+        for (int t = 0; t < n; t++)
+        {
+            __m128 _b = _mm_loadu_ps(b + t * 16 + ii);
+            _sum0 = _mm_comp_fmadd_ps(_mm_set1_ps(a0[t * a_stride]), _b, _sum0);
+            _sum1 = _mm_comp_fmadd_ps(_mm_set1_ps(a1[t * a_stride]), _b, _sum1);
+            _sum2 = _mm_comp_fmadd_ps(_mm_set1_ps(a2[t * a_stride]), _b, _sum2);
+            _sum3 = _mm_comp_fmadd_ps(_mm_set1_ps(a3[t * a_stride]), _b, _sum3);
+            _sum4 = _mm_comp_fmadd_ps(_mm_set1_ps(a4[t * a_stride]), _b, _sum4);
+            _sum5 = _mm_comp_fmadd_ps(_mm_set1_ps(a5[t * a_stride]), _b, _sum5);
+            _sum6 = _mm_comp_fmadd_ps(_mm_set1_ps(a6[t * a_stride]), _b, _sum6);
+            _sum7 = _mm_comp_fmadd_ps(_mm_set1_ps(a7[t * a_stride]), _b, _sum7);
+        }
+        _mm_storeu_ps(outptr + ii, _sum0);
+        _mm_storeu_ps(outptr + 16 + ii, _sum1);
+        _mm_storeu_ps(outptr + 32 + ii, _sum2);
+        _mm_storeu_ps(outptr + 48 + ii, _sum3);
+        _mm_storeu_ps(outptr + 64 + ii, _sum4);
+        _mm_storeu_ps(outptr + 80 + ii, _sum5);
+        _mm_storeu_ps(outptr + 96 + ii, _sum6);
+        _mm_storeu_ps(outptr + 112 + ii, _sum7);
+    }
+#else // __SSE2__
+    for (; ii < 16; ii++)
+    {
+        float sum0 = scale ? outptr[ii] * scale[ii] : 0.f;
+        float sum1 = scale ? outptr[16 + ii] * scale[ii] : 0.f;
+        float sum2 = scale ? outptr[32 + ii] * scale[ii] : 0.f;
+        float sum3 = scale ? outptr[48 + ii] * scale[ii] : 0.f;
+        float sum4 = scale ? outptr[64 + ii] * scale[ii] : 0.f;
+        float sum5 = scale ? outptr[80 + ii] * scale[ii] : 0.f;
+        float sum6 = scale ? outptr[96 + ii] * scale[ii] : 0.f;
+        float sum7 = scale ? outptr[112 + ii] * scale[ii] : 0.f;
+        for (int t = 0; t < n; t++)
+        {
+            const float b0 = b[t * 16 + ii];
+            sum0 += a0[t * a_stride] * b0;
+            sum1 += a1[t * a_stride] * b0;
+            sum2 += a2[t * a_stride] * b0;
+            sum3 += a3[t * a_stride] * b0;
+            sum4 += a4[t * a_stride] * b0;
+            sum5 += a5[t * a_stride] * b0;
+            sum6 += a6[t * a_stride] * b0;
+            sum7 += a7[t * a_stride] * b0;
+        }
+        outptr[ii] = sum0;
+        outptr[16 + ii] = sum1;
+        outptr[32 + ii] = sum2;
+        outptr[48 + ii] = sum3;
+        outptr[64 + ii] = sum4;
+        outptr[80 + ii] = sum5;
+        outptr[96 + ii] = sum6;
+        outptr[112 + ii] = sum7;
+    }
+#endif // __SSE2__
+}
+
+// outptr[ii] = outptr[ii] * scale[ii] + sum_t a[t * a_stride] * b[t * 16 + ii]
+// outptr starts from zero when scale is null
+static void attention_dot16(const float* a, int a_stride, const float* b, int n, const float* scale, float* outptr)
+{
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 15 < 16; ii += 16)
+    {
+        __m512 _sum = scale ? _mm512_mul_ps(_mm512_loadu_ps(outptr + ii), _mm512_loadu_ps(scale + ii)) : _mm512_setzero_ps();
+        for (int t = 0; t < n; t++)
+        {
+            _sum = _mm512_fmadd_ps(_mm512_set1_ps(a[t * a_stride]), _mm512_loadu_ps(b + t * 16 + ii), _sum);
+        }
+        _mm512_storeu_ps(outptr + ii, _sum);
+    }
+#endif // __AVX512F__
+    for (; ii + 7 < 16; ii += 8)
+    {
+        __m256 _sum = scale ? _mm256_mul_ps(_mm256_loadu_ps(outptr + ii), _mm256_loadu_ps(scale + ii)) : _mm256_setzero_ps();
+        for (int t = 0; t < n; t++)
+        {
+            _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(a[t * a_stride]), _mm256_loadu_ps(b + t * 16 + ii), _sum);
+        }
+        _mm256_storeu_ps(outptr + ii, _sum);
+    }
+#endif // __AVX__
+    for (; ii + 3 < 16; ii += 4)
+    {
+        __m128 _sum = scale ? _mm_mul_ps(_mm_loadu_ps(outptr + ii), _mm_loadu_ps(scale + ii)) : _mm_setzero_ps();
+        for (int t = 0; t < n; t++)
+        {
+            _sum = _mm_comp_fmadd_ps(_mm_set1_ps(a[t * a_stride]), _mm_loadu_ps(b + t * 16 + ii), _sum);
+        }
+        _mm_storeu_ps(outptr + ii, _sum);
+    }
+#else // __SSE2__
+    for (; ii < 16; ii++)
+    {
+        float sum = scale ? outptr[ii] * scale[ii] : 0.f;
+        for (int t = 0; t < n; t++)
+        {
+            sum += a[t * a_stride] * b[t * 16 + ii];
+        }
+        outptr[ii] = sum;
+    }
+#endif // __SSE2__
+}
+
+// online softmax over one key block, st holds n rows of 16 query scores
+// st turns into probabilities against the updated running max, the running sum follows
+// and scale receives the factor that brings the accumulated output onto the new max
+static void attention_online_softmax16(float* st, int n, float* max, float* sum, float* scale)
+{
+    int ii = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; ii + 15 < 16; ii += 16)
+    {
+        __m512 _max0 = _mm512_loadu_ps(max + ii);
+        __m512 _max = _max0;
+        for (int t = 0; t < n; t++)
+        {
+            _max = _mm512_max_ps(_max, _mm512_loadu_ps(st + t * 16 + ii));
+        }
+        __m512 _scale = exp512_ps(_mm512_sub_ps(_max0, _max));
+        __m512 _sum = _mm512_mul_ps(_mm512_loadu_ps(sum + ii), _scale);
+        for (int t = 0; t < n; t++)
+        {
+            __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(st + t * 16 + ii), _max));
+            _mm512_storeu_ps(st + t * 16 + ii, _p);
+            _sum = _mm512_add_ps(_sum, _p);
+        }
+        _mm512_storeu_ps(max + ii, _max);
+        _mm512_storeu_ps(sum + ii, _sum);
+        _mm512_storeu_ps(scale + ii, _scale);
+    }
+#endif // __AVX512F__
+    for (; ii + 7 < 16; ii += 8)
+    {
+        __m256 _max0 = _mm256_loadu_ps(max + ii);
+        __m256 _max = _max0;
+        for (int t = 0; t < n; t++)
+        {
+            _max = _mm256_max_ps(_max, _mm256_loadu_ps(st + t * 16 + ii));
+        }
+        __m256 _scale = exp256_ps(_mm256_sub_ps(_max0, _max));
+        __m256 _sum = _mm256_mul_ps(_mm256_loadu_ps(sum + ii), _scale);
+        for (int t = 0; t < n; t++)
+        {
+            __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(st + t * 16 + ii), _max));
+            _mm256_storeu_ps(st + t * 16 + ii, _p);
+            _sum = _mm256_add_ps(_sum, _p);
+        }
+        _mm256_storeu_ps(max + ii, _max);
+        _mm256_storeu_ps(sum + ii, _sum);
+        _mm256_storeu_ps(scale + ii, _scale);
+    }
+#endif // __AVX__
+    for (; ii + 3 < 16; ii += 4)
+    {
+        __m128 _max0 = _mm_loadu_ps(max + ii);
+        __m128 _max = _max0;
+        for (int t = 0; t < n; t++)
+        {
+            _max = _mm_max_ps(_max, _mm_loadu_ps(st + t * 16 + ii));
+        }
+        __m128 _scale = exp_ps(_mm_sub_ps(_max0, _max));
+        __m128 _sum = _mm_mul_ps(_mm_loadu_ps(sum + ii), _scale);
+        for (int t = 0; t < n; t++)
+        {
+            __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(st + t * 16 + ii), _max));
+            _mm_storeu_ps(st + t * 16 + ii, _p);
+            _sum = _mm_add_ps(_sum, _p);
+        }
+        _mm_storeu_ps(max + ii, _max);
+        _mm_storeu_ps(sum + ii, _sum);
+        _mm_storeu_ps(scale + ii, _scale);
+    }
+#else // __SSE2__
+    for (; ii < 16; ii++)
+    {
+        float max1 = max[ii];
+        for (int t = 0; t < n; t++)
+        {
+            max1 = std::max(max1, st[t * 16 + ii]);
+        }
+        const float scale1 = expf(max[ii] - max1);
+        float sum1 = sum[ii] * scale1;
+        for (int t = 0; t < n; t++)
+        {
+            const float p = expf(st[t * 16 + ii] - max1);
+            st[t * 16 + ii] = p;
+            sum1 += p;
+        }
+        max[ii] = max1;
+        sum[ii] = sum1;
+        scale[ii] = scale1;
+    }
+#endif // __SSE2__
+}
+
+// attention of all heads without materializing the attention matrix
+// each task takes 16 queries of one head, keys and values stream through in blocks of 64
+// with a running max and sum per query, so the working set stays at a few tiles per thread
+// q_affine k_affine v_affine and qkv_cross hold one row per channel and one column per position
+static int flash_attention(const Mat& q_affine, const Mat& k_affine, const Mat& v_affine, const Mat& attn_mask_blob, Mat& qkv_cross, int num_heads, const Option& opt)
+{
+    const int embed_dim_per_head = q_affine.h / num_heads;
+    const int src_seqlen = q_affine.w;
+    const int dst_seqlen = k_affine.w;
+
+    const int nn_q = (src_seqlen + 15) / 16;
+
+    // qt and ot of embed_dim_per_head x 16, st of 64 x 16, running max sum and scale of 16
+    Mat tiles(embed_dim_per_head * 16 * 2 + 64 * 16 + 16 * 3, opt.num_threads, 4u, opt.workspace_allocator);
+    if (tiles.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < num_heads * nn_q; t++)
+    {
+        const int h = t / nn_q;
+        const int i0 = (t % nn_q) * 16;
+        const int max_ii = std::min(src_seqlen - i0, 16);
+
+        float* qt = tiles.row(get_omp_thread_num());
+        float* ot = qt + embed_dim_per_head * 16;
+        float* st = ot + embed_dim_per_head * 16;
+        float* maxptr = st + 64 * 16;
+        float* sumptr = maxptr + 16;
+        float* scaleptr = sumptr + 16;
+
+        const Mat q = q_affine.row_range(h * embed_dim_per_head, embed_dim_per_head);
+        const Mat k = k_affine.row_range(h * embed_dim_per_head, embed_dim_per_head);
+        const Mat v = v_affine.row_range(h * embed_dim_per_head, embed_dim_per_head);
+        const Mat maskm = attn_mask_blob.dims == 3 ? attn_mask_blob.channel(h) : attn_mask_blob;
+
+        // queries of this task, zero padded to 16
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            const float* ptr = q.row(d) + i0;
+            float* qtptr = qt + d * 16;
+
+            int ii = 0;
+            for (; ii < max_ii; ii++)
+            {
+                qtptr[ii] = ptr[ii];
+            }
+            for (; ii < 16; ii++)
+            {
+                qtptr[ii] = 0.f;
+            }
+        }
+
+        memset(ot, 0, embed_dim_per_head * 16 * sizeof(float));
+
+        for (int ii = 0; ii < 16; ii++)
+        {
+            maxptr[ii] = -FLT_MAX;
+            sumptr[ii] = 0.f;
+        }
+
+        for (int j0 = 0; j0 < dst_seqlen; j0 += 64)
+        {
+            const int max_jj = std::min(dst_seqlen - j0, 64);
+
+            // scores of this block, the scale is already folded into q
+            const float* kptr = k.row(0) + j0;
+
+            int jj = 0;
+            for (; jj + 7 < max_jj; jj += 8)
+            {
+                attention_dot16_8(kptr + jj, k.w, 1, qt, embed_dim_per_head, 0, st + jj * 16);
+            }
+            for (; jj < max_jj; jj++)
+            {
+                attention_dot16(kptr + jj, k.w, qt, embed_dim_per_head, 0, st + jj * 16);
+            }
+
+            if (!maskm.empty())
+            {
+                for (int ii = 0; ii < max_ii; ii++)
+                {
+                    const float* mptr = maskm.row(i0 + ii) + j0;
+                    for (int jj = 0; jj < max_jj; jj++)
+                    {
+                        st[jj * 16 + ii] += mptr[jj];
+                    }
+                }
+            }
+
+            attention_online_softmax16(st, max_jj, maxptr, sumptr, scaleptr);
+
+            // rescale the accumulated output and add this block of values
+            int dd = 0;
+            for (; dd + 7 < embed_dim_per_head; dd += 8)
+            {
+                attention_dot16_8(v.row(dd) + j0, 1, v.w, st, max_jj, scaleptr, ot + dd * 16);
+            }
+            for (; dd < embed_dim_per_head; dd++)
+            {
+                attention_dot16(v.row(dd) + j0, 1, st, max_jj, scaleptr, ot + dd * 16);
+            }
+        }
+
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            float* outptr = qkv_cross.row(h * embed_dim_per_head + d) + i0;
+            const float* otptr = ot + d * 16;
+
+            for (int ii = 0; ii < max_ii; ii++)
+            {
+                outptr[ii] = otptr[ii] / sumptr[ii];
+            }
+        }
+    }
+
+    return 0;
+}
+
 int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& _opt) const
 {
+    // the cache blobs of past k and v come last
+    const int input_count = kv_cache ? (int)bottom_blobs.size() - 2 : (int)bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
 
     Option opt = _opt;
     if (int8_scale_term)
@@ -327,7 +832,6 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
 
     const int embed_dim_per_head = embed_dim / num_heads;
     const int src_seqlen = q_blob.h * q_blob.elempack;
-    const int dst_seqlen = k_blob.h * k_blob.elempack;
 
     Mat q_affine;
     int retq = q_gemm->forward(q_blob, q_affine, opt);
@@ -339,6 +843,51 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (kv_cache)
+    {
+        // attend over the cached positions followed by the new ones
+        retk = concat_kv_cache(bottom_blobs[input_count], k_affine, top_blobs[1], opt);
+        if (retk != 0)
+            return retk;
+
+        k_affine = top_blobs[1];
+    }
+
+    const int dst_seqlen = k_affine.w;
+
+    // stream keys and values through an online softmax when the attention matrix grows large
+    // short sequences and single query decoding stay on gemm
+    if (!int8_scale_term && src_seqlen >= 16 && dst_seqlen >= 128)
+    {
+        Mat v_affine;
+        int retv = v_gemm->forward(v_blob, v_affine, opt);
+        if (retv != 0)
+            return retv;
+
+        if (kv_cache)
+        {
+            retv = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+            if (retv != 0)
+                return retv;
+
+            v_affine = top_blobs[2];
+        }
+
+        Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+        if (qkv_cross.empty())
+            return -100;
+
+        int retqkv = flash_attention(q_affine, k_affine, v_affine, attn_mask_blob_unpacked, qkv_cross, num_heads, opt);
+        if (retqkv != 0)
+            return retqkv;
+
+        q_affine.release();
+        k_affine.release();
+        v_affine.release();
+
+        return o_gemm->forward(qkv_cross, top_blobs[0], opt);
+    }
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, 4u, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
@@ -380,6 +929,15 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retv != 0)
         return retv;
 
+    if (kv_cache)
+    {
+        retv = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+        if (retv != 0)
+            return retv;
+
+        v_affine = top_blobs[2];
+    }
+
     Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
     if (qkv_cross.empty())
         return -100;
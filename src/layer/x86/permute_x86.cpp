@@ -0,0 +1,490 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "permute_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Permute_x86::Permute_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+// output axis k takes input axis order[k], both counted from the outermost one
+static const int permute_orders_2d[2][2] = {
+    {0, 1}, // w h
+    {1, 0}, // h w
+};
+
+static const int permute_orders_3d[6][3] = {
+    {0, 1, 2}, // w h c
+    {0, 2, 1}, // h w c
+    {1, 0, 2}, // w c h
+    {1, 2, 0}, // c w h
+    {2, 0, 1}, // h c w
+    {2, 1, 0}, // c h w
+};
+
+static const int permute_orders_4d[24][4] = {
+    {0, 1, 2, 3}, // w h d c
+    {0, 1, 3, 2}, // h w d c
+    {0, 2, 1, 3}, // w d h c
+    {0, 2, 3, 1}, // d w h c
+    {0, 3, 1, 2}, // h d w c
+    {0, 3, 2, 1}, // d h w c
+    {1, 0, 2, 3}, // w h c d
+    {1, 0, 3, 2}, // h w c d
+    {1, 2, 0, 3}, // w c h d
+    {1, 2, 3, 0}, // c w h d
+    {1, 3, 0, 2}, // h c w d
+    {1, 3, 2, 0}, // c h w d
+    {2, 0, 1, 3}, // w d c h
+    {2, 0, 3, 1}, // d w c h
+    {2, 1, 0, 3}, // w c d h
+    {2, 1, 3, 0}, // c w d h
+    {2, 3, 0, 1}, // d c w h
+    {2, 3, 1, 0}, // c d w h
+    {3, 0, 1, 2}, // h d c w
+    {3, 0, 2, 1}, // d h c w
+    {3, 1, 0, 2}, // h c d w
+    {3, 1, 2, 0}, // c h d w
+    {3, 2, 0, 1}, // d c h w
+    {3, 2, 1, 0}, // c d h w
+};
+
+static void permute_copy(const float* ptr, size_t stride, float* outptr, int size, int elempack)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        for (; i < size; i++)
+        {
+            _mm512_storeu_ps(outptr, _mm512_loadu_ps(ptr));
+            ptr += stride;
+            outptr += 16;
+        }
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        for (; i < size; i++)
+        {
+            _mm256_storeu_ps(outptr, _mm256_loadu_ps(ptr));
+            ptr += stride;
+            outptr += 8;
+        }
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        for (; i < size; i++)
+        {
+            _mm_storeu_ps(outptr, _mm_loadu_ps(ptr));
+            ptr += stride;
+            outptr += 4;
+        }
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        for (int k = 0; k < elempack; k++)
+        {
+            outptr[k] = ptr[k];
+        }
+        ptr += stride;
+        outptr += elempack;
+    }
+}
+
+// load elempack rows of elempack floats, store them transposed
+static void permute_transpose(const float* ptr, size_t stride, float* outptr, size_t out_stride, int elempack)
+{
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        __m512 _r0 = _mm512_loadu_ps(ptr);
+        __m512 _r1 = _mm512_loadu_ps(ptr + stride);
+        __m512 _r2 = _mm512_loadu_ps(ptr + stride * 2);
+        __m512 _r3 = _mm512_loadu_ps(ptr + stride * 3);
+        __m512 _r4 = _mm512_loadu_ps(ptr + stride * 4);
+        __m512 _r5 = _mm512_loadu_ps(ptr + stride * 5);
+        __m512 _r6 = _mm512_loadu_ps(ptr + stride * 6);
+        __m512 _r7 = _mm512_loadu_ps(ptr + stride * 7);
+        __m512 _r8 = _mm512_loadu_ps(ptr + stride * 8);
+        __m512 _r9 = _mm512_loadu_ps(ptr + stride * 9);
+        __m512 _ra = _mm512_loadu_ps(ptr + stride * 10);
+        __m512 _rb = _mm512_loadu_ps(ptr + stride * 11);
+        __m512 _rc = _mm512_loadu_ps(ptr + stride * 12);
+        __m512 _rd = _mm512_loadu_ps(ptr + stride * 13);
+        __m512 _re = _mm512_loadu_ps(ptr + stride * 14);
+        __m512 _rf = _mm512_loadu_ps(ptr + stride * 15);
+        transpose16x16_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7, _r8, _r9, _ra, _rb, _rc, _rd, _re, _rf);
+        _mm512_storeu_ps(outptr, _r0);
+        _mm512_storeu_ps(outptr + out_stride, _r1);
+        _mm512_storeu_ps(outptr + out_stride * 2, _r2);
+        _mm512_storeu_ps(outptr + out_stride * 3, _r3);
+        _mm512_storeu_ps(outptr + out_stride * 4, _r4);
+        _mm512_storeu_ps(outptr + out_stride * 5, _r5);
+        _mm512_storeu_ps(outptr + out_stride * 6, _r6);
+        _mm512_storeu_ps(outptr + out_stride * 7, _r7);
+        _mm512_storeu_ps(outptr + out_stride * 8, _r8);
+        _mm512_storeu_ps(outptr + out_stride * 9, _r9);
+        _mm512_storeu_ps(outptr + out_stride * 10, _ra);
+        _mm512_storeu_ps(outptr + out_stride * 11, _rb);
+        _mm512_storeu_ps(outptr + out_stride * 12, _rc);
+        _mm512_storeu_ps(outptr + out_stride * 13, _rd);
+        _mm512_storeu_ps(outptr + out_stride * 14, _re);
+        _mm512_storeu_ps(outptr + out_stride * 15, _rf);
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        __m256 _r0 = _mm256_loadu_ps(ptr);
+        __m256 _r1 = _mm256_loadu_ps(ptr + stride);
+        __m256 _r2 = _mm256_loadu_ps(ptr + stride * 2);
+        __m256 _r3 = _mm256_loadu_ps(ptr + stride * 3);
+        __m256 _r4 = _mm256_loadu_ps(ptr + stride * 4);
+        __m256 _r5 = _mm256_loadu_ps(ptr + stride * 5);
+        __m256 _r6 = _mm256_loadu_ps(ptr + stride * 6);
+        __m256 _r7 = _mm256_loadu_ps(ptr + stride * 7);
+        transpose8x8_ps(_r0, _r1, _r2, _r3, _r4, _r5, _r6, _r7);
+        _mm256_storeu_ps(outptr, _r0);
+        _mm256_storeu_ps(outptr + out_stride, _r1);
+        _mm256_storeu_ps(outptr + out_stride * 2, _r2);
+        _mm256_storeu_ps(outptr + out_stride * 3, _r3);
+        _mm256_storeu_ps(outptr + out_stride * 4, _r4);
+        _mm256_storeu_ps(outptr + out_stride * 5, _r5);
+        _mm256_storeu_ps(outptr + out_stride * 6, _r6);
+        _mm256_storeu_ps(outptr + out_stride * 7, _r7);
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        __m128 _r0 = _mm_loadu_ps(ptr);
+        __m128 _r1 = _mm_loadu_ps(ptr + stride);
+        __m128 _r2 = _mm_loadu_ps(ptr + stride * 2);
+        __m128 _r3 = _mm_loadu_ps(ptr + stride * 3);
+        _MM_TRANSPOSE4_PS(_r0, _r1, _r2, _r3);
+        _mm_storeu_ps(outptr, _r0);
+        _mm_storeu_ps(outptr + out_stride, _r1);
+        _mm_storeu_ps(outptr + out_stride * 2, _r2);
+        _mm_storeu_ps(outptr + out_stride * 3, _r3);
+        return;
+    }
+#endif // __SSE2__
+    for (int i = 0; i < elempack; i++)
+    {
+        for (int j = 0; j < elempack; j++)
+        {
+            outptr[i * out_stride + j] = ptr[j * stride + i];
+        }
+    }
+}
+
+static void permute(const Mat& bottom_blob, Mat& top_blob, const int* order, const int* shape, const int* outshape, const Option& opt)
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const int out_elempack = top_blob.elempack;
+
+    // strides in floats, the packed axis 0 strides per group of elempack
+    size_t strides[4];
+    size_t out_strides[4];
+    strides[0] = dims == 2 ? (size_t)bottom_blob.w * elempack : bottom_blob.cstep * elempack;
+    out_strides[0] = dims == 2 ? (size_t)top_blob.w * out_elempack : top_blob.cstep * out_elempack;
+    strides[dims - 1] = elempack;
+    out_strides[dims - 1] = out_elempack;
+    for (int k = dims - 2; k >= 1; k--)
+    {
+        strides[k] = strides[k + 1] * shape[k + 1];
+        out_strides[k] = out_strides[k + 1] * outshape[k + 1];
+    }
+
+    // the inner output axes as three nested loops, outermost padded with size 1
+    int n[3];
+    int axis[3];
+    for (int l = 0; l < 3; l++)
+    {
+        const int k = dims - 3 + l;
+        n[l] = k >= 1 ? outshape[k] : 1;
+        axis[l] = k >= 1 ? order[k] : -1;
+    }
+
+    const float* bottom_ptr = bottom_blob;
+    float* top_ptr = top_blob;
+
+    const int outc = outshape[0] / out_elempack;
+
+    if (order[0] == 0 && out_elempack == elempack)
+    {
+        // the packed axis stays outermost, move whole packs around
+        size_t s[3];
+        for (int l = 0; l < 3; l++)
+        {
+            s[l] = axis[l] >= 1 ? strides[axis[l]] : 0;
+        }
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < outc; q++)
+        {
+            const float* ptr = bottom_ptr + q * strides[0];
+            float* outptr = top_ptr + q * out_strides[0];
+
+            for (int i = 0; i < n[0]; i++)
+            {
+                for (int j = 0; j < n[1]; j++)
+                {
+                    const float* ptr0 = ptr + i * s[0] + j * s[1];
+
+                    if (s[2] == (size_t)elempack)
+                    {
+                        // innermost axis untouched, rows are contiguous
+                        memcpy(outptr, ptr0, n[2] * elempack * sizeof(float));
+                    }
+                    else
+                    {
+                        permute_copy(ptr0, s[2], outptr, n[2], elempack);
+                    }
+
+                    outptr += n[2] * elempack;
+                }
+            }
+        }
+
+        return;
+    }
+
+    if (order[0] != 0 && elempack > 1 && out_elempack == elempack)
+    {
+        // the packed axis moves inwards, transpose elempack x elempack tiles
+        // the loop over the old packed axis steps one pack at a time
+        const int v = order[0];
+
+        size_t s[3];
+        size_t os[3];
+        int nn[3];
+        int l0 = 0;
+        for (int l = 0; l < 3; l++)
+        {
+            const int k = dims - 3 + l;
+            if (axis[l] == 0)
+            {
+                l0 = l;
+                s[l] = strides[0];
+                os[l] = k >= 1 ? out_strides[k] * elempack : 0;
+                nn[l] = n[l] / elempack;
+            }
+            else
+            {
+                s[l] = axis[l] >= 1 ? strides[axis[l]] : 0;
+                os[l] = k >= 1 ? out_strides[k] : 0;
+                nn[l] = n[l];
+            }
+        }
+
+        const size_t lane_out_stride = out_strides[dims - 3 + l0];
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < outc; q++)
+        {
+            const float* ptr = bottom_ptr + q * elempack * strides[v];
+            float* outptr = top_ptr + q * out_strides[0];
+
+            for (int i = 0; i < nn[0]; i++)
+            {
+                for (int j = 0; j < nn[1]; j++)
+                {
+                    for (int k = 0; k < nn[2]; k++)
+                    {
+                        const float* ptr0 = ptr + i * s[0] + j * s[1] + k * s[2];
+                        float* outptr0 = outptr + i * os[0] + j * os[1] + k * os[2];
+
+                        permute_transpose(ptr0, strides[v], outptr0, lane_out_stride, elempack);
+                    }
+                }
+            }
+        }
+
+        return;
+    }
+
+    // generic path, gather one float at a time
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < outc; q++)
+    {
+        float* outptr = top_ptr + q * out_strides[0];
+
+        int coords[4];
+
+        for (int i = 0; i < n[0]; i++)
+        {
+            for (int j = 0; j < n[1]; j++)
+            {
+                for (int k = 0; k < n[2]; k++)
+                {
+                    if (axis[0] >= 0) coords[axis[0]] = i;
+                    if (axis[1] >= 0) coords[axis[1]] = j;
+                    coords[axis[2]] = k;
+
+                    for (int p = 0; p < out_elempack; p++)
+                    {
+                        coords[order[0]] = q * out_elempack + p;
+
+                        size_t offset = (coords[0] / elempack) * strides[0] + coords[0] % elempack;
+                        for (int a = 1; a < dims; a++)
+                        {
+                            offset += coords[a] * strides[a];
+                        }
+
+                        *outptr++ = bottom_ptr[offset];
+                    }
+                }
+            }
+        }
+    }
+}
+
+int Permute_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (dims == 1 || order_type == 0)
+    {
+        top_blob = bottom_blob;
+        return 0;
+    }
+
+    if ((dims == 2 && order_type >= 2) || (dims == 3 && order_type >= 6) || order_type >= 24)
+    {
+        // unknown order, keep the reference behavior
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_pack = opt;
+            opt_pack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return Permute::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    const int* order = dims == 2 ? permute_orders_2d[order_type] : dims == 3 ? permute_orders_3d[order_type] : permute_orders_4d[order_type];
+
+    // real shape, outermost axis first, the packed axis is axis 0
+    int shape[4];
+    if (dims == 2)
+    {
+        shape[0] = bottom_blob.h * elempack;
+        shape[1] = bottom_blob.w;
+    }
+    else if (dims == 3)
+    {
+        shape[0] = bottom_blob.c * elempack;
+        shape[1] = bottom_blob.h;
+        shape[2] = bottom_blob.w;
+    }
+    else
+    {
+        shape[0] = bottom_blob.c * elempack;
+        shape[1] = bottom_blob.d;
+        shape[2] = bottom_blob.h;
+        shape[3] = bottom_blob.w;
+    }
+
+    int outshape[4];
+    for (int k = 0; k < dims; k++)
+    {
+        outshape[k] = shape[order[k]];
+    }
+
+    // moving only axes of size 1 around is a reshape
+    bool reshape_only = elempack == 1 || order[0] == 0;
+    {
+        int last_axis = -1;
+        for (int k = 0; k < dims; k++)
+        {
+            if (shape[order[k]] == 1)
+                continue;
+
+            if (order[k] < last_axis)
+                reshape_only = false;
+
+            last_axis = order[k];
+        }
+    }
+
+    if (reshape_only)
+    {
+        if (dims == 2)
+            top_blob = bottom_blob.reshape(outshape[1], outshape[0] / elempack, opt.blob_allocator);
+        if (dims == 3)
+            top_blob = bottom_blob.reshape(outshape[2], outshape[1], outshape[0] / elempack, opt.blob_allocator);
+        if (dims == 4)
+            top_blob = bottom_blob.reshape(outshape[3], outshape[2], outshape[1], outshape[0] / elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        // keep the input packing when possible so that whole vectors can be moved
+        if (elempack > 1 && outshape[0] % elempack == 0)
+        {
+            out_elempack = elempack;
+        }
+        else
+        {
+#if __AVX512F__
+            out_elempack = outshape[0] % 16 == 0 ? 16 : outshape[0] % 8 == 0 ? 8 : outshape[0] % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            out_elempack = outshape[0] % 8 == 0 ? 8 : outshape[0] % 4 == 0 ? 4 : 1;
+#else
+            out_elempack = outshape[0] % 4 == 0 ? 4 : 1;
+#endif
+        }
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    if (dims == 2)
+        top_blob.create(outshape[1], outshape[0] / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (dims == 3)
+        top_blob.create(outshape[2], outshape[1], outshape[0] / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (dims == 4)
+        top_blob.create(outshape[3], outshape[2], outshape[1], outshape[0] / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    permute(bottom_blob, top_blob, order, shape, outshape, opt);
+
+    return 0;
+}
+
+} // namespace ncnn
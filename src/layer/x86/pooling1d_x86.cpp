@@ -0,0 +1,516 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling1d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Pooling1D_x86::Pooling1D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Pooling1D_x86::create_pipeline(const Option& /*opt*/)
+{
+    if (adaptive_pooling)
+    {
+        support_packing = false;
+
+        support_bf16_storage = false;
+        support_fp16_storage = false;
+        support_int8_storage = false;
+        support_tensor_storage = false;
+    }
+    return 0;
+}
+
+int Pooling1D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // max value in N window
+    // avg value in N window
+
+    if (adaptive_pooling)
+    {
+        return Pooling1D::forward(bottom_blob, top_blob, opt);
+    }
+
+    int elempack = bottom_blob.elempack;
+
+    if (elempack == 1)
+    {
+        return Pooling1D::forward(bottom_blob, top_blob, opt);
+    }
+
+#if __SSE2__
+    int w = bottom_blob.w;
+    int h = bottom_blob.h;
+    size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        top_blob.create(h, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+#if __AVX__
+#if __AVX512F__
+        if (elempack == 16)
+        {
+            if (pooling_type == PoolMethod_MAX)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    __m512 _max = _mm512_loadu_ps(ptr);
+                    for (int i = 0; i < w; i++)
+                    {
+                        __m512 _val = _mm512_loadu_ps(ptr);
+                        _max = _mm512_max_ps(_max, _val);
+                        ptr += 16;
+                    }
+
+                    float* outptr = top_blob;
+                    _mm512_storeu_ps(outptr + q * 16, _max);
+                }
+            }
+            else if (pooling_type == PoolMethod_AVE)
+            {
+                __m512 _inv_w = _mm512_set1_ps(1.f / w);
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    __m512 _sum = _mm512_setzero_ps();
+                    for (int i = 0; i < w; i++)
+                    {
+                        __m512 _val = _mm512_loadu_ps(ptr);
+                        _sum = _mm512_add_ps(_sum, _val);
+                        ptr += 16;
+                    }
+
+                    __m512 _avg = _mm512_mul_ps(_sum, _inv_w);
+
+                    float* outptr = top_blob;
+                    _mm512_storeu_ps(outptr + q * 16, _avg);
+                }
+            }
+
+            return 0;
+        }
+#endif // __AVX512F__
+
+        if (elempack == 8)
+        {
+            if (pooling_type == PoolMethod_MAX)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    __m256 _max = _mm256_loadu_ps(ptr);
+                    for (int i = 0; i < w; i++)
+                    {
+                        __m256 _val = _mm256_loadu_ps(ptr);
+                        _max = _mm256_max_ps(_max, _val);
+                        ptr += 8;
+                    }
+
+                    float* outptr = top_blob;
+                    _mm256_storeu_ps(outptr + q * 8, _max);
+                }
+            }
+            else if (pooling_type == PoolMethod_AVE)
+            {
+                __m256 _inv_w = _mm256_set1_ps(1.f / w);
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    __m256 _sum = _mm256_setzero_ps();
+                    for (int i = 0; i < w; i++)
+                    {
+                        __m256 _val = _mm256_loadu_ps(ptr);
+                        _sum = _mm256_add_ps(_sum, _val);
+                        ptr += 8;
+                    }
+
+                    __m256 _avg = _mm256_mul_ps(_sum, _inv_w);
+
+                    float* outptr = top_blob;
+                    _mm256_storeu_ps(outptr + q * 8, _avg);
+                }
+            }
+
+            return 0;
+        }
+#endif // __AVX__
+
+        if (elempack == 4)
+        {
+            if (pooling_type == PoolMethod_MAX)
+            {
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    __m128 _max = _mm_loadu_ps(ptr);
+                    for (int i = 0; i < w; i++)
+                    {
+                        __m128 _val = _mm_loadu_ps(ptr);
+                        _max = _mm_max_ps(_max, _val);
+                        ptr += 4;
+                    }
+
+                    float* outptr = top_blob;
+                    _mm_storeu_ps(outptr + q * 4, _max);
+                }
+            }
+            else if (pooling_type == PoolMethod_AVE)
+            {
+                __m128 _inv_w = _mm_set1_ps(1.f / w);
+
+                #pragma omp parallel for num_threads(opt.num_threads)
+                for (int q = 0; q < h; q++)
+                {
+                    const float* ptr = bottom_blob.row(q);
+
+                    __m128 _sum = _mm_setzero_ps();
+                    for (int i = 0; i < w; i++)
+                    {
+                        __m128 _val = _mm_loadu_ps(ptr);
+                        _sum = _mm_add_ps(_sum, _val);
+                        ptr += 4;
+                    }
+
+                    __m128 _avg = _mm_mul_ps(_sum, _inv_w);
+
+                    float* outptr = top_blob;
+                    _mm_storeu_ps(outptr + q * 4, _avg);
+                }
+            }
+
+            return 0;
+        }
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    w = bottom_blob_bordered.w;
+
+    int outw = (w - kernel_w) / stride_w + 1;
+
+    top_blob.create(outw, h, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int wtailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+    }
+
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        if (pooling_type == PoolMethod_MAX)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 16;
+
+                    __m512 _max = _mm512_loadu_ps(sptr);
+                    for (int k = 1; k < kernel_w; k++)
+                    {
+                        __m512 _val = _mm512_loadu_ps(sptr + k * 16);
+                        _max = _mm512_max_ps(_max, _val);
+                    }
+
+                    _mm512_storeu_ps(outptr + j * 16, _max);
+                }
+            }
+        }
+        else if (avgpool_count_include_pad == 0)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    int sx0 = j * stride_w;
+
+                    __m512 _sum = _mm512_setzero_ps();
+                    int area = 0;
+
+                    for (int kj = 0; kj < kernel_w; kj++)
+                    {
+                        int sx = sx0 + kj;
+
+                        if (sx < pad_left)
+                            continue;
+
+                        if (sx >= w - pad_right - wtailpad)
+                            break;
+
+                        __m512 _val = _mm512_loadu_ps(ptr + sx * 16);
+                        _sum = _mm512_add_ps(_sum, _val);
+                        area += 1;
+                    }
+
+                    __m512 _inv_area = _mm512_set1_ps(1.f / area);
+                    __m512 _avg = _mm512_mul_ps(_sum, _inv_area);
+                    _mm512_storeu_ps(outptr + j * 16, _avg);
+                }
+            }
+        }
+        else // if (avgpool_count_include_pad == 1)
+        {
+            __m512 _inv_maxk = _mm512_set1_ps(1.f / kernel_w);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 16;
+
+                    __m512 _sum = _mm512_setzero_ps();
+                    for (int k = 0; k < kernel_w; k++)
+                    {
+                        __m512 _val = _mm512_loadu_ps(sptr + k * 16);
+                        _sum = _mm512_add_ps(_sum, _val);
+                    }
+
+                    __m512 _avg = _mm512_mul_ps(_sum, _inv_maxk);
+                    _mm512_storeu_ps(outptr + j * 16, _avg);
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __AVX512F__
+
+    if (elempack == 8)
+    {
+        if (pooling_type == PoolMethod_MAX)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 8;
+
+                    __m256 _max = _mm256_loadu_ps(sptr);
+                    for (int k = 1; k < kernel_w; k++)
+                    {
+                        __m256 _val = _mm256_loadu_ps(sptr + k * 8);
+                        _max = _mm256_max_ps(_max, _val);
+                    }
+
+                    _mm256_storeu_ps(outptr + j * 8, _max);
+                }
+            }
+        }
+        else if (avgpool_count_include_pad == 0)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    int sx0 = j * stride_w;
+
+                    __m256 _sum = _mm256_setzero_ps();
+                    int area = 0;
+
+                    for (int kj = 0; kj < kernel_w; kj++)
+                    {
+                        int sx = sx0 + kj;
+
+                        if (sx < pad_left)
+                            continue;
+
+                        if (sx >= w - pad_right - wtailpad)
+                            break;
+
+                        __m256 _val = _mm256_loadu_ps(ptr + sx * 8);
+                        _sum = _mm256_add_ps(_sum, _val);
+                        area += 1;
+                    }
+
+                    __m256 _inv_area = _mm256_set1_ps(1.f / area);
+                    __m256 _avg = _mm256_mul_ps(_sum, _inv_area);
+                    _mm256_storeu_ps(outptr + j * 8, _avg);
+                }
+            }
+        }
+        else // if (avgpool_count_include_pad == 1)
+        {
+            __m256 _inv_maxk = _mm256_set1_ps(1.f / kernel_w);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 8;
+
+                    __m256 _sum = _mm256_setzero_ps();
+                    for (int k = 0; k < kernel_w; k++)
+                    {
+                        __m256 _val = _mm256_loadu_ps(sptr + k * 8);
+                        _sum = _mm256_add_ps(_sum, _val);
+                    }
+
+                    __m256 _avg = _mm256_mul_ps(_sum, _inv_maxk);
+                    _mm256_storeu_ps(outptr + j * 8, _avg);
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __AVX__
+
+    if (elempack == 4)
+    {
+        if (pooling_type == PoolMethod_MAX)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 4;
+
+                    __m128 _max = _mm_loadu_ps(sptr);
+                    for (int k = 1; k < kernel_w; k++)
+                    {
+                        __m128 _val = _mm_loadu_ps(sptr + k * 4);
+                        _max = _mm_max_ps(_max, _val);
+                    }
+
+                    _mm_storeu_ps(outptr + j * 4, _max);
+                }
+            }
+        }
+        else if (avgpool_count_include_pad == 0)
+        {
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    int sx0 = j * stride_w;
+
+                    __m128 _sum = _mm_setzero_ps();
+                    int area = 0;
+
+                    for (int kj = 0; kj < kernel_w; kj++)
+                    {
+                        int sx = sx0 + kj;
+
+                        if (sx < pad_left)
+                            continue;
+
+                        if (sx >= w - pad_right - wtailpad)
+                            break;
+
+                        __m128 _val = _mm_loadu_ps(ptr + sx * 4);
+                        _sum = _mm_add_ps(_sum, _val);
+                        area += 1;
+                    }
+
+                    __m128 _inv_area = _mm_set1_ps(1.f / area);
+                    __m128 _avg = _mm_mul_ps(_sum, _inv_area);
+                    _mm_storeu_ps(outptr + j * 4, _avg);
+                }
+            }
+        }
+        else // if (avgpool_count_include_pad == 1)
+        {
+            __m128 _inv_maxk = _mm_set1_ps(1.f / kernel_w);
+
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < h; q++)
+            {
+                const float* ptr = bottom_blob_bordered.row(q);
+                float* outptr = top_blob.row(q);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = ptr + j * stride_w * 4;
+
+                    __m128 _sum = _mm_setzero_ps();
+                    for (int k = 0; k < kernel_w; k++)
+                    {
+                        __m128 _val = _mm_loadu_ps(sptr + k * 4);
+                        _sum = _mm_add_ps(_sum, _val);
+                    }
+
+                    __m128 _avg = _mm_mul_ps(_sum, _inv_maxk);
+                    _mm_storeu_ps(outptr + j * 4, _avg);
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __SSE2__
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,722 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "reduction_x86.h"
+
+#include <float.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Reduction_x86::Reduction_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+struct reduction_op_add
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_mul
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x * y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_mul_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_mul_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_mul_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_asum
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + fabsf(y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, abs_ps(y));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, abs256_ps(y));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, abs512_ps(y));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_sumsq
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + y * y;
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_comp_fmadd_ps(y, y, x);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_comp_fmadd_ps(y, y, x);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_fmadd_ps(y, y, x);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_sumexp
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return x + expf(y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_add_ps(x, exp_ps(y));
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_add_ps(x, exp256_ps(y));
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_add_ps(x, exp512_ps(y));
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_max
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::max(x, y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_max_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_max_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_max_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+struct reduction_op_min
+{
+    NCNN_FORCEINLINE float func(const float& x, const float& y) const
+    {
+        return std::min(x, y);
+    }
+#if __SSE2__
+    NCNN_FORCEINLINE __m128 func_pack4(const __m128& x, const __m128& y) const
+    {
+        return _mm_min_ps(x, y);
+    }
+#if __AVX__
+    NCNN_FORCEINLINE __m256 func_pack8(const __m256& x, const __m256& y) const
+    {
+        return _mm256_min_ps(x, y);
+    }
+#if __AVX512F__
+    NCNN_FORCEINLINE __m512 func_pack16(const __m512& x, const __m512& y) const
+    {
+        return _mm512_min_ps(x, y);
+    }
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+};
+
+// outptr[i] = op(outptr[i], ptr[i])
+template<typename Op>
+static void reduction_elementwise(float* outptr, const float* ptr, int size)
+{
+    Op op;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _out = _mm512_loadu_ps(outptr);
+        __m512 _p = _mm512_loadu_ps(ptr);
+        _mm512_storeu_ps(outptr, op.func_pack16(_out, _p));
+        outptr += 16;
+        ptr += 16;
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _out = _mm256_loadu_ps(outptr);
+        __m256 _p = _mm256_loadu_ps(ptr);
+        _mm256_storeu_ps(outptr, op.func_pack8(_out, _p));
+        outptr += 8;
+        ptr += 8;
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _out = _mm_loadu_ps(outptr);
+        __m128 _p = _mm_loadu_ps(ptr);
+        _mm_storeu_ps(outptr, op.func_pack4(_out, _p));
+        outptr += 4;
+        ptr += 4;
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        *outptr = op.func(*outptr, *ptr);
+        outptr++;
+        ptr++;
+    }
+}
+
+// reduce size contiguous floats into elempack lanes, then merge them into outptr with op2
+// the widest accumulator is folded in halves down to elempack
+template<typename Op, typename Op2>
+static void reduction_row(const float* ptr, int size, int elempack, float v0, float* outptr)
+{
+    Op op;
+    Op2 op2;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _sum_avx512 = _mm512_set1_ps(v0);
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = _mm512_loadu_ps(ptr);
+        _sum_avx512 = op.func_pack16(_sum_avx512, _p);
+        ptr += 16;
+    }
+    if (elempack == 16)
+    {
+        _mm512_storeu_ps(outptr, op2.func_pack16(_mm512_loadu_ps(outptr), _sum_avx512));
+        return;
+    }
+#endif // __AVX512F__
+    __m256 _sum_avx = _mm256_set1_ps(v0);
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = _mm256_loadu_ps(ptr);
+        _sum_avx = op.func_pack8(_sum_avx, _p);
+        ptr += 8;
+    }
+#if __AVX512F__
+    __m256 _sum_avx512_lo = _mm512_castps512_ps256(_sum_avx512);
+    __m256 _sum_avx512_hi = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(_sum_avx512), 1));
+    _sum_avx = op2.func_pack8(_sum_avx, op2.func_pack8(_sum_avx512_lo, _sum_avx512_hi));
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        _mm256_storeu_ps(outptr, op2.func_pack8(_mm256_loadu_ps(outptr), _sum_avx));
+        return;
+    }
+#endif // __AVX__
+    __m128 _sum = _mm_set1_ps(v0);
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_loadu_ps(ptr);
+        _sum = op.func_pack4(_sum, _p);
+        ptr += 4;
+    }
+#if __AVX__
+    _sum = op2.func_pack4(_sum, op2.func_pack4(_mm256_castps256_ps128(_sum_avx), _mm256_extractf128_ps(_sum_avx, 1)));
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        _mm_storeu_ps(outptr, op2.func_pack4(_mm_loadu_ps(outptr), _sum));
+        return;
+    }
+#endif // __SSE2__
+    float sum = v0;
+    for (; i < size; i++)
+    {
+        sum = op.func(sum, *ptr);
+        ptr++;
+    }
+#if __SSE2__
+    float sums[4];
+    _mm_storeu_ps(sums, _sum);
+    sum = op2.func(sum, op2.func(op2.func(sums[0], sums[1]), op2.func(sums[2], sums[3])));
+#endif // __SSE2__
+    outptr[0] = op2.func(outptr[0], sum);
+}
+
+template<typename Op, typename Op2>
+static int reduction(const Mat& a, Mat& b, bool reduce_w, bool reduce_h, bool reduce_d, bool reduce_c, int keepdims, float v0, const Option& opt)
+{
+    const int dims = a.dims;
+    const int elempack = a.elempack;
+    const size_t out_elemsize = a.elemsize / elempack;
+
+    if (dims == 1)
+    {
+        b.create(1, out_elemsize, opt.blob_allocator);
+        if (b.empty())
+            return -100;
+
+        b[0] = v0;
+        reduction_row<Op, Op2>(a, a.w * elempack, 1, v0, b);
+
+        return 0;
+    }
+
+    // view the blob as outer x d x h x w, the packed axis is always the outermost one
+    const int outer = dims == 2 ? a.h : a.c;
+    int d = dims == 4 ? a.d : 1;
+    int h = dims >= 3 ? a.h : 1;
+    int w = a.w;
+    const size_t outer_stride = dims == 2 ? (size_t)a.w * elempack : a.cstep * elempack;
+
+    const bool reduce_outer = dims == 2 ? reduce_h : reduce_c;
+    bool rd = dims == 4 && reduce_d;
+    bool rh = dims >= 3 && reduce_h;
+    const bool rw = reduce_w;
+    const bool reduce_inner = rd || rh || rw;
+
+    int outd = rd ? 1 : d;
+    int outh = rh ? 1 : h;
+    int outw = rw ? 1 : w;
+
+    // the outermost axis keeps its packing as long as it is not reduced
+    const int out_elempack = reduce_outer ? 1 : elempack;
+    const int out_outer = reduce_outer ? 1 : outer;
+
+    if (keepdims)
+    {
+        if (dims == 2)
+            b.create(outw, out_outer, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (dims == 3)
+            b.create(outw, outh, out_outer, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (dims == 4)
+            b.create(outw, outh, outd, out_outer, out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+    }
+    else
+    {
+        // outermost first
+        int shape[4];
+        int out_dims = 0;
+        if (!reduce_outer) shape[out_dims++] = outer;
+        if (dims == 4 && !rd) shape[out_dims++] = d;
+        if (dims >= 3 && !rh) shape[out_dims++] = h;
+        if (!rw) shape[out_dims++] = w;
+
+        if (out_dims == 0)
+            b.create(1, out_elemsize, opt.blob_allocator);
+        if (out_dims == 1)
+            b.create(shape[0], out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (out_dims == 2)
+            b.create(shape[1], shape[0], out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+        if (out_dims == 3)
+            b.create(shape[2], shape[1], shape[0], out_elemsize * out_elempack, out_elempack, opt.blob_allocator);
+    }
+    if (b.empty())
+        return -100;
+
+    // merge adjacent inner axes that are both reduced or both kept, they are contiguous in memory
+    if (rh == rw)
+    {
+        w *= h;
+        h = 1;
+        rh = rw;
+    }
+    if (h == 1 && rd == rw)
+    {
+        w *= d;
+        d = 1;
+        rd = rw;
+    }
+    if (d != 1 && rd == rh)
+    {
+        h *= d;
+        d = 1;
+    }
+
+    outd = rd ? 1 : d;
+    outh = rh ? 1 : h;
+    outw = rw ? 1 : w;
+    const int inner_size = outd * outh * outw;
+
+    // reduce the inner axes of each outer slice, all packed lanes at once
+    Mat sums;
+    if (reduce_outer && reduce_inner)
+    {
+        sums.create(inner_size * elempack, outer, 4u, opt.workspace_allocator);
+        if (sums.empty())
+            return -100;
+    }
+
+    if (reduce_inner)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < outer; q++)
+        {
+            const float* ptr = (const float*)a.data + q * outer_stride;
+
+            float* outptr;
+            if (reduce_outer)
+                outptr = sums.row(q);
+            else if (b.dims >= 3)
+                outptr = b.channel(q);
+            else if (b.dims == 2)
+                outptr = b.row(q);
+            else
+                outptr = (float*)b + q * elempack;
+
+            for (int i = 0; i < inner_size * elempack; i++)
+            {
+                outptr[i] = v0;
+            }
+
+            for (int z = 0; z < d; z++)
+            {
+                for (int y = 0; y < h; y++)
+                {
+                    float* outptr0 = outptr + ((rd ? 0 : z) * outh + (rh ? 0 : y)) * outw * elempack;
+
+                    if (rw)
+                        reduction_row<Op, Op2>(ptr, w * elempack, elempack, v0, outptr0);
+                    else
+                        reduction_elementwise<Op>(outptr0, ptr, w * elempack);
+
+                    ptr += w * elempack;
+                }
+            }
+        }
+    }
+
+    if (!reduce_outer)
+        return 0;
+
+    // reduce across the outer slices, then across the packed lanes
+    const int size = inner_size * elempack;
+
+    Mat acc(size, 4u, opt.workspace_allocator);
+    if (acc.empty())
+        return -100;
+
+    acc.fill(v0);
+
+    if (reduce_inner && inner_size == 1)
+    {
+        reduction_row<Op2, Op2>(sums, outer * elempack, elempack, v0, acc);
+    }
+    else
+    {
+        const float* src = reduce_inner ? (const float*)sums : (const float*)a;
+        const size_t src_stride = reduce_inner ? (size_t)sums.w : outer_stride;
+
+        const int nn_size = (size + 15) / 16;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int ii = 0; ii < nn_size; ii++)
+        {
+            const int i = ii * 16;
+            const int n = std::min(16, size - i);
+
+            float* outptr = (float*)acc + i;
+
+            for (int q = 0; q < outer; q++)
+            {
+                const float* ptr = src + q * src_stride + i;
+
+                if (reduce_inner)
+                    reduction_elementwise<Op2>(outptr, ptr, n);
+                else
+                    reduction_elementwise<Op>(outptr, ptr, n);
+            }
+        }
+    }
+
+    const int plane = b.w * b.h * b.d;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < inner_size; i++)
+    {
+        float sum = v0;
+        reduction_row<Op2, Op2>((const float*)acc + i * elempack, elempack, 1, v0, &sum);
+
+        float* outptr = (float*)b.data + (i / plane) * b.cstep + i % plane;
+        *outptr = sum;
+    }
+
+    return 0;
+}
+
+static int reduction_op(const Mat& a, Mat& b, bool reduce_w, bool reduce_h, bool reduce_d, bool reduce_c, int keepdims, int operation, float coeff, const Option& opt)
+{
+    int ret = 0;
+
+    switch (operation)
+    {
+    case Reduction::ReductionOp_SUM:
+    case Reduction::ReductionOp_MEAN:
+    case Reduction::ReductionOp_LogSum:
+        ret = reduction<reduction_op_add, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    case Reduction::ReductionOp_ASUM:
+    case Reduction::ReductionOp_L1:
+        ret = reduction<reduction_op_asum, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    case Reduction::ReductionOp_SUMSQ:
+    case Reduction::ReductionOp_L2:
+        ret = reduction<reduction_op_sumsq, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    case Reduction::ReductionOp_MAX:
+        ret = reduction<reduction_op_max, reduction_op_max>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, -FLT_MAX, opt);
+        break;
+    case Reduction::ReductionOp_MIN:
+        ret = reduction<reduction_op_min, reduction_op_min>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, FLT_MAX, opt);
+        break;
+    case Reduction::ReductionOp_PROD:
+        ret = reduction<reduction_op_mul, reduction_op_mul>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 1.f, opt);
+        break;
+    case Reduction::ReductionOp_LogSumExp:
+        ret = reduction<reduction_op_sumexp, reduction_op_add>(a, b, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, 0.f, opt);
+        break;
+    default:
+        // should never reach here
+        break;
+    }
+
+    if (ret != 0)
+        return ret;
+
+    const int size = (int)b.total() * b.elempack;
+
+    if (operation == Reduction::ReductionOp_LogSum || operation == Reduction::ReductionOp_LogSumExp)
+    {
+        float* ptr = b;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            ptr[i] = logf(ptr[i]);
+        }
+    }
+
+    if (operation == Reduction::ReductionOp_L2)
+    {
+        float* ptr = b;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < size; i++)
+        {
+            // flush subnormal input to zero, see the note in reduction.cpp
+            ptr[i] = sqrtf(ptr[i] < FLT_MIN ? 0.f : ptr[i]);
+        }
+    }
+
+    if (operation == Reduction::ReductionOp_MEAN)
+    {
+        const int dims = a.dims;
+        const int elempack = a.elempack;
+
+        int scale = 1;
+        if (dims == 1)
+        {
+            scale = a.w * elempack;
+        }
+        if (dims == 2)
+        {
+            if (reduce_w) scale *= a.w;
+            if (reduce_h) scale *= a.h * elempack;
+        }
+        if (dims == 3)
+        {
+            if (reduce_w) scale *= a.w;
+            if (reduce_h) scale *= a.h;
+            if (reduce_c) scale *= a.c * elempack;
+        }
+        if (dims == 4)
+        {
+            if (reduce_w) scale *= a.w;
+            if (reduce_h) scale *= a.h;
+            if (reduce_d) scale *= a.d;
+            if (reduce_c) scale *= a.c * elempack;
+        }
+
+        coeff = coeff / scale;
+    }
+
+    if (coeff != 1.f)
+    {
+        float* ptr = b;
+
+        int i = 0;
+#if __SSE2__
+        __m128 _coeff = _mm_set1_ps(coeff);
+        for (; i + 3 < size; i += 4)
+        {
+            _mm_storeu_ps(ptr + i, _mm_mul_ps(_mm_loadu_ps(ptr + i), _coeff));
+        }
+#endif // __SSE2__
+        for (; i < size; i++)
+        {
+            ptr[i] *= coeff;
+        }
+    }
+
+    return 0;
+}
+
+int Reduction_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int dims = bottom_blob.dims;
+    int axes_flag[4] = {0};
+    bool reduce_w = false;
+    bool reduce_h = false;
+    bool reduce_d = false;
+    bool reduce_c = false;
+
+    if (reduce_all)
+    {
+        reduce_w = true;
+        reduce_h = true;
+        reduce_d = true;
+        reduce_c = true;
+    }
+    else
+    {
+        const int* axes_ptr = axes;
+        int reduced_axes_num = axes.w;
+
+        for (int i = 0; i < reduced_axes_num; i++)
+        {
+            int axis = axes_ptr[i];
+            // handle negative axis
+            if (axis < 0)
+                axis += dims;
+            axes_flag[axis] = 1;
+        }
+
+        if (dims == 1)
+        {
+            reduce_w = true;
+        }
+        else if (dims == 2)
+        {
+            if (axes_flag[0] == 1) reduce_h = true;
+            if (axes_flag[1] == 1) reduce_w = true;
+        }
+        else if (dims == 3)
+        {
+            if (axes_flag[0] == 1) reduce_c = true;
+            if (axes_flag[1] == 1) reduce_h = true;
+            if (axes_flag[2] == 1) reduce_w = true;
+        }
+        else if (dims == 4)
+        {
+            if (axes_flag[0] == 1) reduce_c = true;
+            if (axes_flag[1] == 1) reduce_d = true;
+            if (axes_flag[2] == 1) reduce_h = true;
+            if (axes_flag[3] == 1) reduce_w = true;
+        }
+    }
+
+    if (!reduce_w && !reduce_h && !reduce_d && !reduce_c)
+    {
+        // nothing to reduce, keep the reference behavior
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (bottom_blob.elempack != 1)
+        {
+            Option opt_pack = opt;
+            opt_pack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return Reduction::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+
+    return reduction_op(bottom_blob, top_blob, reduce_w, reduce_h, reduce_d, reduce_c, keepdims, operation, coeff, opt);
+}
+
+} // namespace ncnn
@@ -0,0 +1,409 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "rnn_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "layer_type.h"
+
+namespace ncnn {
+
+RNN_x86::RNN_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+
+    gemm_xc = 0;
+}
+
+int RNN_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        // TODO int8 recurrence, fallback to the reference implementation for now
+        return 0;
+    }
+#endif
+
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output;
+
+    // all directions stacked as one weight
+    {
+        Mat weight_xc(size, num_output * num_directions);
+        Mat bias_xc(num_output * num_directions);
+        if (weight_xc.empty() || bias_xc.empty())
+            return -100;
+
+        for (int dr = 0; dr < num_directions; dr++)
+        {
+            memcpy(weight_xc.row(num_output * dr), weight_xc_data.channel(dr), size * num_output * sizeof(float));
+            memcpy((float*)bias_xc + num_output * dr, bias_c_data.channel(dr), num_output * sizeof(float));
+        }
+
+        gemm_xc = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+        ncnn::ParamDict pd;
+        pd.set(2, 0);                             // transA
+        pd.set(3, 1);                             // transB
+        pd.set(4, 0);                             // constantA
+        pd.set(5, 1);                             // constantB
+        pd.set(6, 1);                             // constantC
+        pd.set(7, 0);                             // M
+        pd.set(8, num_output * num_directions);   // N
+        pd.set(9, size);                          // K
+        pd.set(10, 4);                            // constant_broadcast_type_C
+        pd.set(11, 0);                            // output_N1M
+        pd.set(12, 1);                            // output_elempack
+        pd.set(14, 0);                            // output_transpose
+        gemm_xc->load_param(pd);
+        Mat weights[2];
+        weights[0] = weight_xc;
+        weights[1] = bias_xc;
+        gemm_xc->load_model(ModelBinFromMatArray(weights));
+        gemm_xc->create_pipeline(opt);
+    }
+
+    // pack rows for the hidden state gemv
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    const int elempack = 16;
+#else
+    const int elempack = 8;
+#endif
+#else
+    const int elempack = 4;
+#endif
+#else
+    const int elempack = 1;
+#endif
+
+    const int nn_rows = (num_output + elempack - 1) / elempack;
+
+    weight_hc_data_packed.create(num_output, nn_rows, num_directions, 4u * elempack, elempack);
+    if (weight_hc_data_packed.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_hc = weight_hc_data.channel(dr);
+        Mat weight_hc_packed = weight_hc_data_packed.channel(dr);
+
+        for (int i = 0; i < nn_rows; i++)
+        {
+            float* kptr = weight_hc_packed.row(i);
+
+            for (int k = 0; k < num_output; k++)
+            {
+                for (int j = 0; j < elempack; j++)
+                {
+                    const int r = i * elempack + j;
+                    kptr[j] = r < num_output ? weight_hc.row(r)[k] : 0.f;
+                }
+
+                kptr += elempack;
+            }
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+int RNN_x86::destroy_pipeline(const Option& opt)
+{
+    if (gemm_xc)
+    {
+        gemm_xc->destroy_pipeline(opt);
+        delete gemm_xc;
+        gemm_xc = 0;
+    }
+
+    return 0;
+}
+
+// gates = weight_hc * h
+static void rnn_gemv_hc(const Mat& weight_hc, const float* hidden_state, float* gates, int num_output, const Option& opt)
+{
+    const int elempack = weight_hc.elempack;
+    const int nn_rows = weight_hc.h;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < nn_rows; i++)
+    {
+        const float* kptr = weight_hc.row(i);
+        float* outptr = gates + i * elempack;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (elempack == 16)
+        {
+            __m512 _sum0 = _mm512_setzero_ps();
+            __m512 _sum1 = _mm512_setzero_ps();
+            int k = 0;
+            for (; k + 1 < num_output; k += 2)
+            {
+                _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_set1_ps(hidden_state[k]), _sum0);
+                _sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr + 16), _mm512_set1_ps(hidden_state[k + 1]), _sum1);
+                kptr += 32;
+            }
+            for (; k < num_output; k++)
+            {
+                _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_set1_ps(hidden_state[k]), _sum0);
+                kptr += 16;
+            }
+            _mm512_storeu_ps(outptr, _mm512_add_ps(_sum0, _sum1));
+        }
+#endif // __AVX512F__
+        if (elempack == 8)
+        {
+            __m256 _sum0 = _mm256_setzero_ps();
+            __m256 _sum1 = _mm256_setzero_ps();
+            int k = 0;
+            for (; k + 1 < num_output; k += 2)
+            {
+                _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_set1_ps(hidden_state[k]), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 8), _mm256_set1_ps(hidden_state[k + 1]), _sum1);
+                kptr += 16;
+            }
+            for (; k < num_output; k++)
+            {
+                _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_set1_ps(hidden_state[k]), _sum0);
+                kptr += 8;
+            }
+            _mm256_storeu_ps(outptr, _mm256_add_ps(_sum0, _sum1));
+        }
+#endif // __AVX__
+        if (elempack == 4)
+        {
+            __m128 _sum0 = _mm_setzero_ps();
+            __m128 _sum1 = _mm_setzero_ps();
+            int k = 0;
+            for (; k + 1 < num_output; k += 2)
+            {
+                _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_set1_ps(hidden_state[k]), _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _mm_set1_ps(hidden_state[k + 1]), _sum1);
+                kptr += 8;
+            }
+            for (; k < num_output; k++)
+            {
+                _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_set1_ps(hidden_state[k]), _sum0);
+                kptr += 4;
+            }
+            _mm_storeu_ps(outptr, _mm_add_ps(_sum0, _sum1));
+        }
+#endif // __SSE2__
+        if (elempack == 1)
+        {
+            float sum = 0.f;
+            for (int k = 0; k < num_output; k++)
+            {
+                sum += kptr[k] * hidden_state[k];
+            }
+            outptr[0] = sum;
+        }
+    }
+}
+
+// h_t := tanh(xc + weight_hc * h_{t-1})
+static void rnn_unit(const float* xc, const float* gates, float* hidden_state, float* outptr, int num_output)
+{
+    int q = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; q + 15 < num_output; q += 16)
+    {
+        __m512 _H = tanh_avx512(_mm512_add_ps(_mm512_loadu_ps(xc + q), _mm512_loadu_ps(gates + q)));
+        _mm512_storeu_ps(hidden_state + q, _H);
+        _mm512_storeu_ps(outptr + q, _H);
+    }
+#endif // __AVX512F__
+    for (; q + 7 < num_output; q += 8)
+    {
+        __m256 _H = tanh_avx(_mm256_add_ps(_mm256_loadu_ps(xc + q), _mm256_loadu_ps(gates + q)));
+        _mm256_storeu_ps(hidden_state + q, _H);
+        _mm256_storeu_ps(outptr + q, _H);
+    }
+#endif // __AVX__
+    for (; q + 3 < num_output; q += 4)
+    {
+        __m128 _H = tanh_sse(_mm_add_ps(_mm_loadu_ps(xc + q), _mm_loadu_ps(gates + q)));
+        _mm_storeu_ps(hidden_state + q, _H);
+        _mm_storeu_ps(outptr + q, _H);
+    }
+#endif // __SSE2__
+    for (; q < num_output; q++)
+    {
+        float H = tanhf(xc[q] + gates[q]);
+
+        hidden_state[q] = H;
+        outptr[q] = H;
+    }
+}
+
+// xc and top_blob hold all directions, direction dr takes the dr-th num_output
+static void rnn(const Mat& xc, Mat& top_blob, int reverse, int dr, const Mat& weight_hc, float* hidden_state, float* gates, int num_output, const Option& opt)
+{
+    const int T = xc.h;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        rnn_gemv_hc(weight_hc, hidden_state, gates, num_output, opt);
+
+        rnn_unit(xc.row(ti) + num_output * dr, gates, hidden_state, top_blob.row(ti) + num_output * dr, num_output);
+    }
+}
+
+int RNN_x86::forward_fp32(const Mat& bottom_blob, Mat& top_blob, Mat& hidden, const Option& opt) const
+{
+    const int T = bottom_blob.h;
+    const int num_directions = direction == 2 ? 2 : 1;
+
+    // input projection of all timesteps with bias
+    Mat xc;
+    {
+        Option opt_xc = opt;
+        opt_xc.blob_allocator = opt.workspace_allocator;
+
+        // gemm takes the sequence as a w x T matrix
+        std::vector<Mat> gemm_bottom_blobs(1);
+        gemm_bottom_blobs[0] = Mat(bottom_blob.w, T, bottom_blob.data, bottom_blob.elemsize, bottom_blob.allocator);
+        std::vector<Mat> gemm_top_blobs(1);
+        int ret = gemm_xc->forward(gemm_bottom_blobs, gemm_top_blobs, opt_xc);
+        if (ret != 0)
+            return ret;
+
+        xc = gemm_top_blobs[0];
+    }
+
+    const int elempack = weight_hc_data_packed.elempack;
+    const int nn_rows = weight_hc_data_packed.h;
+
+    Mat gates(nn_rows * elempack, num_directions, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    if (num_directions == 2 && opt.num_threads > 1 && num_output < 256)
+    {
+        // the two directions are independent and the per timestep fork join dominates small hidden size
+        // run them concurrently on split thread teams
+        Option opt_dr = opt;
+        opt_dr.num_threads = opt.num_threads / 2;
+
+        #pragma omp parallel for num_threads(2)
+        for (int dr = 0; dr < 2; dr++)
+        {
+            rnn(xc, top_blob, dr, dr, weight_hc_data_packed.channel(dr), hidden.row(dr), gates.row(dr), num_output, opt_dr);
+        }
+    }
+    else
+    {
+        for (int dr = 0; dr < num_directions; dr++)
+        {
+            const int reverse = direction == 1 || dr == 1;
+
+            rnn(xc, top_blob, reverse, dr, weight_hc_data_packed.channel(dr), hidden.row(dr), gates.row(dr), num_output, opt);
+        }
+    }
+
+    return 0;
+}
+
+int RNN_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return RNN::forward(bottom_blob, top_blob, opt);
+    }
+#endif
+
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, num_directions, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    return forward_fp32(bottom_blob, top_blob, hidden, opt);
+}
+
+int RNN_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return RNN::forward(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int ret = forward_fp32(bottom_blob, top_blob, hidden, opt);
+    if (ret != 0)
+        return ret;
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_SQUEEZE_X86_H
+#define LAYER_SQUEEZE_X86_H
+
+#include "squeeze.h"
+
+namespace ncnn {
+
+class Squeeze_x86 : public Squeeze
+{
+public:
+    Squeeze_x86();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_SQUEEZE_X86_H
@@ -0,0 +1,32 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "tile_x86.h"
+
+namespace ncnn {
+
+Tile_x86::Tile_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Tile_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // repeating packs keeps the packed axis outermost unless new leading axes appear
+    if (bottom_blob.elempack == 1 || repeats.w <= bottom_blob.dims)
+        return Tile::forward(bottom_blob, top_blob, opt);
+
+    Option opt_pack = opt;
+    opt_pack.blob_allocator = opt.workspace_allocator;
+
+    Mat bottom_blob_unpacked;
+    convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack);
+    if (bottom_blob_unpacked.empty())
+        return -100;
+
+    return Tile::forward(bottom_blob_unpacked, top_blob, opt);
+}
+
+} // namespace ncnn
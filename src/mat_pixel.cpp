@@ -2577,6 +2577,83 @@ Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h,
     return Mat();
 }
 
+Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, int resize_type, const Option& opt)
+{
+    int type_from = type & PIXEL_FORMAT_MASK;
+
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        return Mat::from_pixels_resize(pixels, type, w, h, w * 3, target_width, target_height, resize_type, opt);
+    }
+    else if (type_from == PIXEL_GRAY)
+    {
+        return Mat::from_pixels_resize(pixels, type, w, h, w * 1, target_width, target_height, resize_type, opt);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        return Mat::from_pixels_resize(pixels, type, w, h, w * 4, target_width, target_height, resize_type, opt);
+    }
+
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
+Mat Mat::from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, int resize_type, const Option& opt)
+{
+    if (resize_type != 2 && resize_type != 3 && resize_type != 4)
+    {
+        NCNN_LOGE("unsupported resize_type %d", resize_type);
+        return Mat();
+    }
+
+    if (w == target_width && h == target_height)
+        return Mat::from_pixels(pixels, type, w, h, stride, opt.blob_allocator);
+
+    int type_from = type & PIXEL_FORMAT_MASK;
+
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        Mat dst(target_width, target_height, (size_t)3u, 3);
+        if (resize_type == 2)
+            resize_bilinear_c3(pixels, w, h, stride, dst, target_width, target_height, target_width * 3, opt);
+        if (resize_type == 3)
+            resize_bicubic_c3(pixels, w, h, stride, dst, target_width, target_height, target_width * 3, opt);
+        if (resize_type == 4)
+            resize_area_c3(pixels, w, h, stride, dst, target_width, target_height, target_width * 3, opt);
+
+        return Mat::from_pixels(dst, type, target_width, target_height, opt.blob_allocator);
+    }
+    else if (type_from == PIXEL_GRAY)
+    {
+        Mat dst(target_width, target_height, (size_t)1u, 1);
+        if (resize_type == 2)
+            resize_bilinear_c1(pixels, w, h, stride, dst, target_width, target_height, target_width * 1, opt);
+        if (resize_type == 3)
+            resize_bicubic_c1(pixels, w, h, stride, dst, target_width, target_height, target_width * 1, opt);
+        if (resize_type == 4)
+            resize_area_c1(pixels, w, h, stride, dst, target_width, target_height, target_width * 1, opt);
+
+        return Mat::from_pixels(dst, type, target_width, target_height, opt.blob_allocator);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        Mat dst(target_width, target_height, (size_t)4u, 4);
+        if (resize_type == 2)
+            resize_bilinear_c4(pixels, w, h, stride, dst, target_width, target_height, target_width * 4, opt);
+        if (resize_type == 3)
+            resize_bicubic_c4(pixels, w, h, stride, dst, target_width, target_height, target_width * 4, opt);
+        if (resize_type == 4)
+            resize_area_c4(pixels, w, h, stride, dst, target_width, target_height, target_width * 4, opt);
+
+        return Mat::from_pixels(dst, type, target_width, target_height, opt.blob_allocator);
+    }
+
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
 Mat Mat::from_pixels_roi(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, Allocator* allocator)
 {
     if (roix < 0 || roiy < 0 || roiw <= 0 || roih <= 0 || roix + roiw > w || roiy + roih > h)
@@ -140,6 +140,185 @@ void invert_affine_transform(const float* tm, float* tm_inv)
     tm_inv[5] = b2;
 }
 
+#if __SSE2__
+// bilinear warpaffine 8 pixels that are all inside the source image
+// the two madd stages produce the same fixed-point result as the scalar path
+static void warpaffine_bilinear_inside8_sse2(const unsigned char* src0, int srcstride, int X0, int Y0, const int* adelta, const int* bdelta, int elempack, unsigned char* dst0)
+{
+    __m128i _X0 = _mm_set1_epi32(X0);
+    __m128i _Y0 = _mm_set1_epi32(Y0);
+    __m128i _Xl = _mm_add_epi32(_X0, _mm_loadu_si128((const __m128i*)adelta));
+    __m128i _Xh = _mm_add_epi32(_X0, _mm_loadu_si128((const __m128i*)(adelta + 4)));
+    __m128i _Yl = _mm_add_epi32(_Y0, _mm_loadu_si128((const __m128i*)bdelta));
+    __m128i _Yh = _mm_add_epi32(_Y0, _mm_loadu_si128((const __m128i*)(bdelta + 4)));
+
+    __m128i _v1024m1 = _mm_set1_epi32((1 << 10) - 1);
+    __m128i _v1024 = _mm_set1_epi32(1 << 10);
+    __m128i _fxl = _mm_and_si128(_Xl, _v1024m1);
+    __m128i _fxh = _mm_and_si128(_Xh, _v1024m1);
+    __m128i _fyl = _mm_and_si128(_Yl, _v1024m1);
+    __m128i _fyh = _mm_and_si128(_Yh, _v1024m1);
+
+    // alpha0 alpha1 and beta0 beta1 pairs
+    int alpha[8];
+    int beta[8];
+    _mm_storeu_si128((__m128i*)alpha, _mm_or_si128(_mm_sub_epi32(_v1024, _fxl), _mm_slli_epi32(_fxl, 16)));
+    _mm_storeu_si128((__m128i*)(alpha + 4), _mm_or_si128(_mm_sub_epi32(_v1024, _fxh), _mm_slli_epi32(_fxh, 16)));
+    _mm_storeu_si128((__m128i*)beta, _mm_or_si128(_mm_sub_epi32(_v1024, _fyl), _mm_slli_epi32(_fyl, 16)));
+    _mm_storeu_si128((__m128i*)(beta + 4), _mm_or_si128(_mm_sub_epi32(_v1024, _fyh), _mm_slli_epi32(_fyh, 16)));
+
+    int sx[8];
+    int sy[8];
+    _mm_storeu_si128((__m128i*)sx, _mm_srai_epi32(_Xl, 10));
+    _mm_storeu_si128((__m128i*)(sx + 4), _mm_srai_epi32(_Xh, 10));
+    _mm_storeu_si128((__m128i*)sy, _mm_srai_epi32(_Yl, 10));
+    _mm_storeu_si128((__m128i*)(sy + 4), _mm_srai_epi32(_Yh, 10));
+
+    const unsigned char* a0[8];
+    for (int xi = 0; xi < 8; xi++)
+    {
+        a0[xi] = src0 + srcstride * sy[xi] + sx[xi] * elempack;
+    }
+
+    __m128i _zero = _mm_setzero_si128();
+
+    if (elempack == 1)
+    {
+        __m128i _a = _mm_setzero_si128();
+        __m128i _b = _mm_setzero_si128();
+        _a = _mm_insert_epi16(_a, a0[0][0] | (a0[0][1] << 8), 0);
+        _a = _mm_insert_epi16(_a, a0[1][0] | (a0[1][1] << 8), 1);
+        _a = _mm_insert_epi16(_a, a0[2][0] | (a0[2][1] << 8), 2);
+        _a = _mm_insert_epi16(_a, a0[3][0] | (a0[3][1] << 8), 3);
+        _a = _mm_insert_epi16(_a, a0[4][0] | (a0[4][1] << 8), 4);
+        _a = _mm_insert_epi16(_a, a0[5][0] | (a0[5][1] << 8), 5);
+        _a = _mm_insert_epi16(_a, a0[6][0] | (a0[6][1] << 8), 6);
+        _a = _mm_insert_epi16(_a, a0[7][0] | (a0[7][1] << 8), 7);
+        _b = _mm_insert_epi16(_b, a0[0][srcstride] | (a0[0][srcstride + 1] << 8), 0);
+        _b = _mm_insert_epi16(_b, a0[1][srcstride] | (a0[1][srcstride + 1] << 8), 1);
+        _b = _mm_insert_epi16(_b, a0[2][srcstride] | (a0[2][srcstride + 1] << 8), 2);
+        _b = _mm_insert_epi16(_b, a0[3][srcstride] | (a0[3][srcstride + 1] << 8), 3);
+        _b = _mm_insert_epi16(_b, a0[4][srcstride] | (a0[4][srcstride + 1] << 8), 4);
+        _b = _mm_insert_epi16(_b, a0[5][srcstride] | (a0[5][srcstride + 1] << 8), 5);
+        _b = _mm_insert_epi16(_b, a0[6][srcstride] | (a0[6][srcstride + 1] << 8), 6);
+        _b = _mm_insert_epi16(_b, a0[7][srcstride] | (a0[7][srcstride + 1] << 8), 7);
+
+        __m128i _alphal = _mm_loadu_si128((const __m128i*)alpha);
+        __m128i _alphah = _mm_loadu_si128((const __m128i*)(alpha + 4));
+        __m128i _betal = _mm_loadu_si128((const __m128i*)beta);
+        __m128i _betah = _mm_loadu_si128((const __m128i*)(beta + 4));
+
+        __m128i _tal = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(_a, _zero), _alphal), 5);
+        __m128i _tah = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi8(_a, _zero), _alphah), 5);
+        __m128i _tbl = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi8(_b, _zero), _alphal), 5);
+        __m128i _tbh = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi8(_b, _zero), _alphah), 5);
+
+        __m128i _dstl = _mm_srai_epi32(_mm_madd_epi16(_mm_or_si128(_tal, _mm_slli_epi32(_tbl, 16)), _betal), 15);
+        __m128i _dsth = _mm_srai_epi32(_mm_madd_epi16(_mm_or_si128(_tah, _mm_slli_epi32(_tbh, 16)), _betah), 15);
+
+        __m128i _dst = _mm_packs_epi32(_dstl, _dsth);
+        _mm_storel_epi64((__m128i*)dst0, _mm_packus_epi16(_dst, _dst));
+    }
+    if (elempack == 2)
+    {
+        for (int xi = 0; xi < 8; xi += 4)
+        {
+            __m128i _dst[2];
+            for (int k = 0; k < 2; k++)
+            {
+                const unsigned char* p0 = a0[xi + k * 2];
+                const unsigned char* p1 = a0[xi + k * 2 + 1];
+
+                int a00;
+                int a01;
+                int b00;
+                int b01;
+                memcpy(&a00, p0, 4);
+                memcpy(&a01, p1, 4);
+                memcpy(&b00, p0 + srcstride, 4);
+                memcpy(&b01, p1 + srcstride, 4);
+
+                // c0 c1 c0' c1' to c0 c0' c1 c1'
+                __m128i _a = _mm_unpacklo_epi8(_mm_setr_epi32(a00, a01, 0, 0), _zero);
+                __m128i _b = _mm_unpacklo_epi8(_mm_setr_epi32(b00, b01, 0, 0), _zero);
+                _a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(_a, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+                _b = _mm_shufflehi_epi16(_mm_shufflelo_epi16(_b, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0));
+
+                __m128i _alpha = _mm_setr_epi32(alpha[xi + k * 2], alpha[xi + k * 2], alpha[xi + k * 2 + 1], alpha[xi + k * 2 + 1]);
+                __m128i _beta = _mm_setr_epi32(beta[xi + k * 2], beta[xi + k * 2], beta[xi + k * 2 + 1], beta[xi + k * 2 + 1]);
+
+                __m128i _ta = _mm_srai_epi32(_mm_madd_epi16(_a, _alpha), 5);
+                __m128i _tb = _mm_srai_epi32(_mm_madd_epi16(_b, _alpha), 5);
+                _dst[k] = _mm_srai_epi32(_mm_madd_epi16(_mm_or_si128(_ta, _mm_slli_epi32(_tb, 16)), _beta), 15);
+            }
+
+            __m128i _dst01 = _mm_packs_epi32(_dst[0], _dst[1]);
+            _mm_storel_epi64((__m128i*)(dst0 + xi * 2), _mm_packus_epi16(_dst01, _dst01));
+        }
+    }
+    if (elempack == 3 || elempack == 4)
+    {
+        // c0 c1 c2 c3 per 32bit lane, c3 is garbage for elempack 3
+        int dst[8];
+        for (int xi = 0; xi < 8; xi += 2)
+        {
+            __m128i _dst[2];
+            for (int k = 0; k < 2; k++)
+            {
+                const unsigned char* p = a0[xi + k];
+
+                __m128i _a;
+                __m128i _b;
+                if (elempack == 3)
+                {
+                    int a00;
+                    int b00;
+                    memcpy(&a00, p, 4);
+                    memcpy(&b00, p + srcstride, 4);
+                    _a = _mm_unpacklo_epi8(_mm_insert_epi16(_mm_cvtsi32_si128(a00), p[4] | (p[5] << 8), 2), _zero);
+                    _b = _mm_unpacklo_epi8(_mm_insert_epi16(_mm_cvtsi32_si128(b00), p[srcstride + 4] | (p[srcstride + 5] << 8), 2), _zero);
+
+                    // c0 c1 c2 c0' c1' c2' to c0 c0' c1 c1' c2 c2'
+                    _a = _mm_unpacklo_epi16(_a, _mm_srli_si128(_a, 6));
+                    _b = _mm_unpacklo_epi16(_b, _mm_srli_si128(_b, 6));
+                }
+                else
+                {
+                    _a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p), _zero);
+                    _b = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(p + srcstride)), _zero);
+
+                    // c0 c1 c2 c3 c0' c1' c2' c3' to c0 c0' c1 c1' c2 c2' c3 c3'
+                    _a = _mm_unpacklo_epi16(_a, _mm_srli_si128(_a, 8));
+                    _b = _mm_unpacklo_epi16(_b, _mm_srli_si128(_b, 8));
+                }
+
+                __m128i _alpha = _mm_set1_epi32(alpha[xi + k]);
+                __m128i _beta = _mm_set1_epi32(beta[xi + k]);
+
+                __m128i _ta = _mm_srai_epi32(_mm_madd_epi16(_a, _alpha), 5);
+                __m128i _tb = _mm_srai_epi32(_mm_madd_epi16(_b, _alpha), 5);
+                _dst[k] = _mm_srai_epi32(_mm_madd_epi16(_mm_or_si128(_ta, _mm_slli_epi32(_tb, 16)), _beta), 15);
+            }
+
+            __m128i _dst01 = _mm_packs_epi32(_dst[0], _dst[1]);
+            _mm_storel_epi64((__m128i*)(dst + xi), _mm_packus_epi16(_dst01, _dst01));
+        }
+
+        if (elempack == 4)
+        {
+            memcpy(dst0, dst, 32);
+        }
+        else
+        {
+            for (int xi = 0; xi < 8; xi++)
+            {
+                memcpy(dst0 + xi * 3, dst + xi, 3);
+            }
+        }
+    }
+}
+#endif // __SSE2__
+
 void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v)
 {
     return warpaffine_bilinear_c1(src, srcw, srch, srcw, dst, w, h, w, tm, type, v);
@@ -161,12 +340,18 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, unsign
 }
 
 void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+
+    return warpaffine_bilinear_c1(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -179,9 +364,11 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -287,6 +474,10 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 
                 vst1_u8(dst0, _dst);
 
+                dst0 += 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, 1, dst0);
+
                 dst0 += 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -457,8 +648,6 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 1;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -466,12 +655,18 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+
+    return warpaffine_bilinear_c2(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w * 2;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -484,9 +679,11 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -605,6 +802,10 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 
                 vst2_u8(dst0, _dst);
 
+                dst0 += 2 * 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, 2, dst0);
+
                 dst0 += 2 * 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -784,8 +985,6 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 2;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -793,12 +992,18 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+
+    return warpaffine_bilinear_c3(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w * 3;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -811,9 +1016,11 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -965,6 +1172,10 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 
                 vst3_u8(dst0, _dst);
 
+                dst0 += 3 * 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, 3, dst0);
+
                 dst0 += 3 * 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -1151,8 +1362,6 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 3;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -1160,12 +1369,18 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 }
 
 void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    Option opt;
+    opt.num_threads = 1;
+
+    return warpaffine_bilinear_c4(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt);
+}
+
+void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
-    const int wgap = stride - w * 4;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -1178,9 +1393,11 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int y = 0; y < h; y++)
     {
+        unsigned char* dst0 = dst + stride * y;
+
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
 
@@ -1367,6 +1584,10 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
 
                 vst4_u8(dst0, _dst);
 
+                dst0 += 4 * 8;
+#elif __SSE2__
+                warpaffine_bilinear_inside8_sse2(src0, srcstride, X0, Y0, adelta.data() + x, bdelta.data() + x, 4, dst0);
+
                 dst0 += 4 * 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -1560,8 +1781,6 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
 
             dst0 += 4;
         }
-
-        dst0 += wgap;
     }
 
 #undef SATURATE_CAST_SHORT
@@ -56,6 +56,37 @@ static void vresize_two(const short* rows0p, const short* rows1p, int wsize, uns
         rows1p += 8;
     }
 #endif // __ARM_NEON
+#if __AVX2__
+    __m256i _b0_avx2 = _mm256_set1_epi16(b0);
+    __m256i _b1_avx2 = _mm256_set1_epi16(b1);
+    __m256i _b2_avx2 = _mm256_set1_epi16(b2);
+    __m256i _b3_avx2 = _mm256_set1_epi16(b3);
+    __m256i _v2_avx2 = _mm256_set1_epi16(2);
+    for (; dx + 31 < wsize; dx += 32)
+    {
+        __m256i _r00 = _mm256_loadu_si256((const __m256i*)rows0p);
+        __m256i _r01 = _mm256_loadu_si256((const __m256i*)(rows0p + 16));
+        __m256i _r10 = _mm256_loadu_si256((const __m256i*)rows1p);
+        __m256i _r11 = _mm256_loadu_si256((const __m256i*)(rows1p + 16));
+        __m256i _acc00 = _mm256_add_epi16(_mm256_mulhi_epi16(_r00, _b0_avx2), _mm256_mulhi_epi16(_r10, _b1_avx2));
+        __m256i _acc01 = _mm256_add_epi16(_mm256_mulhi_epi16(_r01, _b0_avx2), _mm256_mulhi_epi16(_r11, _b1_avx2));
+        __m256i _acc10 = _mm256_add_epi16(_mm256_mulhi_epi16(_r00, _b2_avx2), _mm256_mulhi_epi16(_r10, _b3_avx2));
+        __m256i _acc11 = _mm256_add_epi16(_mm256_mulhi_epi16(_r01, _b2_avx2), _mm256_mulhi_epi16(_r11, _b3_avx2));
+        _acc00 = _mm256_srai_epi16(_mm256_add_epi16(_acc00, _v2_avx2), 2);
+        _acc01 = _mm256_srai_epi16(_mm256_add_epi16(_acc01, _v2_avx2), 2);
+        _acc10 = _mm256_srai_epi16(_mm256_add_epi16(_acc10, _v2_avx2), 2);
+        _acc11 = _mm256_srai_epi16(_mm256_add_epi16(_acc11, _v2_avx2), 2);
+        // packus works within 128bit lanes, restore the element order
+        __m256i _Dp0 = _mm256_permute4x64_epi64(_mm256_packus_epi16(_acc00, _acc01), _MM_SHUFFLE(3, 1, 2, 0));
+        __m256i _Dp1 = _mm256_permute4x64_epi64(_mm256_packus_epi16(_acc10, _acc11), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)Dp0, _Dp0);
+        _mm256_storeu_si256((__m256i*)Dp1, _Dp1);
+        Dp0 += 32;
+        Dp1 += 32;
+        rows0p += 32;
+        rows1p += 32;
+    }
+#endif // __AVX2__
 #if __SSE2__
     __m128i _b0 = _mm_set1_epi16(b0);
     __m128i _b1 = _mm_set1_epi16(b1);
@@ -145,6 +176,28 @@ static void vresize_one(const short* rows0p, const short* rows1p, int wsize, uns
         rows1p += 8;
     }
 #endif // __ARM_NEON
+#if __AVX2__
+    __m256i _b0_avx2 = _mm256_set1_epi16(b0);
+    __m256i _b1_avx2 = _mm256_set1_epi16(b1);
+    __m256i _v2_avx2 = _mm256_set1_epi16(2);
+    for (; dx + 31 < wsize; dx += 32)
+    {
+        __m256i _r00 = _mm256_loadu_si256((const __m256i*)rows0p);
+        __m256i _r01 = _mm256_loadu_si256((const __m256i*)(rows0p + 16));
+        __m256i _r10 = _mm256_loadu_si256((const __m256i*)rows1p);
+        __m256i _r11 = _mm256_loadu_si256((const __m256i*)(rows1p + 16));
+        __m256i _acc0 = _mm256_add_epi16(_mm256_mulhi_epi16(_r00, _b0_avx2), _mm256_mulhi_epi16(_r10, _b1_avx2));
+        __m256i _acc1 = _mm256_add_epi16(_mm256_mulhi_epi16(_r01, _b0_avx2), _mm256_mulhi_epi16(_r11, _b1_avx2));
+        _acc0 = _mm256_srai_epi16(_mm256_add_epi16(_acc0, _v2_avx2), 2);
+        _acc1 = _mm256_srai_epi16(_mm256_add_epi16(_acc1, _v2_avx2), 2);
+        // packus works within 128bit lanes, restore the element order
+        __m256i _Dp = _mm256_permute4x64_epi64(_mm256_packus_epi16(_acc0, _acc1), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256((__m256i*)Dp, _Dp);
+        Dp += 32;
+        rows0p += 32;
+        rows1p += 32;
+    }
+#endif // __AVX2__
 #if __SSE2__
     __m128i _b0 = _mm_set1_epi16(b0);
     __m128i _b1 = _mm_set1_epi16(b1);
@@ -207,33 +260,19 @@ void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, unsigned c
     return resize_bilinear_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4);
 }
 
-void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+static void resize_bilinear_coeffs(int srcsize, int dstsize, int* ofs, short* coeffs)
 {
     const int INTER_RESIZE_COEF_BITS = 11;
     const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
 
-    double scale_x = (double)srcw / w;
-    double scale_y = (double)srch / h;
-
-    int* buf = new int[w + h + w + h];
-
-    int* xofs = buf;     //new int[w];
-    int* yofs = buf + w; //new int[h];
-
-    short* ialpha = (short*)(buf + w + h);    //new short[w * 2];
-    short* ibeta = (short*)(buf + w + h + w); //new short[h * 2];
-
-    float fx;
-    float fy;
-    int sx;
-    int sy;
+    double scale = (double)srcsize / dstsize;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X + (X >= 0.f ? 0.5f : -0.5f)), SHRT_MIN), SHRT_MAX);
 
-    for (int dx = 0; dx < w; dx++)
+    for (int dx = 0; dx < dstsize; dx++)
     {
-        fx = (float)((dx + 0.5) * scale_x - 0.5);
-        sx = static_cast<int>(floor(fx));
+        float fx = (float)((dx + 0.5) * scale - 0.5);
+        int sx = static_cast<int>(floor(fx));
         fx -= sx;
 
         if (sx < 0)
@@ -241,146 +280,263 @@ void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstr
             sx = 0;
             fx = 0.f;
         }
-        if (sx >= srcw - 1)
+        if (sx >= srcsize - 1)
         {
-            sx = srcw - 2;
+            sx = srcsize - 2;
             fx = 1.f;
         }
 
-        xofs[dx] = sx;
+        ofs[dx] = sx;
 
         float a0 = (1.f - fx) * INTER_RESIZE_COEF_SCALE;
         float a1 = fx * INTER_RESIZE_COEF_SCALE;
 
-        ialpha[dx * 2] = SATURATE_CAST_SHORT(a0);
-        ialpha[dx * 2 + 1] = SATURATE_CAST_SHORT(a1);
+        coeffs[dx * 2] = SATURATE_CAST_SHORT(a0);
+        coeffs[dx * 2 + 1] = SATURATE_CAST_SHORT(a1);
     }
 
-    for (int dy = 0; dy < h; dy++)
-    {
-        fy = (float)((dy + 0.5) * scale_y - 0.5);
-        sy = static_cast<int>(floor(fy));
-        fy -= sy;
+#undef SATURATE_CAST_SHORT
+}
+
+static void hresize_bilinear(const unsigned char* S, short* rows, int w, int elempack, const int* xofs, const short* ialpha)
+{
+    int dx = 0;
+#if __SSE2__
+    __m128i _zero = _mm_setzero_si128();
+#endif // __SSE2__
 
-        if (sy < 0)
+    if (elempack == 1)
+    {
+#if __SSE2__
+        for (; dx + 7 < w; dx += 8)
         {
-            sy = 0;
-            fy = 0.f;
+            // gather the S[sx] S[sx+1] pairs and madd with the a0 a1 pairs
+            __m128i _S = _mm_setzero_si128();
+            _S = _mm_insert_epi16(_S, S[xofs[dx]] | (S[xofs[dx] + 1] << 8), 0);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 1]] | (S[xofs[dx + 1] + 1] << 8), 1);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 2]] | (S[xofs[dx + 2] + 1] << 8), 2);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 3]] | (S[xofs[dx + 3] + 1] << 8), 3);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 4]] | (S[xofs[dx + 4] + 1] << 8), 4);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 5]] | (S[xofs[dx + 5] + 1] << 8), 5);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 6]] | (S[xofs[dx + 6] + 1] << 8), 6);
+            _S = _mm_insert_epi16(_S, S[xofs[dx + 7]] | (S[xofs[dx + 7] + 1] << 8), 7);
+
+            __m128i _Sl = _mm_unpacklo_epi8(_S, _zero);
+            __m128i _Sh = _mm_unpackhi_epi8(_S, _zero);
+            __m128i _al = _mm_loadu_si128((const __m128i*)(ialpha + dx * 2));
+            __m128i _ah = _mm_loadu_si128((const __m128i*)(ialpha + dx * 2 + 8));
+            __m128i _rowsl = _mm_srai_epi32(_mm_madd_epi16(_Sl, _al), 4);
+            __m128i _rowsh = _mm_srai_epi32(_mm_madd_epi16(_Sh, _ah), 4);
+            _mm_storeu_si128((__m128i*)(rows + dx), _mm_packs_epi32(_rowsl, _rowsh));
         }
-        if (sy >= srch - 1)
+#endif // __SSE2__
+        for (; dx < w; dx++)
         {
-            sy = srch - 2;
-            fy = 1.f;
-        }
-
-        yofs[dy] = sy;
+            const unsigned char* Sp = S + xofs[dx];
+            short a0 = ialpha[dx * 2];
+            short a1 = ialpha[dx * 2 + 1];
 
-        float b0 = (1.f - fy) * INTER_RESIZE_COEF_SCALE;
-        float b1 = fy * INTER_RESIZE_COEF_SCALE;
-
-        ibeta[dy * 2] = SATURATE_CAST_SHORT(b0);
-        ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
+            rows[dx] = (Sp[0] * a0 + Sp[1] * a1) >> 4;
+        }
     }
+    if (elempack == 2)
+    {
+#if __SSE2__
+        for (; dx + 1 < w; dx += 2)
+        {
+            int s0;
+            int s1;
+            memcpy(&s0, S + xofs[dx] * 2, 4);
+            memcpy(&s1, S + xofs[dx + 1] * 2, 4);
 
-#undef SATURATE_CAST_SHORT
+            // c0 c1 c0' c1' to c0 c0' c1 c1'
+            __m128i _S = _mm_unpacklo_epi8(_mm_setr_epi32(s0, s1, 0, 0), _zero);
+            _S = _mm_shufflelo_epi16(_S, _MM_SHUFFLE(3, 1, 2, 0));
+            _S = _mm_shufflehi_epi16(_S, _MM_SHUFFLE(3, 1, 2, 0));
 
-    // loop body
-    Mat rowsbuf0(w, (size_t)2u);
-    Mat rowsbuf1(w, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
+            __m128i _a = _mm_loadl_epi64((const __m128i*)(ialpha + dx * 2));
+            _a = _mm_unpacklo_epi32(_a, _a);
 
-    int prev_sy1 = -2;
+            __m128i _rows = _mm_srai_epi32(_mm_madd_epi16(_S, _a), 4);
+            _mm_storel_epi64((__m128i*)(rows + dx * 2), _mm_packs_epi32(_rows, _rows));
+        }
+#endif // __SSE2__
+        for (; dx < w; dx++)
+        {
+            const unsigned char* Sp = S + xofs[dx] * 2;
+            short* rowsp = rows + dx * 2;
+#if __ARM_NEON
+            int16x4_t _a0a1XX = vld1_s16(ialpha + dx * 2);
+            int16x4_t _a0a0a1a1 = vzip_s16(_a0a1XX, _a0a1XX).val[0];
+            uint8x8_t _S = uint8x8_t();
+
+            _S = vld1_lane_u8(Sp, _S, 0);
+            _S = vld1_lane_u8(Sp + 1, _S, 1);
+            _S = vld1_lane_u8(Sp + 2, _S, 2);
+            _S = vld1_lane_u8(Sp + 3, _S, 3);
+
+            int16x8_t _S16 = vreinterpretq_s16_u16(vmovl_u8(_S));
+            int16x4_t _Slowhigh = vget_low_s16(_S16);
+            int32x4_t _Sma0a1 = vmull_s16(_Slowhigh, _a0a0a1a1);
+            int32x2_t _rowslow = vadd_s32(vget_low_s32(_Sma0a1), vget_high_s32(_Sma0a1));
+            int32x4_t _rows = vcombine_s32(_rowslow, vget_high_s32(_Sma0a1));
+            int16x4_t _rows_sr4 = vshrn_n_s32(_rows, 4);
+            vst1_s16(rowsp, _rows_sr4);
+#else
+            short a0 = ialpha[dx * 2];
+            short a1 = ialpha[dx * 2 + 1];
 
-    for (int dy = 0; dy < h; dy++)
+            rowsp[0] = (Sp[0] * a0 + Sp[2] * a1) >> 4;
+            rowsp[1] = (Sp[1] * a0 + Sp[3] * a1) >> 4;
+#endif // __ARM_NEON
+        }
+    }
+    if (elempack == 3)
     {
-        sy = yofs[dy];
-
-        if (sy == prev_sy1)
+#if __SSE2__
+        for (; dx + 1 < w; dx += 2)
         {
-            // reuse all rows
+            const unsigned char* S0p = S + xofs[dx] * 3;
+            const unsigned char* S1p = S + xofs[dx + 1] * 3;
+
+            int s0;
+            int s1;
+            memcpy(&s0, S0p, 4);
+            memcpy(&s1, S1p, 4);
+            __m128i _S0 = _mm_insert_epi16(_mm_cvtsi32_si128(s0), S0p[4] | (S0p[5] << 8), 2);
+            __m128i _S1 = _mm_insert_epi16(_mm_cvtsi32_si128(s1), S1p[4] | (S1p[5] << 8), 2);
+
+            // c0 c1 c2 c0' c1' c2' to c0 c0' c1 c1' c2 c2'
+            _S0 = _mm_unpacklo_epi8(_S0, _zero);
+            _S1 = _mm_unpacklo_epi8(_S1, _zero);
+            _S0 = _mm_unpacklo_epi16(_S0, _mm_srli_si128(_S0, 6));
+            _S1 = _mm_unpacklo_epi16(_S1, _mm_srli_si128(_S1, 6));
+
+            int a0a1_0;
+            int a0a1_1;
+            memcpy(&a0a1_0, ialpha + dx * 2, 4);
+            memcpy(&a0a1_1, ialpha + dx * 2 + 2, 4);
+
+            __m128i _rows0 = _mm_srai_epi32(_mm_madd_epi16(_S0, _mm_set1_epi32(a0a1_0)), 4);
+            __m128i _rows1 = _mm_srai_epi32(_mm_madd_epi16(_S1, _mm_set1_epi32(a0a1_1)), 4);
+            __m128i _rows = _mm_packs_epi32(_rows0, _rows1);
+
+            // the fourth short is overwritten by the next pixel
+            _mm_storel_epi64((__m128i*)(rows + dx * 3), _rows);
+            _mm_storel_epi64((__m128i*)(rows + dx * 3 + 3), _mm_srli_si128(_rows, 8));
         }
-        else if (sy == prev_sy1 + 1)
+#endif // __SSE2__
+        for (; dx < w; dx++)
         {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
-            {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S1p = S1 + sx;
-                rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
-
-                ialphap += 2;
-            }
+            const unsigned char* Sp = S + xofs[dx] * 3;
+            short* rowsp = rows + dx * 3;
+            short a0 = ialpha[dx * 2];
+            short a1 = ialpha[dx * 2 + 1];
+#if __ARM_NEON
+            int16x4_t _a0 = vdup_n_s16(a0);
+            int16x4_t _a1 = vdup_n_s16(a1);
+            uint8x8_t _S = uint8x8_t();
+
+            _S = vld1_lane_u8(Sp, _S, 0);
+            _S = vld1_lane_u8(Sp + 1, _S, 1);
+            _S = vld1_lane_u8(Sp + 2, _S, 2);
+            _S = vld1_lane_u8(Sp + 3, _S, 3);
+            _S = vld1_lane_u8(Sp + 4, _S, 4);
+            _S = vld1_lane_u8(Sp + 5, _S, 5);
+
+            int16x8_t _S16 = vreinterpretq_s16_u16(vmovl_u8(_S));
+            int16x4_t _Slow = vget_low_s16(_S16);
+            int16x4_t _Shigh = vext_s16(_Slow, vget_high_s16(_S16), 3);
+            int32x4_t _rows = vmull_s16(_Slow, _a0);
+            _rows = vmlal_s16(_rows, _Shigh, _a1);
+            int16x4_t _rows_sr4 = vshrn_n_s32(_rows, 4);
+            vst1_s16(rowsp, _rows_sr4);
+#else
+            rowsp[0] = (Sp[0] * a0 + Sp[3] * a1) >> 4;
+            rowsp[1] = (Sp[1] * a0 + Sp[4] * a1) >> 4;
+            rowsp[2] = (Sp[2] * a0 + Sp[5] * a1) >> 4;
+#endif // __ARM_NEON
         }
-        else
+    }
+    if (elempack == 4)
+    {
+#if __SSE2__
+        for (; dx + 1 < w; dx += 2)
         {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
-            {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
-                rows0p[dx] = (S0p[0] * a0 + S0p[1] * a1) >> 4;
-                rows1p[dx] = (S1p[0] * a0 + S1p[1] * a1) >> 4;
-
-                ialphap += 2;
-            }
-        }
-
-        prev_sy1 = sy;
+            __m128i _S0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(S + xofs[dx] * 4)), _zero);
+            __m128i _S1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(S + xofs[dx + 1] * 4)), _zero);
 
-        if (dy + 1 < h && yofs[dy + 1] == sy)
-        {
-            // vresize for two rows
-            unsigned char* Dp0 = dst + stride * dy;
-            unsigned char* Dp1 = dst + stride * (dy + 1);
+            // c0 c1 c2 c3 c0' c1' c2' c3' to c0 c0' c1 c1' c2 c2' c3 c3'
+            _S0 = _mm_unpacklo_epi16(_S0, _mm_srli_si128(_S0, 8));
+            _S1 = _mm_unpacklo_epi16(_S1, _mm_srli_si128(_S1, 8));
 
-            vresize_two(rows0, rows1, w, Dp0, Dp1, ibeta[0], ibeta[1], ibeta[2], ibeta[3]);
+            int a0a1_0;
+            int a0a1_1;
+            memcpy(&a0a1_0, ialpha + dx * 2, 4);
+            memcpy(&a0a1_1, ialpha + dx * 2 + 2, 4);
 
-            ibeta += 4;
-            dy += 1;
+            __m128i _rows0 = _mm_srai_epi32(_mm_madd_epi16(_S0, _mm_set1_epi32(a0a1_0)), 4);
+            __m128i _rows1 = _mm_srai_epi32(_mm_madd_epi16(_S1, _mm_set1_epi32(a0a1_1)), 4);
+            _mm_storeu_si128((__m128i*)(rows + dx * 4), _mm_packs_epi32(_rows0, _rows1));
         }
-        else
+#endif // __SSE2__
+        for (; dx < w; dx++)
         {
-            // vresize
-            unsigned char* Dp = dst + stride * dy;
-
-            vresize_one(rows0, rows1, w, Dp, ibeta[0], ibeta[1]);
-
-            ibeta += 2;
+            const unsigned char* Sp = S + xofs[dx] * 4;
+            short* rowsp = rows + dx * 4;
+            short a0 = ialpha[dx * 2];
+            short a1 = ialpha[dx * 2 + 1];
+#if __ARM_NEON
+            int16x4_t _a0 = vdup_n_s16(a0);
+            int16x4_t _a1 = vdup_n_s16(a1);
+            uint8x8_t _S = vld1_u8(Sp);
+            int16x8_t _S16 = vreinterpretq_s16_u16(vmovl_u8(_S));
+            int16x4_t _Slow = vget_low_s16(_S16);
+            int16x4_t _Shigh = vget_high_s16(_S16);
+            int32x4_t _rows = vmull_s16(_Slow, _a0);
+            _rows = vmlal_s16(_rows, _Shigh, _a1);
+            int16x4_t _rows_sr4 = vshrn_n_s32(_rows, 4);
+            vst1_s16(rowsp, _rows_sr4);
+#else
+            rowsp[0] = (Sp[0] * a0 + Sp[4] * a1) >> 4;
+            rowsp[1] = (Sp[1] * a0 + Sp[5] * a1) >> 4;
+            rowsp[2] = (Sp[2] * a0 + Sp[6] * a1) >> 4;
+            rowsp[3] = (Sp[3] * a0 + Sp[7] * a1) >> 4;
+#endif // __ARM_NEON
         }
     }
-
-    delete[] buf;
 }
 
-void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+// bilinear resize one output row, the hresized source rows sy and sy+1 are kept in rows0 and rows1 for the next output row
+static void resize_bilinear_row(const unsigned char* src, int srcstride, int w, int elempack, const int* xofs, const short* ialpha, int sy, short b0, short b1, short*& rows0, short*& rows1, int& prev_sy, unsigned char* dst)
 {
-    const int INTER_RESIZE_COEF_BITS = 11;
-    const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
+    if (sy == prev_sy)
+    {
+        // reuse all rows
+    }
+    else if (sy == prev_sy + 1)
+    {
+        // hresize one row
+        short* rows0_old = rows0;
+        rows0 = rows1;
+        rows1 = rows0_old;
+
+        hresize_bilinear(src + srcstride * (sy + 1), rows1, w, elempack, xofs, ialpha);
+    }
+    else
+    {
+        // hresize two rows
+        hresize_bilinear(src + srcstride * sy, rows0, w, elempack, xofs, ialpha);
+        hresize_bilinear(src + srcstride * (sy + 1), rows1, w, elempack, xofs, ialpha);
+    }
 
-    double scale_x = (double)srcw / w;
-    double scale_y = (double)srch / h;
+    prev_sy = sy;
+
+    vresize_one(rows0, rows1, w * elempack, dst, b0, b1);
+}
 
+static void resize_bilinear_image(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int elempack, int num_threads)
+{
     int* buf = new int[w + h + w + h];
 
     int* xofs = buf;     //new int[w];
@@ -389,669 +545,1654 @@ void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstr
     short* ialpha = (short*)(buf + w + h);    //new short[w * 2];
     short* ibeta = (short*)(buf + w + h + w); //new short[h * 2];
 
-    float fx;
-    float fy;
-    int sx;
-    int sy;
+    resize_bilinear_coeffs(srcw, w, xofs, ialpha);
+    resize_bilinear_coeffs(srch, h, yofs, ibeta);
 
-#define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X + (X >= 0.f ? 0.5f : -0.5f)), SHRT_MIN), SHRT_MAX);
+    // each thread takes a band of output rows and keeps its own hresized source rows
+    const int nT = std::max(1, std::min(num_threads, h));
 
-    for (int dx = 0; dx < w; dx++)
+    #pragma omp parallel for num_threads(nT)
+    for (int ti = 0; ti < nT; ti++)
     {
-        fx = (float)((dx + 0.5) * scale_x - 0.5);
-        sx = static_cast<int>(floor(fx));
-        fx -= sx;
-
-        if (sx < 0)
-        {
-            sx = 0;
-            fx = 0.f;
-        }
-        if (sx >= srcw - 1)
-        {
-            sx = srcw - 2;
-            fx = 1.f;
-        }
-
-        xofs[dx] = sx * 2;
-
-        float a0 = (1.f - fx) * INTER_RESIZE_COEF_SCALE;
-        float a1 = fx * INTER_RESIZE_COEF_SCALE;
+        const int y0 = h * ti / nT;
+        const int y1 = h * (ti + 1) / nT;
 
-        ialpha[dx * 2] = SATURATE_CAST_SHORT(a0);
-        ialpha[dx * 2 + 1] = SATURATE_CAST_SHORT(a1);
-    }
+        // the simd hresize may store two shorts past the row end
+        Mat rowsbuf0(w * elempack + 2, (size_t)2u);
+        Mat rowsbuf1(w * elempack + 2, (size_t)2u);
+        short* rows0 = (short*)rowsbuf0.data;
+        short* rows1 = (short*)rowsbuf1.data;
 
-    for (int dy = 0; dy < h; dy++)
-    {
-        fy = (float)((dy + 0.5) * scale_y - 0.5);
-        sy = static_cast<int>(floor(fy));
-        fy -= sy;
+        int prev_sy1 = -2;
 
-        if (sy < 0)
-        {
-            sy = 0;
-            fy = 0.f;
-        }
-        if (sy >= srch - 1)
+        for (int dy = y0; dy < y1; dy++)
         {
-            sy = srch - 2;
-            fy = 1.f;
-        }
-
-        yofs[dy] = sy;
-
-        float b0 = (1.f - fy) * INTER_RESIZE_COEF_SCALE;
-        float b1 = fy * INTER_RESIZE_COEF_SCALE;
-
-        ibeta[dy * 2] = SATURATE_CAST_SHORT(b0);
-        ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
-    }
-
-#undef SATURATE_CAST_SHORT
+            int sy = yofs[dy];
 
-    // loop body
-    Mat rowsbuf0(w * 2 + 2, (size_t)2u);
-    Mat rowsbuf1(w * 2 + 2, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
+            if (sy == prev_sy1)
+            {
+                // reuse all rows
+            }
+            else if (sy == prev_sy1 + 1)
+            {
+                // hresize one row
+                short* rows0_old = rows0;
+                rows0 = rows1;
+                rows1 = rows0_old;
 
-    int prev_sy1 = -2;
+                hresize_bilinear(src + srcstride * (sy + 1), rows1, w, elempack, xofs, ialpha);
+            }
+            else
+            {
+                // hresize two rows
+                hresize_bilinear(src + srcstride * sy, rows0, w, elempack, xofs, ialpha);
+                hresize_bilinear(src + srcstride * (sy + 1), rows1, w, elempack, xofs, ialpha);
+            }
 
-    for (int dy = 0; dy < h; dy++)
-    {
-        sy = yofs[dy];
+            prev_sy1 = sy;
 
-        if (sy == prev_sy1)
-        {
-            // reuse all rows
-        }
-        else if (sy == prev_sy1 + 1)
-        {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            if (dy + 1 < y1 && yofs[dy + 1] == sy)
             {
-                sx = xofs[dx];
-
-                const unsigned char* S1p = S1 + sx;
-#if __ARM_NEON
-                int16x4_t _a0a1XX = vld1_s16(ialphap);
-                int16x4_t _a0a0a1a1 = vzip_s16(_a0a1XX, _a0a1XX).val[0];
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S1lowhigh = vget_low_s16(_S116);
-                int32x4_t _S1ma0a1 = vmull_s16(_S1lowhigh, _a0a0a1a1);
-                int32x2_t _rows1low = vadd_s32(vget_low_s32(_S1ma0a1), vget_high_s32(_S1ma0a1));
-                int32x4_t _rows1 = vcombine_s32(_rows1low, vget_high_s32(_S1ma0a1));
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows1p, _rows1_sr4);
-#else
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
+                // vresize for two rows
+                unsigned char* Dp0 = dst + stride * dy;
+                unsigned char* Dp1 = dst + stride * (dy + 1);
 
-                rows1p[0] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
-#endif // __ARM_NEON
+                vresize_two(rows0, rows1, w * elempack, Dp0, Dp1, ibeta[dy * 2], ibeta[dy * 2 + 1], ibeta[dy * 2 + 2], ibeta[dy * 2 + 3]);
 
-                ialphap += 2;
-                rows1p += 2;
+                dy += 1;
             }
-        }
-        else
-        {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            else
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
-#if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S0 = uint8x8_t();
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S0 = vld1_lane_u8(S0p, _S0, 0);
-                _S0 = vld1_lane_u8(S0p + 1, _S0, 1);
-                _S0 = vld1_lane_u8(S0p + 2, _S0, 2);
-                _S0 = vld1_lane_u8(S0p + 3, _S0, 3);
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-
-                int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S0lowhigh = vget_low_s16(_S016);
-                int16x4_t _S1lowhigh = vget_low_s16(_S116);
-                int32x2x2_t _S0S1low_S0S1high = vtrn_s32(vreinterpret_s32_s16(_S0lowhigh), vreinterpret_s32_s16(_S1lowhigh));
-                int32x4_t _rows01 = vmull_s16(vreinterpret_s16_s32(_S0S1low_S0S1high.val[0]), _a0);
-                _rows01 = vmlal_s16(_rows01, vreinterpret_s16_s32(_S0S1low_S0S1high.val[1]), _a1);
-                int16x4_t _rows01_sr4 = vshrn_n_s32(_rows01, 4);
-                int16x4_t _rows1_sr4 = vext_s16(_rows01_sr4, _rows01_sr4, 2);
-                vst1_s16(rows0p, _rows01_sr4);
-                vst1_s16(rows1p, _rows1_sr4);
-#else
-                rows0p[0] = (S0p[0] * a0 + S0p[2] * a1) >> 4;
-                rows0p[1] = (S0p[1] * a0 + S0p[3] * a1) >> 4;
-                rows1p[0] = (S1p[0] * a0 + S1p[2] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[3] * a1) >> 4;
-#endif // __ARM_NEON
+                // vresize
+                unsigned char* Dp = dst + stride * dy;
 
-                ialphap += 2;
-                rows0p += 2;
-                rows1p += 2;
+                vresize_one(rows0, rows1, w * elempack, Dp, ibeta[dy * 2], ibeta[dy * 2 + 1]);
             }
         }
+    }
 
-        prev_sy1 = sy;
+    delete[] buf;
+}
 
-        if (dy + 1 < h && yofs[dy + 1] == sy)
-        {
-            // vresize for two rows
-            unsigned char* Dp0 = dst + stride * dy;
-            unsigned char* Dp1 = dst + stride * (dy + 1);
+void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 1, 1);
+}
 
-            vresize_two(rows0, rows1, w * 2, Dp0, Dp1, ibeta[0], ibeta[1], ibeta[2], ibeta[3]);
+void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 2, 1);
+}
 
-            ibeta += 4;
-            dy += 1;
-        }
-        else
-        {
-            // vresize
-            unsigned char* Dp = dst + stride * dy;
+void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 3, 1);
+}
 
-            vresize_one(rows0, rows1, w * 2, Dp, ibeta[0], ibeta[1]);
+void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 4, 1);
+}
 
-            ibeta += 2;
-        }
-    }
+void resize_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 1, opt.num_threads);
+}
 
-    delete[] buf;
+void resize_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 2, opt.num_threads);
 }
 
-void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+void resize_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
 {
-    const int INTER_RESIZE_COEF_BITS = 11;
-    const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 3, opt.num_threads);
+}
 
-    double scale_x = (double)srcw / w;
-    double scale_y = (double)srch / h;
+void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bilinear_image(src, srcw, srch, srcstride, dst, w, h, stride, 4, opt.num_threads);
+}
 
-    int* buf = new int[w + h + w + h];
+void resize_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    // assert srcw % 2 == 0
+    // assert srch % 2 == 0
+    // assert w % 2 == 0
+    // assert h % 2 == 0
 
-    int* xofs = buf;     //new int[w];
-    int* yofs = buf + w; //new int[h];
+    const unsigned char* srcY = src;
+    unsigned char* dstY = dst;
+    resize_bilinear_c1(srcY, srcw, srch, dstY, w, h);
 
-    short* ialpha = (short*)(buf + w + h);    //new short[w * 2];
-    short* ibeta = (short*)(buf + w + h + w); //new short[h * 2];
+    const unsigned char* srcUV = src + srcw * srch;
+    unsigned char* dstUV = dst + w * h;
+    resize_bilinear_c2(srcUV, srcw / 2, srch / 2, dstUV, w / 2, h / 2);
+}
+
+// bicubic weights with A = -0.75 as the Interp layer, the taps sx-1 .. sx+2 are clamped to the border
+// and folded into four consecutive source pixels starting at ofs
+static void resize_bicubic_coeffs(int srcsize, int dstsize, int* ofs, short* coeffs)
+{
+    const int INTER_RESIZE_COEF_BITS = 11;
+    const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
 
-    float fx;
-    float fy;
-    int sx;
-    int sy;
+    const float A = -0.75f;
 
-#define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X + (X >= 0.f ? 0.5f : -0.5f)), SHRT_MIN), SHRT_MAX);
+    double scale = (double)srcsize / dstsize;
 
-    for (int dx = 0; dx < w; dx++)
+    for (int dx = 0; dx < dstsize; dx++)
     {
-        fx = (float)((dx + 0.5) * scale_x - 0.5);
-        sx = static_cast<int>(floor(fx));
+        float fx = (float)((dx + 0.5) * scale - 0.5);
+        int sx = static_cast<int>(floor(fx));
         fx -= sx;
 
-        if (sx < 0)
-        {
-            sx = 0;
-            fx = 0.f;
-        }
-        if (sx >= srcw - 1)
+        float c[4];
+        c[0] = ((A * (fx + 1) - 5 * A) * (fx + 1) + 8 * A) * (fx + 1) - 4 * A;
+        c[1] = ((A + 2) * fx - (A + 3)) * fx * fx + 1;
+        c[2] = ((A + 2) * (1 - fx) - (A + 3)) * (1 - fx) * (1 - fx) + 1;
+        c[3] = 1.f - c[0] - c[1] - c[2];
+
+        int x0 = std::min(std::max(sx - 1, 0), std::max(srcsize - 4, 0));
+
+        float a[4] = {0.f, 0.f, 0.f, 0.f};
+        for (int k = 0; k < 4; k++)
         {
-            sx = srcw - 2;
-            fx = 1.f;
+            int x = std::min(std::max(sx - 1 + k, 0), srcsize - 1);
+            a[x - x0] += c[k];
         }
 
-        xofs[dx] = sx * 3;
+        ofs[dx] = x0;
 
-        float a0 = (1.f - fx) * INTER_RESIZE_COEF_SCALE;
-        float a1 = fx * INTER_RESIZE_COEF_SCALE;
-
-        ialpha[dx * 2] = SATURATE_CAST_SHORT(a0);
-        ialpha[dx * 2 + 1] = SATURATE_CAST_SHORT(a1);
+        // the largest weight takes the rounding error so that the fixed-point weights sum up to one
+        int sum = 0;
+        int kmax = 0;
+        for (int k = 0; k < 4; k++)
+        {
+            coeffs[dx * 4 + k] = (short)floor(a[k] * INTER_RESIZE_COEF_SCALE + 0.5f);
+            sum += coeffs[dx * 4 + k];
+            if (a[k] > a[kmax])
+                kmax = k;
+        }
+        coeffs[dx * 4 + kmax] += INTER_RESIZE_COEF_SCALE - sum;
     }
+}
 
-    for (int dy = 0; dy < h; dy++)
-    {
-        fy = (float)((dy + 0.5) * scale_y - 0.5);
-        sy = static_cast<int>(floor(fy));
-        fy -= sy;
+static void hresize_bicubic(const unsigned char* S, short* rows, int w, int elempack, const int* xofs, const short* ialpha)
+{
+    int dx = 0;
+#if __SSE2__
+    __m128i _zero = _mm_setzero_si128();
+    __m128i _v16 = _mm_set1_epi32(16);
+#endif // __SSE2__
 
-        if (sy < 0)
+    if (elempack == 1)
+    {
+#if __SSE2__
+        for (; dx + 3 < w; dx += 4)
         {
-            sy = 0;
-            fy = 0.f;
+            int s0;
+            int s1;
+            int s2;
+            int s3;
+            memcpy(&s0, S + xofs[dx], 4);
+            memcpy(&s1, S + xofs[dx + 1], 4);
+            memcpy(&s2, S + xofs[dx + 2], 4);
+            memcpy(&s3, S + xofs[dx + 3], 4);
+
+            __m128i _S = _mm_setr_epi32(s0, s1, s2, s3);
+            __m128i _a01 = _mm_loadu_si128((const __m128i*)(ialpha + dx * 4));
+            __m128i _a23 = _mm_loadu_si128((const __m128i*)(ialpha + dx * 4 + 8));
+            __m128i _sum01 = _mm_madd_epi16(_mm_unpacklo_epi8(_S, _zero), _a01);
+            __m128i _sum23 = _mm_madd_epi16(_mm_unpackhi_epi8(_S, _zero), _a23);
+
+            // add the two partial sums of each pixel
+            __m128 _even = _mm_shuffle_ps(_mm_castsi128_ps(_sum01), _mm_castsi128_ps(_sum23), _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 _odd = _mm_shuffle_ps(_mm_castsi128_ps(_sum01), _mm_castsi128_ps(_sum23), _MM_SHUFFLE(3, 1, 3, 1));
+            __m128i _sum = _mm_add_epi32(_mm_castps_si128(_even), _mm_castps_si128(_odd));
+
+            __m128i _rows = _mm_srai_epi32(_mm_add_epi32(_sum, _v16), 5);
+            _mm_storel_epi64((__m128i*)(rows + dx), _mm_packs_epi32(_rows, _rows));
         }
-        if (sy >= srch - 1)
+#endif // __SSE2__
+#if __ARM_NEON
+        for (; dx + 7 < w; dx += 8)
         {
-            sy = srch - 2;
-            fy = 1.f;
-        }
-
-        yofs[dy] = sy;
-
-        float b0 = (1.f - fy) * INTER_RESIZE_COEF_SCALE;
-        float b1 = fy * INTER_RESIZE_COEF_SCALE;
-
-        ibeta[dy * 2] = SATURATE_CAST_SHORT(b0);
-        ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
-    }
-
-#undef SATURATE_CAST_SHORT
+            unsigned char tmp[32];
+            for (int i = 0; i < 8; i++)
+            {
+                memcpy(tmp + i * 4, S + xofs[dx + i], 4);
+            }
 
-    // loop body
-    Mat rowsbuf0(w * 3 + 1, (size_t)2u);
-    Mat rowsbuf1(w * 3 + 1, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
+            uint8x8x4_t _S = vld4_u8(tmp);
+            int16x8x4_t _a = vld4q_s16(ialpha + dx * 4);
 
-    int prev_sy1 = -2;
+            int16x8_t _S0 = vreinterpretq_s16_u16(vmovl_u8(_S.val[0]));
+            int16x8_t _S1 = vreinterpretq_s16_u16(vmovl_u8(_S.val[1]));
+            int16x8_t _S2 = vreinterpretq_s16_u16(vmovl_u8(_S.val[2]));
+            int16x8_t _S3 = vreinterpretq_s16_u16(vmovl_u8(_S.val[3]));
 
-    for (int dy = 0; dy < h; dy++)
-    {
-        sy = yofs[dy];
+            int32x4_t _suml = vmull_s16(vget_low_s16(_S0), vget_low_s16(_a.val[0]));
+            int32x4_t _sumh = vmull_s16(vget_high_s16(_S0), vget_high_s16(_a.val[0]));
+            _suml = vmlal_s16(_suml, vget_low_s16(_S1), vget_low_s16(_a.val[1]));
+            _sumh = vmlal_s16(_sumh, vget_high_s16(_S1), vget_high_s16(_a.val[1]));
+            _suml = vmlal_s16(_suml, vget_low_s16(_S2), vget_low_s16(_a.val[2]));
+            _sumh = vmlal_s16(_sumh, vget_high_s16(_S2), vget_high_s16(_a.val[2]));
+            _suml = vmlal_s16(_suml, vget_low_s16(_S3), vget_low_s16(_a.val[3]));
+            _sumh = vmlal_s16(_sumh, vget_high_s16(_S3), vget_high_s16(_a.val[3]));
 
-        if (sy == prev_sy1)
+            vst1q_s16(rows + dx, vcombine_s16(vrshrn_n_s32(_suml, 5), vrshrn_n_s32(_sumh, 5)));
+        }
+#endif // __ARM_NEON
+        for (; dx < w; dx++)
         {
-            // reuse all rows
+            const unsigned char* Sp = S + xofs[dx];
+            const short* ap = ialpha + dx * 4;
+
+            rows[dx] = (Sp[0] * ap[0] + Sp[1] * ap[1] + Sp[2] * ap[2] + Sp[3] * ap[3] + 16) >> 5;
         }
-        else if (sy == prev_sy1 + 1)
+    }
+    if (elempack == 2)
+    {
+#if __SSE2__
+        for (; dx + 1 < w; dx += 2)
         {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            __m128i _sum[2];
+            for (int k = 0; k < 2; k++)
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
+                __m128i _S = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(S + xofs[dx + k] * 2)), _zero);
 
-                const unsigned char* S1p = S1 + sx;
-#if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-                _S1 = vld1_lane_u8(S1p + 4, _S1, 4);
-                _S1 = vld1_lane_u8(S1p + 5, _S1, 5);
-
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S1high = vext_s16(_S1low, vget_high_s16(_S116), 3);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows1p, _rows1_sr4);
-#else
-                rows1p[0] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
-#endif // __ARM_NEON
+                // c0 c1 c0' c1' to c0 c0' c1 c1'
+                _S = _mm_shufflelo_epi16(_S, _MM_SHUFFLE(3, 1, 2, 0));
+                _S = _mm_shufflehi_epi16(_S, _MM_SHUFFLE(3, 1, 2, 0));
 
-                ialphap += 2;
-                rows1p += 3;
+                __m128i _a = _mm_loadl_epi64((const __m128i*)(ialpha + (dx + k) * 4));
+                _a = _mm_unpacklo_epi32(_a, _a);
+
+                _sum[k] = _mm_madd_epi16(_S, _a);
+                _sum[k] = _mm_add_epi32(_sum[k], _mm_srli_si128(_sum[k], 8));
             }
+
+            __m128i _rows = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi64(_sum[0], _sum[1]), _v16), 5);
+            _mm_storel_epi64((__m128i*)(rows + dx * 2), _mm_packs_epi32(_rows, _rows));
         }
-        else
+#endif // __SSE2__
+#if __ARM_NEON
+        for (; dx + 1 < w; dx += 2)
         {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            int32x2_t _sum[2];
+            for (int k = 0; k < 2; k++)
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
-
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
-#if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S0 = uint8x8_t();
-                uint8x8_t _S1 = uint8x8_t();
-
-                _S0 = vld1_lane_u8(S0p, _S0, 0);
-                _S0 = vld1_lane_u8(S0p + 1, _S0, 1);
-                _S0 = vld1_lane_u8(S0p + 2, _S0, 2);
-                _S0 = vld1_lane_u8(S0p + 3, _S0, 3);
-                _S0 = vld1_lane_u8(S0p + 4, _S0, 4);
-                _S0 = vld1_lane_u8(S0p + 5, _S0, 5);
-
-                _S1 = vld1_lane_u8(S1p, _S1, 0);
-                _S1 = vld1_lane_u8(S1p + 1, _S1, 1);
-                _S1 = vld1_lane_u8(S1p + 2, _S1, 2);
-                _S1 = vld1_lane_u8(S1p + 3, _S1, 3);
-                _S1 = vld1_lane_u8(S1p + 4, _S1, 4);
-                _S1 = vld1_lane_u8(S1p + 5, _S1, 5);
-
-                int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S0low = vget_low_s16(_S016);
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S0high = vext_s16(_S0low, vget_high_s16(_S016), 3);
-                int16x4_t _S1high = vext_s16(_S1low, vget_high_s16(_S116), 3);
-                int32x4_t _rows0 = vmull_s16(_S0low, _a0);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows0 = vmlal_s16(_rows0, _S0high, _a1);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows0_sr4 = vshrn_n_s32(_rows0, 4);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows0p, _rows0_sr4);
-                vst1_s16(rows1p, _rows1_sr4);
-#else
-                rows0p[0] = (S0p[0] * a0 + S0p[3] * a1) >> 4;
-                rows0p[1] = (S0p[1] * a0 + S0p[4] * a1) >> 4;
-                rows0p[2] = (S0p[2] * a0 + S0p[5] * a1) >> 4;
-                rows1p[0] = (S1p[0] * a0 + S1p[3] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[4] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[5] * a1) >> 4;
-#endif // __ARM_NEON
+                int16x8_t _S = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(S + xofs[dx + k] * 2)));
+                int16x4_t _a = vld1_s16(ialpha + (dx + k) * 4);
+                int16x4x2_t _aa = vzip_s16(_a, _a);
 
-                ialphap += 2;
-                rows0p += 3;
-                rows1p += 3;
+                int32x4_t _s = vmull_s16(vget_low_s16(_S), _aa.val[0]);
+                _s = vmlal_s16(_s, vget_high_s16(_S), _aa.val[1]);
+                _sum[k] = vadd_s32(vget_low_s32(_s), vget_high_s32(_s));
             }
-        }
 
-        prev_sy1 = sy;
+            vst1_s16(rows + dx * 2, vrshrn_n_s32(vcombine_s32(_sum[0], _sum[1]), 5));
+        }
+#endif // __ARM_NEON
+        for (; dx < w; dx++)
+        {
+            const unsigned char* Sp = S + xofs[dx] * 2;
+            const short* ap = ialpha + dx * 4;
 
-        if (dy + 1 < h && yofs[dy + 1] == sy)
+            rows[dx * 2] = (Sp[0] * ap[0] + Sp[2] * ap[1] + Sp[4] * ap[2] + Sp[6] * ap[3] + 16) >> 5;
+            rows[dx * 2 + 1] = (Sp[1] * ap[0] + Sp[3] * ap[1] + Sp[5] * ap[2] + Sp[7] * ap[3] + 16) >> 5;
+        }
+    }
+    if (elempack == 3)
+    {
+#if __SSE2__
+        for (; dx + 1 < w; dx += 2)
         {
-            // vresize for two rows
-            unsigned char* Dp0 = dst + stride * dy;
-            unsigned char* Dp1 = dst + stride * (dy + 1);
+            __m128i _sum[2];
+            for (int k = 0; k < 2; k++)
+            {
+                const unsigned char* Sp = S + xofs[dx + k] * 3;
+
+                int s[3];
+                memcpy(s, Sp, 12);
+                __m128i _S = _mm_setr_epi32(s[0], s[1], s[2], 0);
+                __m128i _Sl = _mm_unpacklo_epi8(_S, _zero);
+                __m128i _Sh = _mm_unpackhi_epi8(_S, _zero);
+
+                // c0 c1 c2 c0' c1' c2' to c0 c0' c1 c1' c2 c2'
+                __m128i _S01 = _mm_unpacklo_epi16(_Sl, _mm_srli_si128(_Sl, 6));
+                __m128i _S23 = _mm_or_si128(_mm_srli_si128(_Sl, 12), _mm_slli_si128(_Sh, 4));
+                _S23 = _mm_unpacklo_epi16(_S23, _mm_srli_si128(_S23, 6));
+
+                int a01;
+                int a23;
+                memcpy(&a01, ialpha + (dx + k) * 4, 4);
+                memcpy(&a23, ialpha + (dx + k) * 4 + 2, 4);
+
+                _sum[k] = _mm_add_epi32(_mm_madd_epi16(_S01, _mm_set1_epi32(a01)), _mm_madd_epi16(_S23, _mm_set1_epi32(a23)));
+                _sum[k] = _mm_srai_epi32(_mm_add_epi32(_sum[k], _v16), 5);
+            }
 
-            vresize_two(rows0, rows1, w * 3, Dp0, Dp1, ibeta[0], ibeta[1], ibeta[2], ibeta[3]);
+            __m128i _rows = _mm_packs_epi32(_sum[0], _sum[1]);
 
-            ibeta += 4;
-            dy += 1;
+            // the fourth short is overwritten by the next pixel
+            _mm_storel_epi64((__m128i*)(rows + dx * 3), _rows);
+            _mm_storel_epi64((__m128i*)(rows + dx * 3 + 3), _mm_srli_si128(_rows, 8));
         }
-        else
+#endif // __SSE2__
+#if __ARM_NEON
+        for (; dx < w; dx++)
         {
-            // vresize
-            unsigned char* Dp = dst + stride * dy;
-
-            vresize_one(rows0, rows1, w * 3, Dp, ibeta[0], ibeta[1]);
+            const short* ap = ialpha + dx * 4;
+
+            unsigned char tmp[16];
+            memcpy(tmp, S + xofs[dx] * 3, 12);
+            uint8x16_t _S = vld1q_u8(tmp);
+            int16x8_t _Sl = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(_S)));
+            int16x8_t _Sh = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(_S)));
+
+            int16x4_t _S0 = vget_low_s16(_Sl);
+            int16x4_t _S1 = vext_s16(vget_low_s16(_Sl), vget_high_s16(_Sl), 3);
+            int16x4_t _S2 = vext_s16(vget_high_s16(_Sl), vget_low_s16(_Sh), 2);
+            int16x4_t _S3 = vext_s16(vget_low_s16(_Sh), vget_high_s16(_Sh), 1);
+
+            int32x4_t _sum = vmull_n_s16(_S0, ap[0]);
+            _sum = vmlal_n_s16(_sum, _S1, ap[1]);
+            _sum = vmlal_n_s16(_sum, _S2, ap[2]);
+            _sum = vmlal_n_s16(_sum, _S3, ap[3]);
+
+            // the fourth short is overwritten by the next pixel
+            vst1_s16(rows + dx * 3, vrshrn_n_s32(_sum, 5));
+        }
+#endif // __ARM_NEON
+        for (; dx < w; dx++)
+        {
+            const unsigned char* Sp = S + xofs[dx] * 3;
+            const short* ap = ialpha + dx * 4;
 
-            ibeta += 2;
+            rows[dx * 3] = (Sp[0] * ap[0] + Sp[3] * ap[1] + Sp[6] * ap[2] + Sp[9] * ap[3] + 16) >> 5;
+            rows[dx * 3 + 1] = (Sp[1] * ap[0] + Sp[4] * ap[1] + Sp[7] * ap[2] + Sp[10] * ap[3] + 16) >> 5;
+            rows[dx * 3 + 2] = (Sp[2] * ap[0] + Sp[5] * ap[1] + Sp[8] * ap[2] + Sp[11] * ap[3] + 16) >> 5;
         }
     }
+    if (elempack == 4)
+    {
+#if __SSE2__
+        for (; dx + 1 < w; dx += 2)
+        {
+            __m128i _sum[2];
+            for (int k = 0; k < 2; k++)
+            {
+                __m128i _S = _mm_loadu_si128((const __m128i*)(S + xofs[dx + k] * 4));
+                __m128i _Sl = _mm_unpacklo_epi8(_S, _zero);
+                __m128i _Sh = _mm_unpackhi_epi8(_S, _zero);
 
-    delete[] buf;
+                // c0 c1 c2 c3 c0' c1' c2' c3' to c0 c0' c1 c1' c2 c2' c3 c3'
+                __m128i _S01 = _mm_unpacklo_epi16(_Sl, _mm_srli_si128(_Sl, 8));
+                __m128i _S23 = _mm_unpacklo_epi16(_Sh, _mm_srli_si128(_Sh, 8));
+
+                int a01;
+                int a23;
+                memcpy(&a01, ialpha + (dx + k) * 4, 4);
+                memcpy(&a23, ialpha + (dx + k) * 4 + 2, 4);
+
+                _sum[k] = _mm_add_epi32(_mm_madd_epi16(_S01, _mm_set1_epi32(a01)), _mm_madd_epi16(_S23, _mm_set1_epi32(a23)));
+                _sum[k] = _mm_srai_epi32(_mm_add_epi32(_sum[k], _v16), 5);
+            }
+
+            _mm_storeu_si128((__m128i*)(rows + dx * 4), _mm_packs_epi32(_sum[0], _sum[1]));
+        }
+#endif // __SSE2__
+#if __ARM_NEON
+        for (; dx < w; dx++)
+        {
+            const short* ap = ialpha + dx * 4;
+
+            uint8x16_t _S = vld1q_u8(S + xofs[dx] * 4);
+            int16x8_t _Sl = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(_S)));
+            int16x8_t _Sh = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(_S)));
+
+            int32x4_t _sum = vmull_n_s16(vget_low_s16(_Sl), ap[0]);
+            _sum = vmlal_n_s16(_sum, vget_high_s16(_Sl), ap[1]);
+            _sum = vmlal_n_s16(_sum, vget_low_s16(_Sh), ap[2]);
+            _sum = vmlal_n_s16(_sum, vget_high_s16(_Sh), ap[3]);
+
+            vst1_s16(rows + dx * 4, vrshrn_n_s32(_sum, 5));
+        }
+#endif // __ARM_NEON
+        for (; dx < w; dx++)
+        {
+            const unsigned char* Sp = S + xofs[dx] * 4;
+            const short* ap = ialpha + dx * 4;
+
+            rows[dx * 4] = (Sp[0] * ap[0] + Sp[4] * ap[1] + Sp[8] * ap[2] + Sp[12] * ap[3] + 16) >> 5;
+            rows[dx * 4 + 1] = (Sp[1] * ap[0] + Sp[5] * ap[1] + Sp[9] * ap[2] + Sp[13] * ap[3] + 16) >> 5;
+            rows[dx * 4 + 2] = (Sp[2] * ap[0] + Sp[6] * ap[1] + Sp[10] * ap[2] + Sp[14] * ap[3] + 16) >> 5;
+            rows[dx * 4 + 3] = (Sp[3] * ap[0] + Sp[7] * ap[1] + Sp[11] * ap[2] + Sp[15] * ap[3] + 16) >> 5;
+        }
+    }
 }
 
-void resize_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+static void vresize_bicubic(const short* rows0p, const short* rows1p, const short* rows2p, const short* rows3p, int wsize, unsigned char* Dp, short b0, short b1, short b2, short b3)
 {
-    const int INTER_RESIZE_COEF_BITS = 11;
-    const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
+    int dx = 0;
+#if __ARM_NEON
+    for (; dx + 7 < wsize; dx += 8)
+    {
+        int16x8_t _r0 = vld1q_s16(rows0p + dx);
+        int16x8_t _r1 = vld1q_s16(rows1p + dx);
+        int16x8_t _r2 = vld1q_s16(rows2p + dx);
+        int16x8_t _r3 = vld1q_s16(rows3p + dx);
+
+        int32x4_t _suml = vmull_n_s16(vget_low_s16(_r0), b0);
+        int32x4_t _sumh = vmull_n_s16(vget_high_s16(_r0), b0);
+        _suml = vmlal_n_s16(_suml, vget_low_s16(_r1), b1);
+        _sumh = vmlal_n_s16(_sumh, vget_high_s16(_r1), b1);
+        _suml = vmlal_n_s16(_suml, vget_low_s16(_r2), b2);
+        _sumh = vmlal_n_s16(_sumh, vget_high_s16(_r2), b2);
+        _suml = vmlal_n_s16(_suml, vget_low_s16(_r3), b3);
+        _sumh = vmlal_n_s16(_sumh, vget_high_s16(_r3), b3);
+
+        uint16x8_t _Dp = vcombine_u16(vqmovun_s32(vrshrq_n_s32(_suml, 17)), vqmovun_s32(vrshrq_n_s32(_sumh, 17)));
+        vst1_u8(Dp + dx, vqmovn_u16(_Dp));
+    }
+#endif // __ARM_NEON
+#if __SSE2__
+    __m128i _b0b1 = _mm_setr_epi16(b0, b1, b0, b1, b0, b1, b0, b1);
+    __m128i _b2b3 = _mm_setr_epi16(b2, b3, b2, b3, b2, b3, b2, b3);
+    __m128i _round = _mm_set1_epi32(1 << 16);
+    for (; dx + 7 < wsize; dx += 8)
+    {
+        __m128i _r0 = _mm_loadu_si128((const __m128i*)(rows0p + dx));
+        __m128i _r1 = _mm_loadu_si128((const __m128i*)(rows1p + dx));
+        __m128i _r2 = _mm_loadu_si128((const __m128i*)(rows2p + dx));
+        __m128i _r3 = _mm_loadu_si128((const __m128i*)(rows3p + dx));
+
+        __m128i _suml = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(_r0, _r1), _b0b1), _mm_madd_epi16(_mm_unpacklo_epi16(_r2, _r3), _b2b3));
+        __m128i _sumh = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(_r0, _r1), _b0b1), _mm_madd_epi16(_mm_unpackhi_epi16(_r2, _r3), _b2b3));
+        _suml = _mm_srai_epi32(_mm_add_epi32(_suml, _round), 17);
+        _sumh = _mm_srai_epi32(_mm_add_epi32(_sumh, _round), 17);
+
+        __m128i _Dp = _mm_packs_epi32(_suml, _sumh);
+        _mm_storel_epi64((__m128i*)(Dp + dx), _mm_packus_epi16(_Dp, _Dp));
+    }
+#endif // __SSE2__
+    for (; dx < wsize; dx++)
+    {
+        int sum = rows0p[dx] * b0 + rows1p[dx] * b1 + rows2p[dx] * b2 + rows3p[dx] * b3;
 
-    double scale_x = (double)srcw / w;
-    double scale_y = (double)srch / h;
+        Dp[dx] = (unsigned char)std::min(std::max((sum + (1 << 16)) >> 17, 0), 255);
+    }
+}
 
-    int* buf = new int[w + h + w + h];
+// the slot of the row cache that holds the hresized source row sy,
+// or a slot holding none of the rows in need that the caller shall hresize sy into
+static int resize_rows_cache_slot(const int* rows_sy, int nslots, int sy, const int* need, int nneed)
+{
+    for (int j = 0; j < nslots; j++)
+    {
+        if (rows_sy[j] == sy)
+            return j;
+    }
+
+    for (int j = 0; j < nslots; j++)
+    {
+        bool needed = false;
+        for (int k = 0; k < nneed; k++)
+        {
+            if (rows_sy[j] == need[k])
+                needed = true;
+        }
+
+        if (!needed)
+            return j;
+    }
+
+    // unreachable as long as nslots >= nneed
+    return 0;
+}
+
+static void resize_bicubic_image(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int elempack, int num_threads)
+{
+    // the horizontal kernel reads four pixels from the window start, replicate the border of narrow images
+    Mat srcpad;
+    if (srcw < 4)
+    {
+        srcpad.create(4 * elempack, srch, (size_t)1u);
+
+        for (int y = 0; y < srch; y++)
+        {
+            const unsigned char* ptr = src + srcstride * y;
+            unsigned char* outptr = srcpad.row<unsigned char>(y);
+
+            for (int x = 0; x < 4; x++)
+            {
+                memcpy(outptr + x * elempack, ptr + std::min(x, srcw - 1) * elempack, elempack);
+            }
+        }
+
+        src = srcpad;
+        srcstride = 4 * elempack;
+    }
+
+    int* buf = new int[w + h + w * 2 + h * 2];
 
     int* xofs = buf;     //new int[w];
     int* yofs = buf + w; //new int[h];
 
-    short* ialpha = (short*)(buf + w + h);    //new short[w * 2];
-    short* ibeta = (short*)(buf + w + h + w); //new short[h * 2];
+    short* ialpha = (short*)(buf + w + h);        //new short[w * 4];
+    short* ibeta = (short*)(buf + w + h + w * 2); //new short[h * 4];
 
-    float fx;
-    float fy;
-    int sx;
-    int sy;
+    resize_bicubic_coeffs(srcw, w, xofs, ialpha);
+    resize_bicubic_coeffs(srch, h, yofs, ibeta);
 
-#define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X + (X >= 0.f ? 0.5f : -0.5f)), SHRT_MIN), SHRT_MAX);
+    // each thread takes a band of output rows and keeps its own hresized source rows
+    const int nT = std::max(1, std::min(num_threads, h));
 
-    for (int dx = 0; dx < w; dx++)
+    #pragma omp parallel for num_threads(nT)
+    for (int ti = 0; ti < nT; ti++)
     {
-        fx = (float)((dx + 0.5) * scale_x - 0.5);
-        sx = static_cast<int>(floor(fx));
-        fx -= sx;
+        const int y0 = h * ti / nT;
+        const int y1 = h * (ti + 1) / nT;
 
-        if (sx < 0)
+        // the simd hresize may store one short past the row end
+        Mat rowsbuf(w * elempack + 2, 4, (size_t)2u);
+
+        int rows_sy[4] = {-1, -1, -1, -1};
+
+        for (int dy = y0; dy < y1; dy++)
         {
-            sx = 0;
-            fx = 0.f;
+            // rows beyond the bottom border only appear with zero weight
+            int sy[4];
+            for (int k = 0; k < 4; k++)
+            {
+                sy[k] = std::min(yofs[dy] + k, srch - 1);
+            }
+
+            const short* rows[4];
+            for (int k = 0; k < 4; k++)
+            {
+                int j = resize_rows_cache_slot(rows_sy, 4, sy[k], sy, 4);
+                if (rows_sy[j] != sy[k])
+                {
+                    hresize_bicubic(src + srcstride * sy[k], rowsbuf.row<short>(j), w, elempack, xofs, ialpha);
+                    rows_sy[j] = sy[k];
+                }
+
+                rows[k] = rowsbuf.row<const short>(j);
+            }
+
+            const short* bp = ibeta + dy * 4;
+            vresize_bicubic(rows[0], rows[1], rows[2], rows[3], w * elempack, dst + stride * dy, bp[0], bp[1], bp[2], bp[3]);
         }
-        if (sx >= srcw - 1)
+    }
+
+    delete[] buf;
+}
+
+static int resize_area_maxtaps(int srcsize, int dstsize)
+{
+    if (srcsize <= dstsize)
+        return 2;
+
+    return (srcsize + dstsize - 1) / dstsize + 2;
+}
+
+// area weights of the source pixels covered by each destination pixel as opencv INTER_AREA,
+// when enlarging only the two nearest source pixels are blended at the cell edge
+static void resize_area_coeffs(int srcsize, int dstsize, int maxtaps, int* ofs, int* ntaps, short* coeffs)
+{
+    const int INTER_RESIZE_COEF_BITS = 11;
+    const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
+
+    double scale = (double)srcsize / dstsize;
+
+    float* a = new float[maxtaps];
+
+    for (int dx = 0; dx < dstsize; dx++)
+    {
+        int x0 = 0;
+        int n = 0;
+
+        if (srcsize > dstsize)
         {
-            sx = srcw - 2;
-            fx = 1.f;
+            double fsx1 = dx * scale;
+            double fsx2 = fsx1 + scale;
+            double cellWidth = std::min(scale, srcsize - fsx1);
+
+            int sx1 = (int)ceil(fsx1);
+            int sx2 = (int)floor(fsx2);
+
+            sx2 = std::min(sx2, srcsize - 1);
+            sx1 = std::min(sx1, sx2);
+
+            x0 = sx1;
+            if (sx1 - fsx1 > 1e-3)
+            {
+                x0 = sx1 - 1;
+                a[n++] = (float)((sx1 - fsx1) / cellWidth);
+            }
+
+            for (int sx = sx1; sx < sx2; sx++)
+            {
+                a[n++] = (float)(1.0 / cellWidth);
+            }
+
+            if (fsx2 - sx2 > 1e-3)
+            {
+                a[n++] = (float)(std::min(std::min(fsx2 - sx2, 1.), cellWidth) / cellWidth);
+            }
         }
+        else
+        {
+            int sx = (int)floor(dx * scale);
+            float fx = (float)((dx + 1) - (sx + 1) / scale);
+            fx = fx <= 0 ? 0.f : fx - (float)floor(fx);
 
-        xofs[dx] = sx * 4;
+            if (sx >= srcsize - 1)
+            {
+                sx = srcsize - 1;
+                fx = 0.f;
+            }
 
-        float a0 = (1.f - fx) * INTER_RESIZE_COEF_SCALE;
-        float a1 = fx * INTER_RESIZE_COEF_SCALE;
+            x0 = sx;
+            a[n++] = 1.f - fx;
+            if (sx < srcsize - 1)
+            {
+                a[n++] = fx;
+            }
+        }
 
-        ialpha[dx * 2] = SATURATE_CAST_SHORT(a0);
-        ialpha[dx * 2 + 1] = SATURATE_CAST_SHORT(a1);
+        ofs[dx] = x0;
+        ntaps[dx] = n;
+
+        // the largest weight takes the rounding error so that the fixed-point weights sum up to one
+        short* cp = coeffs + dx * maxtaps;
+        int sum = 0;
+        int kmax = 0;
+        for (int k = 0; k < n; k++)
+        {
+            cp[k] = (short)floor(a[k] * INTER_RESIZE_COEF_SCALE + 0.5f);
+            sum += cp[k];
+            if (a[k] > a[kmax])
+                kmax = k;
+        }
+        cp[kmax] += INTER_RESIZE_COEF_SCALE - sum;
+
+        for (int k = n; k < maxtaps; k++)
+        {
+            cp[k] = 0;
+        }
     }
 
-    for (int dy = 0; dy < h; dy++)
+    delete[] a;
+}
+
+static void hresize_area(const unsigned char* S, short* rows, int w, int elempack, const int* xofs, const int* xntaps, const short* ialpha, int maxtaps)
+{
+#if __SSE2__
+    __m128i _zero = _mm_setzero_si128();
+#endif // __SSE2__
+
+    for (int dx = 0; dx < w; dx++)
     {
-        fy = (float)((dy + 0.5) * scale_y - 0.5);
-        sy = static_cast<int>(floor(fy));
-        fy -= sy;
+        const unsigned char* Sp = S + xofs[dx] * elempack;
+        const short* ap = ialpha + dx * maxtaps;
+        const int n = xntaps[dx];
+        short* rowsp = rows + dx * elempack;
+
+        int t = 0;
 
-        if (sy < 0)
+        if (elempack == 1)
         {
-            sy = 0;
-            fy = 0.f;
+            int sum = 0;
+#if __SSE2__
+            __m128i _sum = _mm_setzero_si128();
+            for (; t + 7 < n; t += 8)
+            {
+                __m128i _S = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Sp + t)), _zero);
+                _sum = _mm_add_epi32(_sum, _mm_madd_epi16(_S, _mm_loadu_si128((const __m128i*)(ap + t))));
+            }
+            for (; t + 3 < n; t += 4)
+            {
+                int s;
+                memcpy(&s, Sp + t, 4);
+                __m128i _S = _mm_unpacklo_epi8(_mm_cvtsi32_si128(s), _zero);
+                _sum = _mm_add_epi32(_sum, _mm_madd_epi16(_S, _mm_loadl_epi64((const __m128i*)(ap + t))));
+            }
+            _sum = _mm_add_epi32(_sum, _mm_srli_si128(_sum, 8));
+            _sum = _mm_add_epi32(_sum, _mm_srli_si128(_sum, 4));
+            sum += _mm_cvtsi128_si32(_sum);
+#endif // __SSE2__
+#if __ARM_NEON
+            int32x4_t _sum = vdupq_n_s32(0);
+            for (; t + 7 < n; t += 8)
+            {
+                int16x8_t _S = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(Sp + t)));
+                int16x8_t _a = vld1q_s16(ap + t);
+                _sum = vmlal_s16(_sum, vget_low_s16(_S), vget_low_s16(_a));
+                _sum = vmlal_s16(_sum, vget_high_s16(_S), vget_high_s16(_a));
+            }
+            int32x2_t _sum2 = vadd_s32(vget_low_s32(_sum), vget_high_s32(_sum));
+            sum += vget_lane_s32(vpadd_s32(_sum2, _sum2), 0);
+#endif // __ARM_NEON
+            for (; t < n; t++)
+            {
+                sum += Sp[t] * ap[t];
+            }
+
+            rowsp[0] = (sum + 8) >> 4;
         }
-        if (sy >= srch - 1)
+        if (elempack == 2)
         {
-            sy = srch - 2;
-            fy = 1.f;
+            int sum0 = 0;
+            int sum1 = 0;
+#if __SSE2__
+            __m128i _sum = _mm_setzero_si128();
+            for (; t + 3 < n; t += 4)
+            {
+                __m128i _S = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Sp + t * 2)), _zero);
+
+                // c0 c1 c0' c1' to c0 c0' c1 c1'
+                _S = _mm_shufflelo_epi16(_S, _MM_SHUFFLE(3, 1, 2, 0));
+                _S = _mm_shufflehi_epi16(_S, _MM_SHUFFLE(3, 1, 2, 0));
+
+                __m128i _a = _mm_loadl_epi64((const __m128i*)(ap + t));
+                _a = _mm_unpacklo_epi32(_a, _a);
+
+                _sum = _mm_add_epi32(_sum, _mm_madd_epi16(_S, _a));
+            }
+            _sum = _mm_add_epi32(_sum, _mm_srli_si128(_sum, 8));
+            sum0 += _mm_cvtsi128_si32(_sum);
+            sum1 += _mm_cvtsi128_si32(_mm_srli_si128(_sum, 4));
+#endif // __SSE2__
+#if __ARM_NEON
+            int32x4_t _sum = vdupq_n_s32(0);
+            for (; t + 3 < n; t += 4)
+            {
+                int16x8_t _S = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(Sp + t * 2)));
+                int16x4_t _a = vld1_s16(ap + t);
+                int16x4x2_t _aa = vzip_s16(_a, _a);
+                _sum = vmlal_s16(_sum, vget_low_s16(_S), _aa.val[0]);
+                _sum = vmlal_s16(_sum, vget_high_s16(_S), _aa.val[1]);
+            }
+            int32x2_t _sum2 = vadd_s32(vget_low_s32(_sum), vget_high_s32(_sum));
+            sum0 += vget_lane_s32(_sum2, 0);
+            sum1 += vget_lane_s32(_sum2, 1);
+#endif // __ARM_NEON
+            for (; t < n; t++)
+            {
+                sum0 += Sp[t * 2] * ap[t];
+                sum1 += Sp[t * 2 + 1] * ap[t];
+            }
+
+            rowsp[0] = (sum0 + 8) >> 4;
+            rowsp[1] = (sum1 + 8) >> 4;
         }
+        if (elempack == 3 || elempack == 4)
+        {
+            int sum[4] = {0, 0, 0, 0};
+#if __SSE2__
+            __m128i _sum = _mm_setzero_si128();
+            if (elempack == 3)
+            {
+                // 8 bytes covers two taps as long as a third tap follows
+                for (; t + 2 < n; t += 2)
+                {
+                    __m128i _S = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Sp + t * 3)), _zero);
+
+                    // c0 c1 c2 c0' c1' c2' to c0 c0' c1 c1' c2 c2'
+                    _S = _mm_unpacklo_epi16(_S, _mm_srli_si128(_S, 6));
+
+                    int a01;
+                    memcpy(&a01, ap + t, 4);
+                    _sum = _mm_add_epi32(_sum, _mm_madd_epi16(_S, _mm_set1_epi32(a01)));
+                }
+            }
+            else
+            {
+                for (; t + 1 < n; t += 2)
+                {
+                    __m128i _S = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(Sp + t * 4)), _zero);
 
-        yofs[dy] = sy;
+                    // c0 c1 c2 c3 c0' c1' c2' c3' to c0 c0' c1 c1' c2 c2' c3 c3'
+                    _S = _mm_unpacklo_epi16(_S, _mm_srli_si128(_S, 8));
 
-        float b0 = (1.f - fy) * INTER_RESIZE_COEF_SCALE;
-        float b1 = fy * INTER_RESIZE_COEF_SCALE;
+                    int a01;
+                    memcpy(&a01, ap + t, 4);
+                    _sum = _mm_add_epi32(_sum, _mm_madd_epi16(_S, _mm_set1_epi32(a01)));
+                }
+            }
+            _mm_storeu_si128((__m128i*)sum, _sum);
+#endif // __SSE2__
+#if __ARM_NEON
+            int32x4_t _sum = vdupq_n_s32(0);
+            if (elempack == 3)
+            {
+                // 8 bytes covers two taps as long as a third tap follows
+                for (; t + 2 < n; t += 2)
+                {
+                    int16x8_t _S = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(Sp + t * 3)));
+                    _sum = vmlal_n_s16(_sum, vget_low_s16(_S), ap[t]);
+                    _sum = vmlal_n_s16(_sum, vext_s16(vget_low_s16(_S), vget_high_s16(_S), 3), ap[t + 1]);
+                }
+            }
+            else
+            {
+                for (; t + 1 < n; t += 2)
+                {
+                    int16x8_t _S = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(Sp + t * 4)));
+                    _sum = vmlal_n_s16(_sum, vget_low_s16(_S), ap[t]);
+                    _sum = vmlal_n_s16(_sum, vget_high_s16(_S), ap[t + 1]);
+                }
+            }
+            vst1q_s32(sum, _sum);
+#endif // __ARM_NEON
+            for (; t < n; t++)
+            {
+                for (int k = 0; k < elempack; k++)
+                {
+                    sum[k] += Sp[t * elempack + k] * ap[t];
+                }
+            }
 
-        ibeta[dy * 2] = SATURATE_CAST_SHORT(b0);
-        ibeta[dy * 2 + 1] = SATURATE_CAST_SHORT(b1);
+            for (int k = 0; k < elempack; k++)
+            {
+                rowsp[k] = (sum[k] + 8) >> 4;
+            }
+        }
     }
+}
 
-#undef SATURATE_CAST_SHORT
+static void vresize_area_accumulate(const short* rows0p, const short* rows1p, int wsize, int* accp, short b0, short b1)
+{
+    int dx = 0;
+#if __ARM_NEON
+    for (; dx + 7 < wsize; dx += 8)
+    {
+        int16x8_t _r0 = vld1q_s16(rows0p + dx);
+        int16x8_t _r1 = vld1q_s16(rows1p + dx);
+        int32x4_t _accl = vld1q_s32(accp + dx);
+        int32x4_t _acch = vld1q_s32(accp + dx + 4);
+        _accl = vmlal_n_s16(_accl, vget_low_s16(_r0), b0);
+        _acch = vmlal_n_s16(_acch, vget_high_s16(_r0), b0);
+        _accl = vmlal_n_s16(_accl, vget_low_s16(_r1), b1);
+        _acch = vmlal_n_s16(_acch, vget_high_s16(_r1), b1);
+        vst1q_s32(accp + dx, _accl);
+        vst1q_s32(accp + dx + 4, _acch);
+    }
+#endif // __ARM_NEON
+#if __SSE2__
+    __m128i _b0b1 = _mm_setr_epi16(b0, b1, b0, b1, b0, b1, b0, b1);
+    for (; dx + 7 < wsize; dx += 8)
+    {
+        __m128i _r0 = _mm_loadu_si128((const __m128i*)(rows0p + dx));
+        __m128i _r1 = _mm_loadu_si128((const __m128i*)(rows1p + dx));
+        __m128i _accl = _mm_loadu_si128((const __m128i*)(accp + dx));
+        __m128i _acch = _mm_loadu_si128((const __m128i*)(accp + dx + 4));
+        _accl = _mm_add_epi32(_accl, _mm_madd_epi16(_mm_unpacklo_epi16(_r0, _r1), _b0b1));
+        _acch = _mm_add_epi32(_acch, _mm_madd_epi16(_mm_unpackhi_epi16(_r0, _r1), _b0b1));
+        _mm_storeu_si128((__m128i*)(accp + dx), _accl);
+        _mm_storeu_si128((__m128i*)(accp + dx + 4), _acch);
+    }
+#endif // __SSE2__
+    for (; dx < wsize; dx++)
+    {
+        accp[dx] += rows0p[dx] * b0 + rows1p[dx] * b1;
+    }
+}
+
+static void vresize_area_store(const int* accp, int wsize, unsigned char* Dp)
+{
+    int dx = 0;
+#if __ARM_NEON
+    for (; dx + 7 < wsize; dx += 8)
+    {
+        int32x4_t _accl = vld1q_s32(accp + dx);
+        int32x4_t _acch = vld1q_s32(accp + dx + 4);
+        uint16x8_t _Dp = vcombine_u16(vqmovun_s32(vrshrq_n_s32(_accl, 18)), vqmovun_s32(vrshrq_n_s32(_acch, 18)));
+        vst1_u8(Dp + dx, vqmovn_u16(_Dp));
+    }
+#endif // __ARM_NEON
+#if __SSE2__
+    __m128i _round = _mm_set1_epi32(1 << 17);
+    for (; dx + 7 < wsize; dx += 8)
+    {
+        __m128i _accl = _mm_loadu_si128((const __m128i*)(accp + dx));
+        __m128i _acch = _mm_loadu_si128((const __m128i*)(accp + dx + 4));
+        _accl = _mm_srai_epi32(_mm_add_epi32(_accl, _round), 18);
+        _acch = _mm_srai_epi32(_mm_add_epi32(_acch, _round), 18);
+        __m128i _Dp = _mm_packs_epi32(_accl, _acch);
+        _mm_storel_epi64((__m128i*)(Dp + dx), _mm_packus_epi16(_Dp, _Dp));
+    }
+#endif // __SSE2__
+    for (; dx < wsize; dx++)
+    {
+        Dp[dx] = (unsigned char)std::min(std::max((accp[dx] + (1 << 17)) >> 18, 0), 255);
+    }
+}
+
+static void resize_area_image(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int elempack, int num_threads)
+{
+    const int xmaxtaps = resize_area_maxtaps(srcw, w);
+    const int ymaxtaps = resize_area_maxtaps(srch, h);
 
-    // loop body
-    Mat rowsbuf0(w * 4, (size_t)2u);
-    Mat rowsbuf1(w * 4, (size_t)2u);
-    short* rows0 = (short*)rowsbuf0.data;
-    short* rows1 = (short*)rowsbuf1.data;
+    int* buf = new int[w + w + h + h];
 
-    int prev_sy1 = -2;
+    int* xofs = buf;           //new int[w];
+    int* xntaps = buf + w;     //new int[w];
+    int* yofs = buf + w + w;   //new int[h];
+    int* yntaps = buf + w + w + h; //new int[h];
 
-    for (int dy = 0; dy < h; dy++)
+    short* ialpha = new short[w * xmaxtaps];
+    short* ibeta = new short[h * ymaxtaps];
+
+    resize_area_coeffs(srcw, w, xmaxtaps, xofs, xntaps, ialpha);
+    resize_area_coeffs(srch, h, ymaxtaps, yofs, yntaps, ibeta);
+
+    const int wsize = w * elempack;
+
+    // each thread takes a band of output rows and keeps its own hresized source rows
+    const int nT = std::max(1, std::min(num_threads, h));
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ti = 0; ti < nT; ti++)
     {
-        sy = yofs[dy];
+        const int y0 = h * ti / nT;
+        const int y1 = h * (ti + 1) / nT;
 
-        if (sy == prev_sy1)
+        Mat rowsbuf(wsize, 2, (size_t)2u);
+        Mat accbuf(wsize, (size_t)4u);
+        int* acc = accbuf;
+
+        int rows_sy[2] = {-1, -1};
+
+        for (int dy = y0; dy < y1; dy++)
         {
-            // reuse all rows
+            const int n = yntaps[dy];
+            const short* bp = ibeta + dy * ymaxtaps;
+
+            memset(acc, 0, wsize * sizeof(int));
+
+            // accumulate the source rows two by two, the boundary rows shared with the previous output row are reused
+            for (int t = 0; t < n; t += 2)
+            {
+                int sy[2];
+                sy[0] = yofs[dy] + t;
+                sy[1] = t + 1 < n ? sy[0] + 1 : sy[0];
+
+                const short* rows[2];
+                for (int k = 0; k < 2; k++)
+                {
+                    int j = resize_rows_cache_slot(rows_sy, 2, sy[k], sy, 2);
+                    if (rows_sy[j] != sy[k])
+                    {
+                        hresize_area(src + srcstride * sy[k], rowsbuf.row<short>(j), w, elempack, xofs, xntaps, ialpha, xmaxtaps);
+                        rows_sy[j] = sy[k];
+                    }
+
+                    rows[k] = rowsbuf.row<const short>(j);
+                }
+
+                vresize_area_accumulate(rows[0], rows[1], wsize, acc, bp[t], t + 1 < n ? bp[t + 1] : 0);
+            }
+
+            vresize_area_store(acc, wsize, dst + stride * dy);
         }
-        else if (sy == prev_sy1 + 1)
+    }
+
+    delete[] buf;
+    delete[] ialpha;
+    delete[] ibeta;
+}
+
+void resize_bicubic_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_bicubic_c1(src, srcw, srch, srcw, dst, w, h, w);
+}
+
+void resize_bicubic_c2(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_bicubic_c2(src, srcw, srch, srcw * 2, dst, w, h, w * 2);
+}
+
+void resize_bicubic_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_bicubic_c3(src, srcw, srch, srcw * 3, dst, w, h, w * 3);
+}
+
+void resize_bicubic_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_bicubic_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4);
+}
+
+void resize_bicubic_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 1, 1);
+}
+
+void resize_bicubic_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 2, 1);
+}
+
+void resize_bicubic_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 3, 1);
+}
+
+void resize_bicubic_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 4, 1);
+}
+
+void resize_bicubic_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 1, opt.num_threads);
+}
+
+void resize_bicubic_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 2, opt.num_threads);
+}
+
+void resize_bicubic_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 3, opt.num_threads);
+}
+
+void resize_bicubic_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_bicubic_image(src, srcw, srch, srcstride, dst, w, h, stride, 4, opt.num_threads);
+}
+
+void resize_area_c1(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c1(src, srcw, srch, srcw, dst, w, h, w);
+}
+
+void resize_area_c2(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c2(src, srcw, srch, srcw * 2, dst, w, h, w * 2);
+}
+
+void resize_area_c3(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c3(src, srcw, srch, srcw * 3, dst, w, h, w * 3);
+}
+
+void resize_area_c4(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+{
+    return resize_area_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4);
+}
+
+void resize_area_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 1, 1);
+}
+
+void resize_area_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 2, 1);
+}
+
+void resize_area_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 3, 1);
+}
+
+void resize_area_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 4, 1);
+}
+
+void resize_area_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 1, opt.num_threads);
+}
+
+void resize_area_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 2, opt.num_threads);
+}
+
+void resize_area_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 3, opt.num_threads);
+}
+
+void resize_area_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const Option& opt)
+{
+    resize_area_image(src, srcw, srch, srcstride, dst, w, h, stride, 4, opt.num_threads);
+}
+
+static void yuv420sp2rgb_row(const unsigned char* yptr, const unsigned char* vuptr, int w, int nv12, unsigned char* rgb)
+{
+#define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
+    for (int x = 0; x + 1 < w; x += 2)
+    {
+        // R = (yy + 90 * vv) >> 6
+        // G = (yy - 46 * vv - 22 * uu) >> 6
+        // B = (yy + 113 * uu) >> 6
+        int v = (nv12 ? vuptr[1] : vuptr[0]) - 128;
+        int u = (nv12 ? vuptr[0] : vuptr[1]) - 128;
+
+        int ruv = 90 * v;
+        int guv = -46 * v + -22 * u;
+        int buv = 113 * u;
+
+        int y0 = yptr[0] << 6;
+        rgb[0] = SATURATE_CAST_UCHAR((y0 + ruv) >> 6);
+        rgb[1] = SATURATE_CAST_UCHAR((y0 + guv) >> 6);
+        rgb[2] = SATURATE_CAST_UCHAR((y0 + buv) >> 6);
+
+        int y1 = yptr[1] << 6;
+        rgb[3] = SATURATE_CAST_UCHAR((y1 + ruv) >> 6);
+        rgb[4] = SATURATE_CAST_UCHAR((y1 + guv) >> 6);
+        rgb[5] = SATURATE_CAST_UCHAR((y1 + buv) >> 6);
+
+        yptr += 2;
+        vuptr += 2;
+        rgb += 6;
+    }
+#undef SATURATE_CAST_UCHAR
+}
+
+// component order of pixel format, 0=R 1=G 2=B 3=A 4=gray
+static int pixel_format_components(int format, int* comps)
+{
+    switch (format)
+    {
+    case Mat::PIXEL_RGB:
+        comps[0] = 0;
+        comps[1] = 1;
+        comps[2] = 2;
+        return 3;
+    case Mat::PIXEL_BGR:
+        comps[0] = 2;
+        comps[1] = 1;
+        comps[2] = 0;
+        return 3;
+    case Mat::PIXEL_GRAY:
+        comps[0] = 4;
+        return 1;
+    case Mat::PIXEL_RGBA:
+        comps[0] = 0;
+        comps[1] = 1;
+        comps[2] = 2;
+        comps[3] = 3;
+        return 4;
+    case Mat::PIXEL_BGRA:
+        comps[0] = 2;
+        comps[1] = 1;
+        comps[2] = 0;
+        comps[3] = 3;
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+// map each output channel to the input channel, -1 for gray from rgb, -2 for opaque alpha
+static int pixel_convert_map(int type, int* inch, int* chmap, int* rgbmap)
+{
+    const int type_from = type & Mat::PIXEL_FORMAT_MASK;
+    int type_to = (type & Mat::PIXEL_CONVERT_MASK) >> Mat::PIXEL_CONVERT_SHIFT;
+    if (type_to == 0)
+        type_to = type_from;
+
+    int comps_from[4];
+    int comps_to[4];
+    *inch = pixel_format_components(type_from, comps_from);
+    const int outch = pixel_format_components(type_to, comps_to);
+    if (*inch == 0 || outch == 0)
+        return 0;
+
+    int pos[5] = {-1, -1, -1, -1, -1};
+    for (int i = 0; i < *inch; i++)
+    {
+        pos[comps_from[i]] = i;
+    }
+    if (type_from == Mat::PIXEL_GRAY)
+    {
+        pos[0] = 0;
+        pos[1] = 0;
+        pos[2] = 0;
+    }
+
+    for (int k = 0; k < outch; k++)
+    {
+        const int comp = comps_to[k];
+        if (pos[comp] != -1)
+            chmap[k] = pos[comp];
+        else if (comp == 3)
+            chmap[k] = -2;
+        else
+            chmap[k] = -1;
+    }
+
+    rgbmap[0] = pos[0];
+    rgbmap[1] = pos[1];
+    rgbmap[2] = pos[2];
+
+    return outch;
+}
+
+// gather the interleaved pixel row into output channel order and packing
+static void pixel_convert_row(const unsigned char* ptr, int w, int inch, int outch, const int* chmap, const int* rgbmap, unsigned char* outptr, int elempack)
+{
+    const unsigned char Y_shift = 8; //14
+    const unsigned char R2Y = 77;
+    const unsigned char G2Y = 150;
+    const unsigned char B2Y = 29;
+
+    if (elempack == 1 && inch == 3 && outch == 3 && chmap[0] >= 0 && chmap[1] >= 0 && chmap[2] >= 0)
+    {
+        // rgb bgr shuffle to planar
+        const unsigned char* p0 = ptr + chmap[0];
+        const unsigned char* p1 = ptr + chmap[1];
+        const unsigned char* p2 = ptr + chmap[2];
+        unsigned char* outp0 = outptr;
+        unsigned char* outp1 = outptr + w;
+        unsigned char* outp2 = outptr + w * 2;
+        for (int x = 0; x < w; x++)
         {
-            // hresize one row
-            short* rows0_old = rows0;
-            rows0 = rows1;
-            rows1 = rows0_old;
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
-            {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
+            outp0[x] = p0[x * 3];
+            outp1[x] = p1[x * 3];
+            outp2[x] = p2[x * 3];
+        }
+        return;
+    }
 
-                const unsigned char* S1p = S1 + sx;
-#if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S1 = vld1_u8(S1p);
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S1high = vget_high_s16(_S116);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows1p, _rows1_sr4);
-#else
-                rows1p[0] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
-                rows1p[3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
-#endif // __ARM_NEON
+    for (int k = 0; k < outch; k++)
+    {
+        unsigned char* outp = outptr + (k / elempack) * w * elempack + k % elempack;
 
-                ialphap += 2;
-                rows1p += 4;
+        if (chmap[k] == -2)
+        {
+            for (int x = 0; x < w; x++)
+            {
+                *outp = 255;
+                outp += elempack;
+            }
+        }
+        else if (chmap[k] == -1)
+        {
+            const unsigned char* r = ptr + rgbmap[0];
+            const unsigned char* g = ptr + rgbmap[1];
+            const unsigned char* b = ptr + rgbmap[2];
+            for (int x = 0; x < w; x++)
+            {
+                *outp = (unsigned char)((*r * R2Y + *g * G2Y + *b * B2Y) >> Y_shift);
+                r += inch;
+                g += inch;
+                b += inch;
+                outp += elempack;
             }
         }
         else
         {
-            // hresize two rows
-            const unsigned char* S0 = src + srcstride * (sy);
-            const unsigned char* S1 = src + srcstride * (sy + 1);
-
-            const short* ialphap = ialpha;
-            short* rows0p = rows0;
-            short* rows1p = rows1;
-            for (int dx = 0; dx < w; dx++)
+            const unsigned char* p = ptr + chmap[k];
+            for (int x = 0; x < w; x++)
             {
-                sx = xofs[dx];
-                short a0 = ialphap[0];
-                short a1 = ialphap[1];
+                *outp = *p;
+                p += inch;
+                outp += elempack;
+            }
+        }
+    }
+}
+
+#if __SSE2__
+static inline void normalize_store_sse(__m128 _p, void* outptr, int i, int cast_type)
+{
+    if (cast_type == 1)
+    {
+        _mm_storeu_ps((float*)outptr + i, _p);
+    }
+    else if (cast_type == 4)
+    {
+        // the sign extended high halves pack without saturation
+        __m128i _p16 = _mm_srai_epi32(_mm_castps_si128(_p), 16);
+        _mm_storel_epi64((__m128i*)((unsigned short*)outptr + i), _mm_packs_epi32(_p16, _p16));
+    }
+    else
+    {
+        float tmp[4];
+        _mm_storeu_ps(tmp, _p);
+        unsigned short* outp = (unsigned short*)outptr + i;
+        outp[0] = float32_to_float16(tmp[0]);
+        outp[1] = float32_to_float16(tmp[1]);
+        outp[2] = float32_to_float16(tmp[2]);
+        outp[3] = float32_to_float16(tmp[3]);
+    }
+}
+#endif // __SSE2__
 
-                const unsigned char* S0p = S0 + sx;
-                const unsigned char* S1p = S1 + sx;
 #if __ARM_NEON
-                int16x4_t _a0 = vdup_n_s16(a0);
-                int16x4_t _a1 = vdup_n_s16(a1);
-                uint8x8_t _S0 = vld1_u8(S0p);
-                uint8x8_t _S1 = vld1_u8(S1p);
-                int16x8_t _S016 = vreinterpretq_s16_u16(vmovl_u8(_S0));
-                int16x8_t _S116 = vreinterpretq_s16_u16(vmovl_u8(_S1));
-                int16x4_t _S0low = vget_low_s16(_S016);
-                int16x4_t _S1low = vget_low_s16(_S116);
-                int16x4_t _S0high = vget_high_s16(_S016);
-                int16x4_t _S1high = vget_high_s16(_S116);
-                int32x4_t _rows0 = vmull_s16(_S0low, _a0);
-                int32x4_t _rows1 = vmull_s16(_S1low, _a0);
-                _rows0 = vmlal_s16(_rows0, _S0high, _a1);
-                _rows1 = vmlal_s16(_rows1, _S1high, _a1);
-                int16x4_t _rows0_sr4 = vshrn_n_s32(_rows0, 4);
-                int16x4_t _rows1_sr4 = vshrn_n_s32(_rows1, 4);
-                vst1_s16(rows0p, _rows0_sr4);
-                vst1_s16(rows1p, _rows1_sr4);
+static inline void normalize_store_neon(float32x4_t _p, void* outptr, int i, int cast_type)
+{
+    if (cast_type == 1)
+    {
+        vst1q_f32((float*)outptr + i, _p);
+    }
+    else if (cast_type == 4)
+    {
+        vst1_u16((unsigned short*)outptr + i, vshrn_n_u32(vreinterpretq_u32_f32(_p), 16));
+    }
+    else
+    {
+#if __aarch64__
+        vst1_u16((unsigned short*)outptr + i, vreinterpret_u16_f16(vcvt_f16_f32(_p)));
 #else
-                rows0p[0] = (S0p[0] * a0 + S0p[4] * a1) >> 4;
-                rows0p[1] = (S0p[1] * a0 + S0p[5] * a1) >> 4;
-                rows0p[2] = (S0p[2] * a0 + S0p[6] * a1) >> 4;
-                rows0p[3] = (S0p[3] * a0 + S0p[7] * a1) >> 4;
-                rows1p[0] = (S1p[0] * a0 + S1p[4] * a1) >> 4;
-                rows1p[1] = (S1p[1] * a0 + S1p[5] * a1) >> 4;
-                rows1p[2] = (S1p[2] * a0 + S1p[6] * a1) >> 4;
-                rows1p[3] = (S1p[3] * a0 + S1p[7] * a1) >> 4;
+        float tmp[4];
+        vst1q_f32(tmp, _p);
+        unsigned short* outp = (unsigned short*)outptr + i;
+        outp[0] = float32_to_float16(tmp[0]);
+        outp[1] = float32_to_float16(tmp[1]);
+        outp[2] = float32_to_float16(tmp[2]);
+        outp[3] = float32_to_float16(tmp[3]);
+#endif
+    }
+}
 #endif // __ARM_NEON
 
-                ialphap += 2;
-                rows0p += 4;
-                rows1p += 4;
-            }
-        }
+// outptr[i] = ptr[i] * norm[i % 4] + bias[i % 4] stored as float32 float16 or bfloat16
+static void normalize_pack_row(const unsigned char* ptr, void* outptr, int size, const float* norm4, const float* bias4, int cast_type)
+{
+    int i = 0;
+#if __ARM_NEON
+    float32x4_t _norm = vld1q_f32(norm4);
+    float32x4_t _bias = vld1q_f32(bias4);
+    for (; i + 15 < size; i += 16)
+    {
+        uint8x16_t _p = vld1q_u8(ptr + i);
+        uint16x8_t _p01 = vmovl_u8(vget_low_u8(_p));
+        uint16x8_t _p23 = vmovl_u8(vget_high_u8(_p));
+        float32x4_t _p0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(_p01)));
+        float32x4_t _p1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(_p01)));
+        float32x4_t _p2 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(_p23)));
+        float32x4_t _p3 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(_p23)));
+        _p0 = vmlaq_f32(_bias, _p0, _norm);
+        _p1 = vmlaq_f32(_bias, _p1, _norm);
+        _p2 = vmlaq_f32(_bias, _p2, _norm);
+        _p3 = vmlaq_f32(_bias, _p3, _norm);
+        normalize_store_neon(_p0, outptr, i, cast_type);
+        normalize_store_neon(_p1, outptr, i + 4, cast_type);
+        normalize_store_neon(_p2, outptr, i + 8, cast_type);
+        normalize_store_neon(_p3, outptr, i + 12, cast_type);
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        float tmp[4] = {(float)ptr[i], (float)ptr[i + 1], (float)ptr[i + 2], (float)ptr[i + 3]};
+        float32x4_t _p = vmlaq_f32(_bias, vld1q_f32(tmp), _norm);
+        normalize_store_neon(_p, outptr, i, cast_type);
+    }
+#endif // __ARM_NEON
+#if __SSE2__
+    __m128 _norm = _mm_loadu_ps(norm4);
+    __m128 _bias = _mm_loadu_ps(bias4);
+    __m128i _zero = _mm_setzero_si128();
+    for (; i + 15 < size; i += 16)
+    {
+        __m128i _p = _mm_loadu_si128((const __m128i*)(ptr + i));
+        __m128i _p01 = _mm_unpacklo_epi8(_p, _zero);
+        __m128i _p23 = _mm_unpackhi_epi8(_p, _zero);
+        __m128 _p0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_p01, _zero));
+        __m128 _p1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_p01, _zero));
+        __m128 _p2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_p23, _zero));
+        __m128 _p3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_p23, _zero));
+        _p0 = _mm_add_ps(_mm_mul_ps(_p0, _norm), _bias);
+        _p1 = _mm_add_ps(_mm_mul_ps(_p1, _norm), _bias);
+        _p2 = _mm_add_ps(_mm_mul_ps(_p2, _norm), _bias);
+        _p3 = _mm_add_ps(_mm_mul_ps(_p3, _norm), _bias);
+        normalize_store_sse(_p0, outptr, i, cast_type);
+        normalize_store_sse(_p1, outptr, i + 4, cast_type);
+        normalize_store_sse(_p2, outptr, i + 8, cast_type);
+        normalize_store_sse(_p3, outptr, i + 12, cast_type);
+    }
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = _mm_setr_ps((float)ptr[i], (float)ptr[i + 1], (float)ptr[i + 2], (float)ptr[i + 3]);
+        _p = _mm_add_ps(_mm_mul_ps(_p, _norm), _bias);
+        normalize_store_sse(_p, outptr, i, cast_type);
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        float v = ptr[i] * norm4[i % 4] + bias4[i % 4];
 
-        prev_sy1 = sy;
+        if (cast_type == 1)
+            ((float*)outptr)[i] = v;
+        else if (cast_type == 4)
+            ((unsigned short*)outptr)[i] = float32_to_bfloat16(v);
+        else
+            ((unsigned short*)outptr)[i] = float32_to_float16(v);
+    }
+}
 
-        if (dy + 1 < h && yofs[dy + 1] == sy)
+// yuv420sp 0=none 1=nv21 2=nv12
+static Mat pixel_roi_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, int cast_type, int yuv420sp, const Option& opt)
+{
+    if (roix < 0 || roiy < 0 || roiw <= 0 || roih <= 0 || roix + roiw > w || roiy + roih > h)
+    {
+        NCNN_LOGE("roi %d %d %d %d out of image %d %d", roix, roiy, roiw, roih, w, h);
+        return Mat();
+    }
+
+    if (yuv420sp && (roix % 2 != 0 || roiy % 2 != 0 || roiw % 2 != 0 || roih % 2 != 0 || target_width % 2 != 0 || target_height % 2 != 0))
+    {
+        NCNN_LOGE("yuv420sp roi %d %d %d %d or target size %d %d is not even", roix, roiy, roiw, roih, target_width, target_height);
+        return Mat();
+    }
+
+    // yuv420sp decodes to rgb before the pixel convert
+    const int convert_type = yuv420sp ? Mat::PIXEL_RGB | (type << Mat::PIXEL_CONVERT_SHIFT) : type;
+
+    int inch = 0;
+    int chmap[4];
+    int rgbmap[3];
+    const int outch = pixel_convert_map(convert_type, &inch, chmap, rgbmap);
+    if (outch == 0 || (yuv420sp && (type & Mat::PIXEL_CONVERT_MASK)))
+    {
+        NCNN_LOGE("unknown convert type %d", type);
+        return Mat();
+    }
+
+    if (elempack <= 0 || outch % elempack != 0 || (elempack != 1 && elempack != outch))
+    {
+        NCNN_LOGE("unsupported elempack %d for %d channels", elempack, outch);
+        return Mat();
+    }
+
+    if (cast_type != 1 && cast_type != 2 && cast_type != 4)
+    {
+        NCNN_LOGE("unsupported cast_type %d", cast_type);
+        return Mat();
+    }
+
+    Mat m;
+    m.create(target_width, target_height, outch / elempack, (size_t)(cast_type == 1 ? 4u : 2u) * elempack, elempack, opt.blob_allocator);
+    if (m.empty())
+        return m;
+
+    // out = v * norm + bias, the same arithmetic as substract_mean_normalize
+    float norms[16];
+    float biases[16];
+    for (int q = 0; q < m.c; q++)
+    {
+        for (int k = 0; k < 4; k++)
         {
-            // vresize for two rows
-            unsigned char* Dp0 = dst + stride * dy;
-            unsigned char* Dp1 = dst + stride * (dy + 1);
+            const int p = elempack == 1 ? q : k % elempack;
+            const float norm = norm_vals ? norm_vals[p] : 1.f;
+            const float mean = mean_vals ? mean_vals[p] : 0.f;
+
+            norms[q * 4 + k] = norm;
+            biases[q * 4 + k] = norm_vals ? -mean * norm : -mean;
+        }
+    }
 
-            vresize_two(rows0, rows1, w * 4, Dp0, Dp1, ibeta[0], ibeta[1], ibeta[2], ibeta[3]);
+    // the input pixel row is already in output order and packing
+    bool convert_identity = elempack == outch && inch == outch && !yuv420sp;
+    for (int k = 0; k < outch; k++)
+    {
+        if (chmap[k] != k)
+            convert_identity = false;
+    }
+
+    const bool resize = roiw != target_width || roih != target_height;
+
+    // yuv420sp planes
+    const unsigned char* srcY = pixels + roiy * w + roix;
+    const unsigned char* srcUV = pixels + w * h + roiy / 2 * w + roix;
 
-            ibeta += 4;
-            dy += 1;
+    int* buf = new int[(target_width + target_height) * 3];
+
+    int* xofs = buf;
+    int* yofs = buf + target_width;
+    short* ialpha = (short*)(buf + target_width + target_height);
+    short* ibeta = (short*)(buf + target_width * 2 + target_height);
+    int* xofs_uv = buf + (target_width + target_height) * 2;
+    int* yofs_uv = xofs_uv + target_width / 2;
+    short* ialpha_uv = (short*)(yofs_uv + target_height / 2);
+    short* ibeta_uv = (short*)(yofs_uv + target_height / 2 + target_width / 2);
+
+    if (resize)
+    {
+        resize_bilinear_coeffs(roiw, target_width, xofs, ialpha);
+        resize_bilinear_coeffs(roih, target_height, yofs, ibeta);
+
+        if (yuv420sp)
+        {
+            resize_bilinear_coeffs(roiw / 2, target_width / 2, xofs_uv, ialpha_uv);
+            resize_bilinear_coeffs(roih / 2, target_height / 2, yofs_uv, ibeta_uv);
         }
-        else
+    }
+
+    // each thread takes a band of output rows and keeps its own hresized source rows
+    const int nT = std::max(1, std::min(opt.num_threads, target_height));
+
+    #pragma omp parallel for num_threads(nT)
+    for (int ti = 0; ti < nT; ti++)
+    {
+        const int y0 = target_height * ti / nT;
+        const int y1 = target_height * (ti + 1) / nT;
+
+        const int rowsize = target_width * (yuv420sp ? 1 : inch);
+
+        Mat rowsbuf(rowsize + 2, 4, (size_t)2u);
+        Mat resizedbuf(rowsize, 2, (size_t)1u);
+        Mat rgbbuf(target_width * 3, (size_t)1u);
+        Mat convertbuf(target_width * outch, (size_t)1u);
+
+        short* rows0 = rowsbuf.row<short>(0);
+        short* rows1 = rowsbuf.row<short>(1);
+        short* rows0_uv = rowsbuf.row<short>(2);
+        short* rows1_uv = rowsbuf.row<short>(3);
+        int prev_sy = -2;
+        int prev_sy_uv = -2;
+        int prev_dy_uv = -1;
+
+        for (int dy = y0; dy < y1; dy++)
         {
-            // vresize
-            unsigned char* Dp = dst + stride * dy;
+            const unsigned char* rowptr;
+
+            if (yuv420sp)
+            {
+                const unsigned char* yptr = srcY + w * dy;
+                const unsigned char* vuptr = srcUV + w * (dy / 2);
+
+                if (resize)
+                {
+                    unsigned char* resizedY = resizedbuf.row<unsigned char>(0);
+                    unsigned char* resizedUV = resizedbuf.row<unsigned char>(1);
+
+                    resize_bilinear_row(srcY, w, target_width, 1, xofs, ialpha, yofs[dy], ibeta[dy * 2], ibeta[dy * 2 + 1], rows0, rows1, prev_sy, resizedY);
 
-            vresize_one(rows0, rows1, w * 4, Dp, ibeta[0], ibeta[1]);
+                    const int dy_uv = dy / 2;
+                    if (dy_uv != prev_dy_uv)
+                    {
+                        resize_bilinear_row(srcUV, w, target_width / 2, 2, xofs_uv, ialpha_uv, yofs_uv[dy_uv], ibeta_uv[dy_uv * 2], ibeta_uv[dy_uv * 2 + 1], rows0_uv, rows1_uv, prev_sy_uv, resizedUV);
+                        prev_dy_uv = dy_uv;
+                    }
+
+                    yptr = resizedY;
+                    vuptr = resizedUV;
+                }
+
+                yuv420sp2rgb_row(yptr, vuptr, target_width, yuv420sp == 2, rgbbuf);
+
+                rowptr = rgbbuf;
+            }
+            else if (resize)
+            {
+                unsigned char* resized = resizedbuf.row<unsigned char>(0);
+
+                const unsigned char* src = pixels + roiy * stride + roix * inch;
+                resize_bilinear_row(src, stride, target_width, inch, xofs, ialpha, yofs[dy], ibeta[dy * 2], ibeta[dy * 2 + 1], rows0, rows1, prev_sy, resized);
+
+                rowptr = resized;
+            }
+            else
+            {
+                rowptr = pixels + (roiy + dy) * stride + roix * inch;
+            }
+
+            if (!convert_identity)
+            {
+                pixel_convert_row(rowptr, target_width, inch, outch, chmap, rgbmap, convertbuf, elempack);
+
+                rowptr = convertbuf;
+            }
 
-            ibeta += 2;
+            for (int q = 0; q < m.c; q++)
+            {
+                normalize_pack_row(rowptr + q * target_width * elempack, m.channel(q).row(dy), target_width * elempack, norms + q * 4, biases + q * 4, cast_type);
+            }
         }
     }
 
     delete[] buf;
+
+    return m;
 }
 
-void resize_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h)
+Mat Mat::from_pixels_roi_resize_normalize(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, int cast_type, const Option& opt)
 {
-    // assert srcw % 2 == 0
-    // assert srch % 2 == 0
-    // assert w % 2 == 0
-    // assert h % 2 == 0
+    int type_from = type & PIXEL_FORMAT_MASK;
 
-    const unsigned char* srcY = src;
-    unsigned char* dstY = dst;
-    resize_bilinear_c1(srcY, srcw, srch, dstY, w, h);
+    if (type_from == PIXEL_RGB || type_from == PIXEL_BGR)
+    {
+        return Mat::from_pixels_roi_resize_normalize(pixels, type, w, h, w * 3, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, opt);
+    }
+    else if (type_from == PIXEL_GRAY)
+    {
+        return Mat::from_pixels_roi_resize_normalize(pixels, type, w, h, w * 1, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, opt);
+    }
+    else if (type_from == PIXEL_RGBA || type_from == PIXEL_BGRA)
+    {
+        return Mat::from_pixels_roi_resize_normalize(pixels, type, w, h, w * 4, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, opt);
+    }
 
-    const unsigned char* srcUV = src + srcw * srch;
-    unsigned char* dstUV = dst + w * h;
-    resize_bilinear_c2(srcUV, srcw / 2, srch / 2, dstUV, w / 2, h / 2);
+    // unknown convert type
+    NCNN_LOGE("unknown convert type %d", type);
+    return Mat();
+}
+
+Mat Mat::from_pixels_roi_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, int cast_type, const Option& opt)
+{
+    return pixel_roi_resize_normalize(pixels, type, w, h, stride, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, 0, opt);
+}
+
+Mat Mat::from_yuv420sp_roi_resize_normalize(const unsigned char* yuv420sp, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, int cast_type, const Option& opt)
+{
+    return pixel_roi_resize_normalize(yuv420sp, type, w, h, w, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, 1, opt);
+}
+
+Mat Mat::from_yuv420sp_nv12_roi_resize_normalize(const unsigned char* yuv420sp, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, int cast_type, const Option& opt)
+{
+    return pixel_roi_resize_normalize(yuv420sp, type, w, h, w, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, 2, opt);
 }
 #endif // NCNN_PIXEL
 
@@ -3,20 +3,23 @@
 
 #include "net.h"
 
+#include "benchmark.h"
 #include "cpu.h"
 #include "datareader.h"
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
+#include "weightcache.h"
+
+#include "layer/convolution.h"
+#include "layer/gemm.h"
+#include "layer/innerproduct.h"
+#include "layer/multiheadattention.h"
 
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
 
-#if NCNN_BENCHMARK
-#include "benchmark.h"
-#endif // NCNN_BENCHMARK
-
 #if NCNN_VULKAN
 #include "command.h"
 #include "pipelinecache.h"
@@ -24,6 +27,7 @@
 
 namespace ncnn {
 
+class LayerProfiler;
 class NetPrivate
 {
 public:
@@ -40,27 +44,46 @@ public:
     friend class Extractor;
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
 
+    int forward_layer_wavefront(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    int forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const;
+    bool is_batch_foldable(const Layer* layer, const Mat& bottom_blob) const;
+    int forward_layer_folded(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const;
+
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
 
-    int convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
+    int convert_layout(Mat& bottom_blob, int layer_index, const Option& opt) const;
+    int do_convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
 
-    int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int do_forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+    int do_forward_layer_profiled(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler) const;
 #if NCNN_VULKAN
     int do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
 
     void update_input_output_indexes();
+    void update_kv_cache_indexes();
 #if NCNN_STRING
     void update_input_output_names();
 #endif // NCNN_STRING
 
+    int create_pipelines(int layer_count, const Option& opt, bool parallel);
+
+    void update_layout_plan();
+
+    ArenaAllocator* acquire_arena_allocator();
+    void reclaim_arena_allocator(ArenaAllocator* allocator);
+
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
 
     std::vector<int> input_blob_indexes;
     std::vector<int> output_blob_indexes;
+
+    // cache input and cache output blob of the MultiHeadAttention layers with kv_cache, k and v in turn
+    std::vector<int> kv_cache_blob_indexes;
 #if NCNN_STRING
     std::vector<const char*> input_blob_names;
     std::vector<const char*> output_blob_names;
@@ -72,6 +95,23 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+    Mutex arena_allocators_lock;
+    std::vector<ArenaAllocator*> arena_allocators;
+
+#if NCNN_STDIO
+    // keeps the weights referenced by load_model_mmap alive
+    DataReaderFromMmap* model_mmap_reader;
+#endif // NCNN_STDIO
+
+    // digest of layer types and params, part of the weight cache key
+    uint64_t param_digest;
+
+    // per layer, the layer whose packing and precision the bottom blobs are converted to
+    // split converts once on behalf of consumers that all take the same layout
+    std::vector<int> layout_layer_indexes;
+    // per layer, fp32 bottom blobs without packing need no conversion
+    std::vector<unsigned char> layout_passthrough;
+
 #if NCNN_VULKAN
     const VulkanDevice* vkdev;
 
@@ -88,6 +128,12 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+#if NCNN_STDIO
+    model_mmap_reader = 0;
+#endif // NCNN_STDIO
+
+    param_digest = 0;
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -96,6 +142,120 @@ NetPrivate::NetPrivate(Option& _opt)
 #endif // NCNN_VULKAN
 }
 
+ArenaAllocator* NetPrivate::acquire_arena_allocator()
+{
+    MutexLockGuard lock(arena_allocators_lock);
+
+    for (int i = 0; i < (int)arena_allocators.size(); i++)
+    {
+        ArenaAllocator* allocator = arena_allocators[i];
+        if (allocator)
+        {
+            arena_allocators[i] = 0;
+            return allocator;
+        }
+    }
+
+    // all arenas are taken by extractors, create new
+    ArenaAllocator* allocator = new ArenaAllocator;
+    arena_allocators.push_back(0);
+    return allocator;
+}
+
+void NetPrivate::reclaim_arena_allocator(ArenaAllocator* allocator)
+{
+    MutexLockGuard lock(arena_allocators_lock);
+
+    for (int i = 0; i < (int)arena_allocators.size(); i++)
+    {
+        if (!arena_allocators[i])
+        {
+            arena_allocators[i] = allocator;
+            return;
+        }
+    }
+
+    NCNN_LOGE("FATAL ERROR! reclaim_arena_allocator get wild allocator %p", allocator);
+}
+
+// collects the layer profiles of an extractor, layers may finish on several threads
+class LayerProfiler
+{
+public:
+    void add(const LayerProfile& profile)
+    {
+        MutexLockGuard lock(profiles_lock);
+        profiles.push_back(profile);
+    }
+
+    Mutex profiles_lock;
+    std::vector<LayerProfile> profiles;
+};
+
+// the profiler of the extract call running on this thread
+static ThreadLocalStorage tls_layer_profiler;
+
+// the profile of the layer running on this thread
+static ThreadLocalStorage tls_layer_profile;
+
+// route the layer profiles of this thread to profiler during an extract call
+class LayerProfilerScope
+{
+public:
+    LayerProfilerScope(LayerProfiler* profiler)
+    {
+        tls_layer_profiler.set(profiler);
+    }
+    ~LayerProfilerScope()
+    {
+        tls_layer_profiler.set(0);
+    }
+};
+
+// count the workspace bytes a layer requests
+class ProfileAllocator : public Allocator
+{
+public:
+    ProfileAllocator(Allocator* _allocator, size_t* _bytes)
+        : allocator(_allocator), bytes(_bytes)
+    {
+    }
+
+    virtual void* fastMalloc(size_t size)
+    {
+        bytes_lock.lock();
+        *bytes += size;
+        bytes_lock.unlock();
+
+        return allocator ? allocator->fastMalloc(size) : ncnn::fastMalloc(size);
+    }
+
+    virtual void fastFree(void* ptr)
+    {
+        if (allocator)
+            allocator->fastFree(ptr);
+        else
+            ncnn::fastFree(ptr);
+    }
+
+    Allocator* allocator;
+    Mutex bytes_lock;
+    size_t* bytes;
+};
+
+static Mat get_blob_shape(const Mat& m)
+{
+    Mat shape;
+    shape.dims = m.dims;
+    shape.w = m.w;
+    shape.h = m.h;
+    shape.d = m.d;
+    shape.c = m.c;
+    shape.elemsize = m.elemsize;
+    shape.elempack = m.elempack;
+    return shape;
+}
+
 static Option get_masked_option(const Option& opt, int featmask)
 {
     // mask option usage as layer specific featmask
@@ -118,6 +278,242 @@ static Option get_masked_option(const Option& opt, int featmask)
     return opt1;
 }
 
+int NetPrivate::create_pipelines(int layer_count, const Option& opt, bool parallel)
+{
+    std::vector<int> cret(layer_count, 0);
+
+    if (parallel)
+    {
+        // user allocators are not required to be thread-safe
+        Option opt_shared = opt;
+        opt_shared.blob_allocator = 0;
+        opt_shared.workspace_allocator = 0;
+
+        // layers differ a lot in transform cost, hand them out one by one
+        // the parallel loops inside create_pipeline run single-threaded as nested regions,
+        // while opt.num_threads still plans the tiles of packed weights for inference
+        int next_layer_index = 0;
+
+        #pragma omp parallel num_threads(opt.num_threads)
+        {
+            for (;;)
+            {
+                int i = NCNN_XADD(&next_layer_index, 1);
+                if (i >= layer_count)
+                    break;
+
+                Layer* layer = layers[i];
+
+                Option opt1 = get_masked_option(opt_shared, layer->featmask);
+
+                cret[i] = layer->create_pipeline(opt1);
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < layer_count; i++)
+        {
+            Layer* layer = layers[i];
+
+            Option opt1 = get_masked_option(opt, layer->featmask);
+
+            cret[i] = layer->create_pipeline(opt1);
+            if (cret[i] != 0)
+                break;
+        }
+    }
+
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (cret[i] != 0)
+        {
+#if NCNN_STRING
+            NCNN_LOGE("layer create_pipeline %d %s failed", i, layers[i]->name.c_str());
+#else
+            NCNN_LOGE("layer create_pipeline %d failed", i);
+#endif
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static bool is_same_layout(const Layer* a, const Layer* b)
+{
+    return a->featmask == b->featmask
+           && a->support_packing == b->support_packing
+           && a->support_bf16_storage == b->support_bf16_storage
+           && a->support_fp16_storage == b->support_fp16_storage
+           && a->support_int8_storage == b->support_int8_storage;
+}
+
+void NetPrivate::update_layout_plan()
+{
+    const int layer_count = (int)layers.size();
+
+    layout_layer_indexes.resize(layer_count);
+    layout_passthrough.resize(layer_count);
+
+    for (int i = 0; i < layer_count; i++)
+    {
+        layout_layer_indexes[i] = i;
+    }
+
+    // split passes its bottom blob to every top as is
+    // a user split may not, leave it alone then
+    bool split_overwritten = false;
+    for (size_t i = 0; i < overwrite_builtin_layer_registry.size(); i++)
+    {
+        if (overwrite_builtin_layer_registry[i].typeindex == LayerType::Split)
+            split_overwritten = true;
+    }
+
+#if NCNN_VULKAN
+    if (opt.use_vulkan_compute)
+    {
+        // consumers of a cpu split may run on gpu
+        split_overwritten = true;
+    }
+#endif // NCNN_VULKAN
+
+    // convert the split bottom blob once instead of once per consumer
+    // walk backwards so that chained splits resolve to the final consumer
+    for (int i = layer_count - 1; i >= 0 && !split_overwritten; i--)
+    {
+        const Layer* layer = layers[i];
+        if (layer->typeindex != LayerType::Split || layer->bottoms.size() != 1 || layer->tops.empty())
+            continue;
+
+        int layout_layer_index = -1;
+        for (size_t j = 0; j < layer->tops.size(); j++)
+        {
+            int consumer = blobs[layer->tops[j]].consumer;
+            if (consumer == -1)
+            {
+                // top blob may be extracted as is
+                layout_layer_index = -1;
+                break;
+            }
+
+            const int consumer_layout_layer_index = layout_layer_indexes[consumer];
+            if (layout_layer_index == -1)
+            {
+                layout_layer_index = consumer_layout_layer_index;
+            }
+            else if (!is_same_layout(layers[layout_layer_index], layers[consumer_layout_layer_index]))
+            {
+                layout_layer_index = -1;
+                break;
+            }
+        }
+
+        if (layout_layer_index != -1 && layer->featmask == layers[layout_layer_index]->featmask)
+            layout_layer_indexes[i] = layout_layer_index;
+    }
+
+    for (int i = 0; i < layer_count; i++)
+    {
+        const Layer* layer = layers[layout_layer_indexes[i]];
+
+        Option opt1 = get_masked_option(opt, layer->featmask);
+
+        bool passthrough = true;
+        if (opt1.use_packing_layout && layer->support_packing)
+            passthrough = false;
+        if (opt1.use_fp16_storage && layer->support_fp16_storage)
+            passthrough = false;
+        if (opt1.use_bf16_storage && layer->support_bf16_storage)
+            passthrough = false;
+
+        layout_passthrough[i] = passthrough ? 1 : 0;
+    }
+}
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+// taken a 64-bit word at a time, fast enough to digest the whole model on load
+static uint64_t fnv1a_64(uint64_t h, const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t v;
+        memcpy(&v, p + i, 8);
+        h = (h ^ v) * 0x100000001b3ULL;
+    }
+    for (; i < size; i++)
+    {
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
+static uint64_t get_param_digest(uint64_t h, int typeindex, const ParamDict& pd)
+{
+    h = fnv1a_64(h, &typeindex, sizeof(int));
+
+    for (int id = 0; id < NCNN_MAX_PARAM_COUNT; id++)
+    {
+        const int type = pd.type(id);
+        if (type == 0)
+            continue;
+
+        h = fnv1a_64(h, &id, sizeof(int));
+        h = fnv1a_64(h, &type, sizeof(int));
+
+        if (type == 1 || type == 2 || type == 3)
+        {
+            // int and float share the storage
+            const int i = pd.get(id, 0);
+            h = fnv1a_64(h, &i, sizeof(int));
+        }
+        if (type == 4 || type == 5 || type == 6)
+        {
+            const Mat v = pd.get(id, Mat());
+            h = fnv1a_64(h, v.data, v.total() * v.elemsize);
+        }
+        if (type == 7)
+        {
+            const std::string str = pd.get(id, std::string());
+            h = fnv1a_64(h, str.c_str(), str.size());
+        }
+    }
+
+    return h;
+}
+
+// digest the model data passing through, keys the weight cache
+class DataReaderWithDigest : public DataReader
+{
+public:
+    DataReaderWithDigest(const DataReader& _dr, uint64_t _digest)
+        : dr(_dr), digest(_digest)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        size_t nread = dr.read(buf, size);
+        digest = fnv1a_64(digest, buf, nread);
+        return nread;
+    }
+
+    virtual size_t reference(size_t size, const void** buf) const
+    {
+        size_t nref = dr.reference(size, buf);
+        if (nref)
+            digest = fnv1a_64(digest, *buf, nref);
+        return nref;
+    }
+
+    const DataReader& dr;
+    mutable uint64_t digest;
+};
+
 #if NCNN_VULKAN
 int NetPrivate::upload_model()
 {
@@ -192,13 +588,18 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     }
 #endif
     int ret = 0;
-    if (layer->featmask)
+    LayerProfiler* profiler = (LayerProfiler*)tls_layer_profiler.get();
+    if (profiler)
     {
-        ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
+        ret = do_forward_layer_profiled(layer_index, blob_mats, layer->featmask ? get_masked_option(opt, layer->featmask) : opt, profiler);
+    }
+    else if (layer->featmask)
+    {
+        ret = do_forward_layer(layer_index, blob_mats, get_masked_option(opt, layer->featmask));
     }
     else
     {
-        ret = do_forward_layer(layer, blob_mats, opt);
+        ret = do_forward_layer(layer_index, blob_mats, opt);
     }
 #if NCNN_BENCHMARK
     double end = get_current_time();
@@ -222,6 +623,444 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     return 0;
 }
 
+#if NCNN_THREADS && !NCNN_SIMPLEOMP
+struct layer_wavefront_worker_args
+{
+    const NetPrivate* d;
+    const std::vector<int>* wave;
+    std::vector<Mat>* blob_mats;
+    int worker_index;
+    int worker_count;
+    Option opt;
+    LayerProfiler* profiler;
+    int ret;
+};
+
+static void* layer_wavefront_worker(void* args)
+{
+    layer_wavefront_worker_args* wa = (layer_wavefront_worker_args*)args;
+
+    // denormal flushing is a per-thread cpu state
+    set_flush_denormals(wa->opt.flush_denormals);
+
+    LayerProfilerScope profiler_scope(wa->profiler);
+
+    const std::vector<int>& wave = *wa->wave;
+    for (size_t i = wa->worker_index; i < wave.size(); i += wa->worker_count)
+    {
+        int ret = wa->d->forward_layer(wave[i], *wa->blob_mats, wa->opt);
+        if (ret != 0)
+        {
+            wa->ret = ret;
+            break;
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_THREADS && !NCNN_SIMPLEOMP
+
+int NetPrivate::forward_layer_wavefront(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+{
+    const int layer_count = (int)layers.size();
+
+    // collect the layers required for layer_index, stop at blobs that are already available
+    // pending[i] is the number of bottom blobs layer i still waits for, -1 if layer i is not required
+    std::vector<int> pending(layer_count, -1);
+    std::vector<unsigned char> awaited(blobs.size(), 0);
+    std::vector<int> wave;
+    {
+        std::vector<int> stack(1, layer_index);
+        pending[layer_index] = 0;
+        while (!stack.empty())
+        {
+            int i = stack.back();
+            stack.pop_back();
+
+            const Layer* layer = layers[i];
+            for (size_t j = 0; j < layer->bottoms.size(); j++)
+            {
+                int bottom_blob_index = layer->bottoms[j];
+                if (blob_mats[bottom_blob_index].dims != 0)
+                    continue;
+
+                int producer = blobs[bottom_blob_index].producer;
+                if (producer < 0)
+                {
+                    NCNN_LOGE("blob %d has no producer", bottom_blob_index);
+                    return -1;
+                }
+
+                awaited[bottom_blob_index] = 1;
+                pending[i]++;
+
+                if (pending[producer] == -1)
+                {
+                    pending[producer] = 0;
+                    stack.push_back(producer);
+                }
+            }
+
+            if (pending[i] == 0)
+                wave.push_back(i);
+        }
+    }
+
+    std::vector<int> next_wave;
+    while (!wave.empty())
+    {
+        const int wave_size = (int)wave.size();
+        const int worker_count = std::min(wave_size, opt.num_threads);
+
+#if NCNN_THREADS && !NCNN_SIMPLEOMP
+        if (worker_count > 1)
+        {
+            // split the thread budget evenly across concurrent layers
+            Option opt_worker = opt;
+            opt_worker.num_threads = std::max(opt.num_threads / worker_count, 1);
+
+            std::vector<layer_wavefront_worker_args> worker_args(worker_count);
+            for (int w = 0; w < worker_count; w++)
+            {
+                worker_args[w].d = this;
+                worker_args[w].wave = &wave;
+                worker_args[w].blob_mats = &blob_mats;
+                worker_args[w].worker_index = w;
+                worker_args[w].worker_count = worker_count;
+                worker_args[w].opt = opt_worker;
+                worker_args[w].profiler = (LayerProfiler*)tls_layer_profiler.get();
+                worker_args[w].ret = 0;
+            }
+
+            std::vector<Thread*> workers(worker_count - 1);
+            for (int w = 1; w < worker_count; w++)
+            {
+                workers[w - 1] = new Thread(layer_wavefront_worker, (void*)&worker_args[w]);
+            }
+
+            // the calling thread takes the first share
+            for (int i = 0; i < wave_size; i += worker_count)
+            {
+                int ret = forward_layer(wave[i], blob_mats, opt_worker);
+                if (ret != 0)
+                {
+                    worker_args[0].ret = ret;
+                    break;
+                }
+            }
+
+            for (int w = 1; w < worker_count; w++)
+            {
+                workers[w - 1]->join();
+                delete workers[w - 1];
+            }
+
+            for (int w = 0; w < worker_count; w++)
+            {
+                if (worker_args[w].ret != 0)
+                    return worker_args[w].ret;
+            }
+        }
+        else
+#endif // NCNN_THREADS && !NCNN_SIMPLEOMP
+        {
+            for (int i = 0; i < wave_size; i++)
+            {
+                int ret = forward_layer(wave[i], blob_mats, opt);
+                if (ret != 0)
+                    return ret;
+            }
+        }
+
+        // release the consumers whose bottom blobs are all ready
+        next_wave.clear();
+        for (int i = 0; i < wave_size; i++)
+        {
+            const Layer* layer = layers[wave[i]];
+            for (size_t j = 0; j < layer->tops.size(); j++)
+            {
+                int top_blob_index = layer->tops[j];
+                if (!awaited[top_blob_index])
+                    continue;
+
+                awaited[top_blob_index] = 0;
+
+                int consumer = blobs[top_blob_index].consumer;
+                if (consumer < 0 || pending[consumer] <= 0)
+                    continue;
+
+                pending[consumer]--;
+                if (pending[consumer] == 0)
+                    next_wave.push_back(consumer);
+            }
+        }
+
+        std::swap(wave, next_wave);
+    }
+
+    return 0;
+}
+
+int NetPrivate::forward_layer_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const
+{
+    // all samples share the same available blobs, look at the first one
+    const std::vector<Mat>& blob_mats = batch_blob_mats[0];
+
+    // collect the layers required for layer_index in topological order
+    std::vector<int> sorted_layers;
+    {
+        std::vector<unsigned char> visited(layers.size(), 0);
+
+        // layer index and the next bottom blob to visit
+        std::vector<std::pair<int, int> > stack(1, std::make_pair(layer_index, 0));
+        visited[layer_index] = 1;
+        while (!stack.empty())
+        {
+            const int i = stack.back().first;
+            const int j = stack.back().second;
+
+            const Layer* layer = layers[i];
+            if (j == (int)layer->bottoms.size())
+            {
+                sorted_layers.push_back(i);
+                stack.pop_back();
+                continue;
+            }
+
+            stack.back().second++;
+
+            int bottom_blob_index = layer->bottoms[j];
+            if (blob_mats[bottom_blob_index].dims != 0)
+                continue;
+
+            int producer = blobs[bottom_blob_index].producer;
+            if (producer < 0)
+            {
+                NCNN_LOGE("blob %d has no producer", bottom_blob_index);
+                return -1;
+            }
+
+            if (!visited[producer])
+            {
+                visited[producer] = 1;
+                stack.push_back(std::make_pair(producer, 0));
+            }
+        }
+    }
+
+    // run layer by layer, so that the weights of one layer stay hot across the batch
+    for (size_t i = 0; i < sorted_layers.size(); i++)
+    {
+        const int sorted_layer_index = sorted_layers[i];
+        const Layer* layer = layers[sorted_layer_index];
+
+        if (batch_blob_mats.size() > 1 && is_batch_foldable(layer, blob_mats[layer->bottoms[0]]))
+        {
+            int ret = forward_layer_folded(sorted_layer_index, batch_blob_mats, opt);
+            if (ret != 0)
+                return ret;
+
+            continue;
+        }
+
+        for (size_t b = 0; b < batch_blob_mats.size(); b++)
+        {
+            int ret = forward_layer(sorted_layer_index, batch_blob_mats[b], opt);
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+bool NetPrivate::is_batch_foldable(const Layer* layer, const Mat& bottom_blob) const
+{
+    if (!layer->one_blob_only || layer->featmask)
+        return false;
+
+    // the parameters of overwritten builtin layers are unknown
+    for (size_t i = 0; i < overwrite_builtin_layer_registry.size(); i++)
+    {
+        if (overwrite_builtin_layer_registry[i].typeindex == layer->typeindex)
+            return false;
+    }
+
+    // gemm-like layers whose output rows only depend on the same input rows
+    // samples stacked along h then share one pass over the packed weights
+    if (layer->typeindex == LayerType::InnerProduct)
+    {
+        const InnerProduct* innerproduct = (const InnerProduct*)layer;
+        const int num_input = innerproduct->weight_data_size / innerproduct->num_output;
+
+        // 2d input is treated as rows of samples, anything else is flattened into one sample
+        return bottom_blob.dims == 1 || (bottom_blob.dims == 2 && bottom_blob.w == num_input);
+    }
+
+    if (layer->typeindex == LayerType::Convolution)
+    {
+        const Convolution* convolution = (const Convolution*)layer;
+
+        return bottom_blob.dims == 3
+               && convolution->kernel_w == 1 && convolution->kernel_h == 1
+               && convolution->stride_w == 1 && convolution->stride_h == 1
+               && convolution->pad_left == 0 && convolution->pad_right == 0
+               && convolution->pad_top == 0 && convolution->pad_bottom == 0
+               && convolution->dynamic_weight == 0;
+    }
+
+    if (layer->typeindex == LayerType::Gemm)
+    {
+        const Gemm* gemm = (const Gemm*)layer;
+
+        // A rows are the samples, per-row broadcast of C would not follow the stacking
+        return bottom_blob.dims == 2
+               && gemm->constantA == 0 && gemm->transA == 0
+               && gemm->output_transpose == 0 && gemm->output_N1M == 0
+               && gemm->int8_scale_term == 0
+               && (gemm->constant_broadcast_type_C == -1 || gemm->constant_broadcast_type_C == 0 || gemm->constant_broadcast_type_C == 4);
+    }
+
+    return false;
+}
+
+int NetPrivate::forward_layer_folded(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
+    const int bottom_blob_index = layer->bottoms[0];
+    const int top_blob_index = layer->tops[0];
+
+    const int batch = (int)batch_blob_mats.size();
+
+    // stack the samples along h
+    const Mat& b0 = batch_blob_mats[0][bottom_blob_index];
+    const int dims = b0.dims;
+
+    Mat bottom_blob;
+    if (dims == 1)
+    {
+        // 1d packed data is laid out flat
+        const size_t elemsize = b0.elemsize / b0.elempack;
+        bottom_blob.create(b0.w * b0.elempack, batch, elemsize, opt.blob_allocator);
+    }
+    else if (dims == 2)
+    {
+        bottom_blob.create(b0.w, b0.h * batch, b0.elemsize, b0.elempack, opt.blob_allocator);
+    }
+    else // if (dims == 3)
+    {
+        bottom_blob.create(b0.w, b0.h * batch, b0.c, b0.elemsize, b0.elempack, opt.blob_allocator);
+    }
+    if (bottom_blob.empty())
+        return -100;
+
+    for (int b = 0; b < batch; b++)
+    {
+        const Mat& m = batch_blob_mats[b][bottom_blob_index];
+        if (m.dims != dims || m.w != b0.w || m.h != b0.h || m.c != b0.c || m.elemsize != b0.elemsize || m.elempack != b0.elempack)
+        {
+            NCNN_LOGE("batch sample %d shape mismatch at blob %d", b, bottom_blob_index);
+            return -1;
+        }
+
+        if (dims == 3)
+        {
+            const size_t size = (size_t)m.w * m.h * m.elemsize;
+            for (int q = 0; q < m.c; q++)
+            {
+                memcpy(bottom_blob.channel(q).row<unsigned char>(b * m.h), m.channel(q), size);
+            }
+        }
+        else
+        {
+            const size_t size = (size_t)m.w * m.h * m.elemsize;
+            memcpy((unsigned char*)bottom_blob.data + b * size, m.data, size);
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        // delete after taken in light mode
+        for (int b = 0; b < batch; b++)
+        {
+            batch_blob_mats[b][bottom_blob_index].release();
+        }
+    }
+
+#if NCNN_BENCHMARK
+    double start = get_current_time();
+#endif
+    int ret = convert_layout(bottom_blob, layer_index, opt);
+    if (ret != 0)
+        return ret;
+
+    Mat top_blob;
+    ret = layer->forward(bottom_blob, top_blob, opt);
+    if (ret != 0)
+        return ret;
+#if NCNN_BENCHMARK
+    double end = get_current_time();
+    benchmark(layer, bottom_blob, top_blob, start, end);
+#endif
+
+    // 2d output is packed along h, unpack before slicing the rows of each sample
+    if (top_blob.dims == 2 && top_blob.elempack != 1)
+    {
+        Mat top_blob_unpacked;
+        convert_packing(top_blob, top_blob_unpacked, 1, opt);
+        if (top_blob_unpacked.empty())
+            return -100;
+
+        top_blob = top_blob_unpacked;
+    }
+
+    if (top_blob.h % batch != 0)
+    {
+        NCNN_LOGE("folded output h %d can not split into %d samples", top_blob.h, batch);
+        return -1;
+    }
+
+    const int outh = top_blob.h / batch;
+
+    for (int b = 0; b < batch; b++)
+    {
+        Mat top;
+        if (dims == 1)
+        {
+            top.create(top_blob.w, top_blob.elemsize, opt.blob_allocator);
+        }
+        else if (dims == 2)
+        {
+            top.create(top_blob.w, outh, top_blob.elemsize, opt.blob_allocator);
+        }
+        else // if (dims == 3)
+        {
+            top.create(top_blob.w, outh, top_blob.c, top_blob.elemsize, top_blob.elempack, opt.blob_allocator);
+        }
+        if (top.empty())
+            return -100;
+
+        if (dims == 3)
+        {
+            const size_t size = (size_t)top.w * outh * top.elemsize;
+            for (int q = 0; q < top.c; q++)
+            {
+                memcpy(top.channel(q), top_blob.channel(q).row<const unsigned char>(b * outh), size);
+            }
+        }
+        else
+        {
+            const size_t size = (size_t)top.w * outh * top.elemsize;
+            memcpy(top.data, top_blob.row<const unsigned char>(b * outh), size);
+        }
+
+        batch_blob_mats[b][top_blob_index] = top;
+    }
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
 {
@@ -333,11 +1172,11 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
 #endif
         if (layer->featmask)
         {
-            ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
+            ret = do_forward_layer(layer_index, blob_mats, get_masked_option(opt, layer->featmask));
         }
         else
         {
-            ret = do_forward_layer(layer, blob_mats, opt);
+            ret = do_forward_layer(layer_index, blob_mats, opt);
         }
 #if NCNN_BENCHMARK
         double end = get_current_time();
@@ -361,8 +1200,41 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
 }
 #endif // NCNN_VULKAN
 
-int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const
+int NetPrivate::convert_layout(Mat& bottom_blob, int layer_index, const Option& opt) const
 {
+    // conversions planned at load time
+    const Layer* layer = layers[layer_index];
+    bool passthrough = false;
+    if (layer_index < (int)layout_layer_indexes.size())
+    {
+        layer = layers[layout_layer_indexes[layer_index]];
+        passthrough = layout_passthrough[layer_index] && bottom_blob.elempack == 1 && bottom_blob.elembits() == 32;
+    }
+
+    LayerProfile* profile = (LayerProfile*)tls_layer_profile.get();
+    if (!profile)
+        return passthrough ? 0 : do_convert_layout(bottom_blob, layer, opt);
+
+    const void* data = bottom_blob.data;
+
+    double start = get_current_time();
+    int ret = passthrough ? 0 : do_convert_layout(bottom_blob, layer, opt);
+    profile->convert_time += get_current_time() - start;
+
+    if (bottom_blob.data != data)
+        profile->allocated_bytes += bottom_blob.total() * bottom_blob.elemsize;
+
+    profile->bottom_shapes.push_back(get_blob_shape(bottom_blob));
+
+    return ret;
+}
+
+int NetPrivate::do_convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const
+{
+    // zero sized blobs such as an empty kv cache carry nothing to convert
+    if (bottom_blob.empty())
+        return 0;
+
     if (bottom_blob.elembits() == 32)
     {
         // clang-format off
@@ -545,8 +1417,10 @@ int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Optio
     return 0;
 }
 
-int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const
+int NetPrivate::do_forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
 {
+    const Layer* layer = layers[layer_index];
+
     if (layer->one_blob_only)
     {
         int bottom_blob_index = layer->bottoms[0];
@@ -570,7 +1444,7 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
             bottom_blob = bottom_blob_ref;
         }
 
-        int ret = convert_layout(bottom_blob, layer, opt);
+        int ret = convert_layout(bottom_blob, layer_index, opt);
         if (ret != 0)
             return ret;
 
@@ -627,7 +1501,7 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
                 bottom_blobs[i] = bottom_blob_ref;
             }
 
-            int ret = convert_layout(bottom_blobs[i], layer, opt);
+            int ret = convert_layout(bottom_blobs[i], layer_index, opt);
             if (ret != 0)
                 return ret;
         }
@@ -679,6 +1553,54 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
     return 0;
 }
 
+int NetPrivate::do_forward_layer_profiled(int layer_index, std::vector<Mat>& blob_mats, const Option& opt, LayerProfiler* profiler) const
+{
+    const Layer* layer = layers[layer_index];
+
+    LayerProfile profile;
+    profile.layer_index = layer_index;
+    profile.typeindex = layer->typeindex;
+#if NCNN_STRING
+    profile.type = layer->type;
+    profile.name = layer->name;
+#endif // NCNN_STRING
+    profile.bf16_storage = opt.use_bf16_storage && layer->support_bf16_storage;
+
+    ProfileAllocator workspace_allocator(opt.workspace_allocator, &profile.allocated_bytes);
+
+    Option opt_profile = opt;
+    opt_profile.workspace_allocator = &workspace_allocator;
+
+    // convert_layout picks up the profile on this thread
+    tls_layer_profile.set(&profile);
+
+    profile.start = get_current_time();
+    int ret = do_forward_layer(layer_index, blob_mats, opt_profile);
+    profile.end = get_current_time();
+
+    tls_layer_profile.set(0);
+
+    if (ret != 0)
+        return ret;
+
+    const bool inplace = opt.lightmode && layer->support_inplace;
+
+    profile.top_shapes.resize(layer->tops.size());
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        const Mat& top_blob = blob_mats[layer->tops[i]];
+
+        profile.top_shapes[i] = get_blob_shape(top_blob);
+
+        if (!inplace)
+            profile.allocated_bytes += top_blob.total() * top_blob.elemsize;
+    }
+
+    profiler->add(profile);
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
 {
@@ -823,10 +1745,37 @@ void NetPrivate::update_input_output_indexes()
 
     for (size_t i = 0; i < blobs.size(); i++)
     {
-        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
+        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
+        {
+            output_blob_indexes.push_back(i);
+        }
+    }
+}
+
+void NetPrivate::update_kv_cache_indexes()
+{
+    kv_cache_blob_indexes.clear();
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const Layer* layer = layers[i];
+        if (layer->typeindex != LayerType::MultiHeadAttention)
+            continue;
+
+        if (!((const MultiHeadAttention*)layer)->kv_cache)
+            continue;
+
+        if (layer->bottoms.size() < 3 || layer->tops.size() != 3)
         {
-            output_blob_indexes.push_back(i);
+            NCNN_LOGE("MultiHeadAttention %s with kv_cache expects cache_k cache_v bottoms and out_cache_k out_cache_v tops", layer->name.c_str());
+            continue;
         }
+
+        const size_t bottom_count = layer->bottoms.size();
+        kv_cache_blob_indexes.push_back(layer->bottoms[bottom_count - 2]);
+        kv_cache_blob_indexes.push_back(layer->tops[1]);
+        kv_cache_blob_indexes.push_back(layer->bottoms[bottom_count - 1]);
+        kv_cache_blob_indexes.push_back(layer->tops[2]);
     }
 }
 
@@ -995,6 +1944,8 @@ int Net::load_param(const DataReader& dr)
     d->layers.resize((size_t)layer_count);
     d->blobs.resize((size_t)blob_count);
 
+    d->param_digest = 0xcbf29ce484222325ULL;
+
 #if NCNN_VULKAN
     // TODO enable gpu when bf16 conversion implemented
     if (opt.use_bf16_storage)
@@ -1187,6 +2138,8 @@ int Net::load_param(const DataReader& dr)
         // pull out layer specific feature disabled set
         layer->featmask = pd.get(31, 0);
 
+        d->param_digest = get_param_digest(d->param_digest, layer->typeindex, pd);
+
         int lr = layer->load_param(pd);
         if (lr != 0)
         {
@@ -1245,6 +2198,7 @@ int Net::load_param(const DataReader& dr)
 
     d->update_input_output_indexes();
     d->update_input_output_names();
+    d->update_kv_cache_indexes();
 
 #undef SCAN_VALUE
     return 0;
@@ -1294,6 +2248,8 @@ int Net::load_param_bin(const DataReader& dr)
     d->layers.resize(layer_count);
     d->blobs.resize(blob_count);
 
+    d->param_digest = 0xcbf29ce484222325ULL;
+
 #if NCNN_VULKAN
     // TODO enable gpu when bf16 conversion implemented
     if (opt.use_bf16_storage)
@@ -1469,6 +2425,8 @@ int Net::load_param_bin(const DataReader& dr)
         // pull out layer specific feature disabled set
         layer->featmask = pd.get(31, 0);
 
+        d->param_digest = get_param_digest(d->param_digest, layer->typeindex, pd);
+
         int lr = layer->load_param(pd);
         if (lr != 0)
         {
@@ -1525,6 +2483,7 @@ int Net::load_param_bin(const DataReader& dr)
     }
 
     d->update_input_output_indexes();
+    d->update_kv_cache_indexes();
 
 #undef READ_VALUE
     return 0;
@@ -1555,7 +2514,25 @@ int Net::load_model(const DataReader& dr)
     }
 #endif // NCNN_VULKAN
 
-    ModelBinFromDataReader mb(dr);
+    bool parallel_create_pipeline = opt.use_parallel_pipeline_creation;
+#if NCNN_SIMPLEOMP
+    // layer pipelines run their own parallel loops, simpleomp does not nest
+    parallel_create_pipeline = false;
+#endif
+    WeightCache* weight_cache = opt.weight_cache;
+#if NCNN_VULKAN
+    if (opt.use_vulkan_compute)
+    {
+        parallel_create_pipeline = false;
+        weight_cache = 0;
+    }
+#endif // NCNN_VULKAN
+
+    // the weight cache key covers all weights, so pipelines wait until the last layer is read
+    const bool defer_create_pipeline = parallel_create_pipeline || weight_cache;
+
+    DataReaderWithDigest drd(dr, d->param_digest);
+    ModelBinFromDataReader mb(weight_cache ? (const DataReader&)drd : dr);
     for (int i = 0; i < layer_count; i++)
     {
         Layer* layer = d->layers[i];
@@ -1580,6 +2557,9 @@ int Net::load_model(const DataReader& dr)
             break;
         }
 
+        if (defer_create_pipeline)
+            continue;
+
         Option opt1 = get_masked_option(opt, layer->featmask);
 
         int cret = layer->create_pipeline(opt1);
@@ -1595,6 +2575,22 @@ int Net::load_model(const DataReader& dr)
         }
     }
 
+    if (ret == 0 && weight_cache)
+    {
+        weight_cache->bind(drd.digest, opt, d->layers);
+    }
+
+    if (ret == 0 && defer_create_pipeline)
+    {
+        ret = d->create_pipelines(layer_count, opt, parallel_create_pipeline);
+    }
+
+    if (ret == 0)
+    {
+        // pipelines may settle the packing and precision a layer takes
+        d->update_layout_plan();
+    }
+
     if (opt.use_local_pool_allocator)
     {
         if (opt.blob_allocator == 0)
@@ -1694,6 +2690,24 @@ int Net::load_model(const char* modelpath)
     fclose(fp);
     return ret;
 }
+
+int Net::load_model_mmap(const char* modelpath)
+{
+    DataReaderFromMmap* dr = new DataReaderFromMmap(modelpath);
+    if (dr->empty())
+    {
+        delete dr;
+        return -1;
+    }
+
+    int ret = load_model(*dr);
+
+    // layers may still reference the previous mapping until now
+    delete d->model_mmap_reader;
+    d->model_mmap_reader = dr;
+
+    return ret;
+}
 #endif // NCNN_STDIO
 
 int Net::load_param(const unsigned char* _mem)
@@ -1831,6 +2845,8 @@ void Net::clear()
         }
     }
     d->layers.clear();
+    d->layout_layer_indexes.clear();
+    d->layout_passthrough.clear();
 
     if (d->local_blob_allocator)
     {
@@ -1843,6 +2859,20 @@ void Net::clear()
         d->local_workspace_allocator = 0;
     }
 
+    for (size_t i = 0; i < d->arena_allocators.size(); i++)
+    {
+        delete d->arena_allocators[i];
+    }
+    d->arena_allocators.clear();
+
+#if NCNN_STDIO
+    if (d->model_mmap_reader)
+    {
+        delete d->model_mmap_reader;
+        d->model_mmap_reader = 0;
+    }
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     if (d->weight_vkallocator)
     {
@@ -2031,17 +3061,50 @@ Layer* Net::create_overwrite_builtin_layer(int typeindex)
     return layer;
 }
 
+static size_t get_blob_shape_key(const std::vector<Mat>& blob_mats)
+{
+    // fnv-1a over the shapes of the blobs already set
+    size_t key = 2166136261u;
+    for (size_t i = 0; i < blob_mats.size(); i++)
+    {
+        const Mat& m = blob_mats[i];
+        if (m.dims == 0)
+            continue;
+
+        const size_t shape[8] = {i, (size_t)m.dims, (size_t)m.w, (size_t)m.h, (size_t)m.d, (size_t)m.c, m.elemsize, (size_t)m.elempack};
+        for (int j = 0; j < 8; j++)
+        {
+            key = (key ^ shape[j]) * 16777619u;
+        }
+    }
+
+    return key;
+}
+
 class ExtractorPrivate
 {
 public:
     ExtractorPrivate(const Net* _net)
         : net(_net)
     {
+        local_arena_allocator = 0;
+        layer_profiler = 0;
     }
     const Net* net;
     std::vector<Mat> blob_mats;
     Option opt;
 
+    ArenaAllocator* local_arena_allocator;
+
+    // null unless profiling is enabled
+    LayerProfiler* layer_profiler;
+
+    // blob mats of each sample for batched inference
+    std::vector<std::vector<Mat> > batch_blob_mats;
+
+    // kv cache fed back to the next forward pass, one per NetPrivate::kv_cache_blob_indexes pair
+    std::vector<Mat> kv_cache;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2056,6 +3119,8 @@ Extractor::Extractor(const Net* _net, size_t blob_count)
     d->blob_mats.resize(blob_count);
     d->opt = d->net->opt;
 
+    d->kv_cache.resize(d->net->d->kv_cache_blob_indexes.size() / 2);
+
 #if NCNN_VULKAN
     if (d->net->opt.use_vulkan_compute)
     {
@@ -2071,6 +3136,8 @@ Extractor::~Extractor()
 {
     clear();
 
+    delete d->layer_profiler;
+
     delete d;
 }
 
@@ -2079,8 +3146,22 @@ Extractor::Extractor(const Extractor& rhs)
 {
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
+    d->kv_cache = rhs.d->kv_cache;
     d->opt = rhs.d->opt;
 
+    // the arena stays owned by rhs
+    if (rhs.d->local_arena_allocator && d->opt.blob_allocator == rhs.d->local_arena_allocator)
+        d->opt.blob_allocator = 0;
+
+    delete d->layer_profiler;
+    d->layer_profiler = 0;
+    if (rhs.d->layer_profiler)
+    {
+        d->layer_profiler = new LayerProfiler;
+        d->layer_profiler->profiles = rhs.d->layer_profiler->profiles;
+    }
+
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
     d->local_staging_vkallocator = 0;
@@ -2096,8 +3177,22 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
+    d->kv_cache = rhs.d->kv_cache;
     d->opt = rhs.d->opt;
 
+    // the arena stays owned by rhs
+    if (rhs.d->local_arena_allocator && d->opt.blob_allocator == rhs.d->local_arena_allocator)
+        d->opt.blob_allocator = 0;
+
+    delete d->layer_profiler;
+    d->layer_profiler = 0;
+    if (rhs.d->layer_profiler)
+    {
+        d->layer_profiler = new LayerProfiler;
+        d->layer_profiler->profiles = rhs.d->layer_profiler->profiles;
+    }
+
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
     d->local_staging_vkallocator = 0;
@@ -2110,12 +3205,29 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 
 void Extractor::clear()
 {
+    // keep the blob slots so that the extractor can run the next forward pass
+    const size_t blob_count = d->blob_mats.size();
     d->blob_mats.clear();
+    d->blob_mats.resize(blob_count);
+    d->batch_blob_mats.clear();
+
+    if (d->layer_profiler)
+        d->layer_profiler->profiles.clear();
+
+    if (d->local_arena_allocator)
+    {
+        if (d->opt.blob_allocator == d->local_arena_allocator)
+            d->opt.blob_allocator = 0;
+
+        d->net->d->reclaim_arena_allocator(d->local_arena_allocator);
+        d->local_arena_allocator = 0;
+    }
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
     {
         d->blob_mats_gpu.clear();
+        d->blob_mats_gpu.resize(blob_count);
 
         if (d->local_blob_vkallocator)
         {
@@ -2138,9 +3250,36 @@ void Extractor::set_light_mode(bool enable)
 
 void Extractor::set_num_threads(int num_threads)
 {
-    NCNN_LOGE("ex.set_num_threads() is no-op, please set net.opt.num_threads=N before net.load_param()");
-    NCNN_LOGE("If you want to use single thread for only some layer, see https://github.com/Tencent/ncnn/wiki/layer-feat-mask");
+    // packed weights keep the tile layout planned with the load-time thread count,
+    // layers spread the work over opt.num_threads of each forward call
+    d->opt.num_threads = num_threads > 0 ? num_threads : d->net->opt.num_threads;
+}
+
+void Extractor::set_profiling(bool enable)
+{
+    if (enable && !d->layer_profiler)
+    {
+        d->layer_profiler = new LayerProfiler;
+    }
+    if (!enable && d->layer_profiler)
+    {
+        delete d->layer_profiler;
+        d->layer_profiler = 0;
+    }
+}
+
+const std::vector<LayerProfile>& Extractor::layer_profiles() const
+{
+    static const std::vector<LayerProfile> empty_profiles;
+    return d->layer_profiler ? d->layer_profiler->profiles : empty_profiles;
+}
+
+#if NCNN_STDIO
+int Extractor::save_chrome_trace(const char* path) const
+{
+    return ncnn::save_chrome_trace(layer_profiles(), path);
 }
+#endif // NCNN_STDIO
 
 void Extractor::set_blob_allocator(Allocator* allocator)
 {
@@ -2152,6 +3291,42 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     d->opt.workspace_allocator = allocator;
 }
 
+void Extractor::reset_kv_cache()
+{
+    for (size_t i = 0; i < d->kv_cache.size(); i++)
+    {
+        d->kv_cache[i].release();
+    }
+}
+
+void Extractor::truncate_kv_cache(int seqlen)
+{
+    for (size_t i = 0; i < d->kv_cache.size(); i++)
+    {
+        Mat& m = d->kv_cache[i];
+        if (m.empty() || m.w <= seqlen)
+            continue;
+
+        if (seqlen <= 0)
+        {
+            m.release();
+            continue;
+        }
+
+        // one column per position, keep the leading columns of every row
+        Mat m2(seqlen, m.h, m.elemsize, m.elempack);
+        if (m2.empty())
+            continue;
+
+        for (int y = 0; y < m.h; y++)
+        {
+            memcpy(m2.row<unsigned char>(y), m.row<const unsigned char>(y), seqlen * m.elemsize);
+        }
+
+        m = m2;
+    }
+}
+
 #if NCNN_VULKAN
 void Extractor::set_vulkan_compute(bool enable)
 {
@@ -2240,19 +3415,25 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
     {
         int layer_index = d->net->blobs()[blob_index].producer;
 
-        // use local allocator
-        if (d->opt.use_local_pool_allocator)
+        // feed the kv cache unless the caller set the cache blobs
+        const std::vector<int>& kv_cache_blob_indexes = d->net->d->kv_cache_blob_indexes;
+        std::vector<int> kv_cache_pending(d->kv_cache.size(), 0);
+        for (size_t i = 0; i < d->kv_cache.size(); i++)
         {
-            if (!d->opt.blob_allocator)
-            {
-                d->opt.blob_allocator = d->net->d->local_blob_allocator;
-            }
-            if (!d->opt.workspace_allocator)
+            Mat& cache_blob = d->blob_mats[kv_cache_blob_indexes[i * 2]];
+            if (cache_blob.dims == 0)
             {
-                d->opt.workspace_allocator = d->net->d->local_workspace_allocator;
+                // an empty 2d mat stands for no past positions
+                cache_blob = d->kv_cache[i].dims ? d->kv_cache[i] : Mat(0, 0, (size_t)4u);
             }
+
+            kv_cache_pending[i] = d->blob_mats[kv_cache_blob_indexes[i * 2 + 1]].dims == 0;
         }
 
+        prepare_local_allocators(get_blob_shape_key(d->blob_mats));
+
+        LayerProfilerScope profiler_scope(d->layer_profiler);
+
 #if NCNN_VULKAN
         if (d->opt.use_vulkan_compute)
         {
@@ -2302,13 +3483,38 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
 #endif // NCNN_BENCHMARK
             }
         }
+        else if (d->opt.use_parallel_layer_scheduling)
+        {
+            ret = d->net->d->forward_layer_wavefront(layer_index, d->blob_mats, d->opt);
+        }
         else
         {
             ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
         }
 #else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        if (d->opt.use_parallel_layer_scheduling)
+        {
+            ret = d->net->d->forward_layer_wavefront(layer_index, d->blob_mats, d->opt);
+        }
+        else
+        {
+            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        }
 #endif // NCNN_VULKAN
+
+        // keep the kv cache produced by this pass for the next one
+        for (size_t i = 0; ret == 0 && i < d->kv_cache.size(); i++)
+        {
+            const Mat& cache_blob = d->blob_mats[kv_cache_blob_indexes[i * 2 + 1]];
+            if (!kv_cache_pending[i] || cache_blob.dims == 0)
+                continue;
+
+            // the local arena is recycled on clear()
+            if (cache_blob.allocator && cache_blob.allocator == d->local_arena_allocator)
+                d->kv_cache[i] = cache_blob.clone();
+            else
+                d->kv_cache[i] = cache_blob;
+        }
     }
 
     feat = d->blob_mats[blob_index];
@@ -2386,7 +3592,15 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
         if (feat.empty())
             return -100;
 
-        if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
+        if (d->local_arena_allocator && feat.allocator == d->local_arena_allocator)
+        {
+            // detach the returned mat from local arena allocator
+            // so the next pass could reuse the arena
+            feat = feat.clone();
+            if (feat.empty())
+                return -100;
+        }
+        else if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
         {
             // detach the returned mat from local pool allocator
             // so we could destroy net instance much earlier
@@ -2402,6 +3616,181 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
     return ret;
 }
 
+#if NCNN_STRING
+int Extractor::input(const char* blob_name, const std::vector<Mat>& in_batch)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& input_names = d->net->input_names();
+        for (size_t i = 0; i < input_names.size(); i++)
+        {
+            NCNN_LOGE("    ex.input(\"%s\", in%d);", input_names[i], (int)i);
+        }
+
+        return -1;
+    }
+
+    return input(blob_index, in_batch);
+}
+
+int Extractor::extract(const char* blob_name, std::vector<Mat>& feat_batch, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& output_names = d->net->output_names();
+        for (size_t i = 0; i < output_names.size(); i++)
+        {
+            NCNN_LOGE("    ex.extract(\"%s\", out%d);", output_names[i], (int)i);
+        }
+
+        return -1;
+    }
+
+    return extract(blob_index, feat_batch, type);
+}
+#endif // NCNN_STRING
+
+int Extractor::input(int blob_index, const std::vector<Mat>& in_batch)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    const size_t batch = in_batch.size();
+    if (batch == 0)
+        return -1;
+
+    if (!d->batch_blob_mats.empty() && d->batch_blob_mats.size() != batch)
+    {
+        NCNN_LOGE("batch size %d mismatch, expect %d", (int)batch, (int)d->batch_blob_mats.size());
+        return -1;
+    }
+
+    const Mat& m0 = in_batch[0];
+    for (size_t b = 1; b < batch; b++)
+    {
+        const Mat& m = in_batch[b];
+        if (m.dims != m0.dims || m.w != m0.w || m.h != m0.h || m.d != m0.d || m.c != m0.c || m.elemsize != m0.elemsize || m.elempack != m0.elempack)
+        {
+            NCNN_LOGE("batch sample %d shape mismatch", (int)b);
+            return -1;
+        }
+    }
+
+    if (d->batch_blob_mats.empty())
+    {
+        d->batch_blob_mats.resize(batch);
+        for (size_t b = 0; b < batch; b++)
+        {
+            d->batch_blob_mats[b].resize(d->blob_mats.size());
+        }
+    }
+
+    for (size_t b = 0; b < batch; b++)
+    {
+        d->batch_blob_mats[b][blob_index] = in_batch[b];
+    }
+
+    return 0;
+}
+
+int Extractor::extract(int blob_index, std::vector<Mat>& feat_batch, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    const size_t batch = d->batch_blob_mats.size();
+    if (batch == 0)
+    {
+        NCNN_LOGE("no batched input, set it with ex.input(blob, in_batch) first");
+        return -1;
+    }
+
+    bool use_batch_forward = d->batch_blob_mats[0][blob_index].dims == 0;
+#if NCNN_VULKAN
+    if (d->opt.use_vulkan_compute)
+    {
+        // gpu runs the samples one by one through the regular path
+        use_batch_forward = false;
+    }
+#endif // NCNN_VULKAN
+
+    if (use_batch_forward)
+    {
+        int old_blocktime = get_kmp_blocktime();
+        set_kmp_blocktime(d->opt.openmp_blocktime);
+
+        int old_flush_denormals = get_flush_denormals();
+        set_flush_denormals(d->opt.flush_denormals);
+
+        // the batch size takes part in the arena plan
+        prepare_local_allocators(get_blob_shape_key(d->batch_blob_mats[0]) * 31 + batch);
+
+        LayerProfilerScope profiler_scope(d->layer_profiler);
+
+        int layer_index = d->net->blobs()[blob_index].producer;
+        int ret = d->net->d->forward_layer_batch(layer_index, d->batch_blob_mats, d->opt);
+
+        set_kmp_blocktime(old_blocktime);
+        set_flush_denormals(old_flush_denormals);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    // reuse the single sample path for conversion and allocator detaching
+    feat_batch.resize(batch);
+    for (size_t b = 0; b < batch; b++)
+    {
+        std::swap(d->blob_mats, d->batch_blob_mats[b]);
+#if NCNN_VULKAN
+        if (d->opt.use_vulkan_compute)
+        {
+            // gpu blobs of the previous sample must not leak into this one
+            const size_t blob_count = d->blob_mats_gpu.size();
+            d->blob_mats_gpu.clear();
+            d->blob_mats_gpu.resize(blob_count);
+        }
+#endif // NCNN_VULKAN
+
+        int ret = extract(blob_index, feat_batch[b], type);
+
+        std::swap(d->blob_mats, d->batch_blob_mats[b]);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+void Extractor::prepare_local_allocators(size_t shape_key)
+{
+    // use local arena allocator planned for the input shapes
+    if (d->opt.use_local_arena_allocator && !d->opt.blob_allocator)
+    {
+        d->local_arena_allocator = d->net->d->acquire_arena_allocator();
+        d->local_arena_allocator->begin(shape_key);
+        d->opt.blob_allocator = d->local_arena_allocator;
+    }
+
+    // use local allocator
+    if (d->opt.use_local_pool_allocator)
+    {
+        if (!d->opt.blob_allocator)
+        {
+            d->opt.blob_allocator = d->net->d->local_blob_allocator;
+        }
+        if (!d->opt.workspace_allocator)
+        {
+            d->opt.workspace_allocator = d->net->d->local_workspace_allocator;
+        }
+    }
+}
+
 #if NCNN_VULKAN
 #if NCNN_STRING
 int Extractor::input(const char* blob_name, const VkMat& in)
@@ -9,6 +9,7 @@
 #include "mat.h"
 #include "option.h"
 #include "platform.h"
+#include "profiler.h"
 
 #if NCNN_PLATFORM_API
 #if __ANDROID_API__ >= 9
@@ -81,6 +82,13 @@ public:
     // return 0 if success
     int load_model(FILE* fp);
     int load_model(const char* modelpath);
+
+    // map network weight data from model file read-only
+    // weight data is referenced in the mapped pages instead of copied
+    // so processes loading the same file share them in page cache
+    // the mapping is retained until clear()
+    // return 0 if success
+    int load_model_mmap(const char* modelpath);
 #endif // NCNN_STDIO
 
     // load network structure from external memory
@@ -163,7 +171,7 @@ public:
     // assign
     Extractor& operator=(const Extractor&);
 
-    // clear blob mats and alloctors
+    // clear blob mats and alloctors, the kv cache is kept
     void clear();
 
     // enable light mode
@@ -171,16 +179,38 @@ public:
     // enabled by default
     void set_light_mode(bool enable);
 
-    // deprecated, no-op
-    // instead, set net.opt.num_threads before net.load_param()
+    // set thread count for this extractor
+    // may differ from net.opt.num_threads used at load time, no reload needed
+    // non-positive value restores net.opt.num_threads
     void set_num_threads(int num_threads);
 
+    // enable per-layer profiling for the following extract calls
+    // records are kept until disabled or cleared
+    // disabled by default
+    void set_profiling(bool enable);
+
+    // per-layer records of the cpu layers run since profiling was enabled
+    const std::vector<LayerProfile>& layer_profiles() const;
+
+#if NCNN_STDIO
+    // write the per-layer records in chrome trace json
+    // return 0 if success
+    int save_chrome_trace(const char* path) const;
+#endif // NCNN_STDIO
+
     // set blob memory allocator
     void set_blob_allocator(Allocator* allocator);
 
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // drop the kv cache of MultiHeadAttention layers with kv_cache enabled
+    // the kv cache is kept across extract() and clear() for step by step decoding
+    void reset_kv_cache();
+
+    // keep the first seqlen positions of the kv cache, drop it when seqlen <= 0
+    void truncate_kv_cache(int seqlen);
+
 #if NCNN_VULKAN
     // deprecated, no-op
     // instead, set net.opt.use_vulkan_compute before net.load_param()
@@ -215,6 +245,26 @@ public:
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(int blob_index, Mat& feat, int type = 0);
 
+#if NCNN_STRING
+    // set batched input by blob name
+    // all samples must have the same shape, and every batched input the same batch size
+    // return 0 if success
+    int input(const char* blob_name, const std::vector<Mat>& in_batch);
+
+    // get batched result by blob name, one mat per sample
+    // innerproduct, gemm and 1x1 convolution run the whole batch in one call
+    // return 0 if success
+    int extract(const char* blob_name, std::vector<Mat>& feat_batch, int type = 0);
+#endif // NCNN_STRING
+
+    // set batched input by blob index
+    // return 0 if success
+    int input(int blob_index, const std::vector<Mat>& in_batch);
+
+    // get batched result by blob index
+    // return 0 if success
+    int extract(int blob_index, std::vector<Mat>& feat_batch, int type = 0);
+
 #if NCNN_VULKAN
 #if NCNN_STRING
     // set input by blob name
@@ -239,6 +289,10 @@ protected:
     friend Extractor Net::create_extractor() const;
     Extractor(const Net* net, size_t blob_count);
 
+private:
+    // pick the local allocators before running a forward pass
+    void prepare_local_allocators(size_t shape_key);
+
 private:
     ExtractorPrivate* const d;
 };
@@ -17,6 +17,7 @@ Option::Option()
     num_threads = get_physical_big_cpu_count();
     blob_allocator = 0;
     workspace_allocator = 0;
+    weight_cache = 0;
 
 #if NCNN_VULKAN
     blob_vkallocator = 0;
@@ -67,9 +68,9 @@ Option::Option()
     use_fp16_uniform = true;
     use_int8_uniform = true;
 
-    use_reserved_9 = false;
-    use_reserved_10 = false;
-    use_reserved_11 = false;
+    use_parallel_layer_scheduling = false;
+    use_local_arena_allocator = false;
+    use_parallel_pipeline_creation = false;
 }
 
 } // namespace ncnn
@@ -14,6 +14,7 @@ class PipelineCache;
 #endif // NCNN_VULKAN
 
 class Allocator;
+class WeightCache;
 class NCNN_EXPORT Option
 {
 public:
@@ -44,6 +45,11 @@ public:
     // workspace memory allocator
     Allocator* workspace_allocator;
 
+    // cpu weight cache
+    // layers take the transformed weights recorded on a previous run instead of transforming again
+    // changes should be applied before loading network weight
+    WeightCache* weight_cache;
+
 #if NCNN_VULKAN
     // blob memory allocator
     VkAllocator* blob_vkallocator;
@@ -141,9 +147,23 @@ public:
     bool use_fp16_uniform;
     bool use_int8_uniform;
 
-    bool use_reserved_9;
-    bool use_reserved_10;
-    bool use_reserved_11;
+    // run independent layers of a branchy graph concurrently
+    // the thread budget is split across the layers of each wavefront
+    // blob and workspace allocators must be thread-safe when enabled
+    // disabled by default
+    bool use_parallel_layer_scheduling;
+
+    // serve intermediate blobs of each extractor from one pre-sized arena
+    // planned from the blob lifetimes of the first run with the same input shapes
+    // takes effect when blob_allocator is not set
+    // disabled by default
+    bool use_local_arena_allocator;
+
+    // run create_pipeline of all layers in parallel after reading the weights sequentially
+    // shortens cold start of big models on cpu, raises the peak memory while loading
+    // ignored for vulkan compute
+    // disabled by default
+    bool use_parallel_pipeline_creation;
 };
 
 } // namespace ncnn
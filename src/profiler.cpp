@@ -0,0 +1,143 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "profiler.h"
+
+#if NCNN_STDIO
+#include <stdio.h>
+#endif
+
+namespace ncnn {
+
+LayerProfile::LayerProfile()
+{
+    layer_index = -1;
+    typeindex = -1;
+    start = 0;
+    end = 0;
+    convert_time = 0;
+    bf16_storage = false;
+    allocated_bytes = 0;
+}
+
+#if NCNN_STDIO
+static void write_json_string(FILE* fp, const char* str)
+{
+    fputc('"', fp);
+    for (const char* p = str; *p; p++)
+    {
+        const unsigned char c = (unsigned char)*p;
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', fp);
+            fputc(c, fp);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(fp, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+static void write_shapes(FILE* fp, const std::vector<Mat>& shapes, bool bf16_storage)
+{
+    fputc('"', fp);
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        const Mat& m = shapes[i];
+
+        if (i > 0)
+            fputc(' ', fp);
+
+        if (m.dims == 1) fprintf(fp, "[%d", m.w);
+        if (m.dims == 2) fprintf(fp, "[%d,%d", m.w, m.h);
+        if (m.dims == 3) fprintf(fp, "[%d,%d,%d", m.w, m.h, m.c);
+        if (m.dims == 4) fprintf(fp, "[%d,%d,%d,%d", m.w, m.h, m.d, m.c);
+        if (m.dims == 0)
+        {
+            fprintf(fp, "[]");
+            continue;
+        }
+
+        const int elembits = m.elembits();
+        const char* storage = elembits == 32 ? "fp32" : elembits == 16 ? (bf16_storage ? "bf16" : "fp16") : elembits == 8 ? "int8" : "?";
+        fprintf(fp, " *%d %s]", m.elempack, storage);
+    }
+    fputc('"', fp);
+}
+
+int save_chrome_trace(const std::vector<LayerProfile>& profiles, const char* path)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    const int count = (int)profiles.size();
+
+    // order by start time, records come in completion order
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+    {
+        int j = i;
+        for (; j > 0 && profiles[order[j - 1]].start > profiles[i].start; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+
+    const double origin = count > 0 ? profiles[order[0]].start : 0.0;
+
+    // put each layer on the first track that is free by its start
+    std::vector<double> track_ends;
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    for (int i = 0; i < count; i++)
+    {
+        const LayerProfile& lp = profiles[order[i]];
+
+        int track = 0;
+        for (; track < (int)track_ends.size(); track++)
+        {
+            if (track_ends[track] <= lp.start)
+                break;
+        }
+        if (track == (int)track_ends.size())
+            track_ends.push_back(lp.end);
+        else
+            track_ends[track] = lp.end;
+
+        fprintf(fp, "{\"name\":");
+#if NCNN_STRING
+        write_json_string(fp, lp.name.c_str());
+        fprintf(fp, ",\"cat\":");
+        write_json_string(fp, lp.type.c_str());
+#else
+        fprintf(fp, "\"layer %d\",\"cat\":\"%d\"", lp.layer_index, lp.typeindex);
+#endif
+        // chrome trace timestamps are in us
+        fprintf(fp, ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", track, (lp.start - origin) * 1000, (lp.end - lp.start) * 1000);
+        fprintf(fp, ",\"args\":{\"layer_index\":%d,\"convert_ms\":%.3f,\"allocated_bytes\":%lu", lp.layer_index, lp.convert_time, (unsigned long)lp.allocated_bytes);
+        fprintf(fp, ",\"bottoms\":");
+        write_shapes(fp, lp.bottom_shapes, lp.bf16_storage);
+        fprintf(fp, ",\"tops\":");
+        write_shapes(fp, lp.top_shapes, lp.bf16_storage);
+        fprintf(fp, "}}%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    fclose(fp);
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+} // namespace ncnn
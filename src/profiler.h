@@ -0,0 +1,60 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_PROFILER_H
+#define NCNN_PROFILER_H
+
+#include "mat.h"
+#include "platform.h"
+
+namespace ncnn {
+
+class NCNN_EXPORT LayerProfile
+{
+public:
+    // empty
+    LayerProfile();
+
+public:
+    // layer index in net
+    int layer_index;
+    // layer type index
+    int typeindex;
+#if NCNN_STRING
+    // layer type name
+    std::string type;
+    // layer name
+    std::string name;
+#endif // NCNN_STRING
+
+    // timestamps from get_current_time() in ms
+    double start;
+    double end;
+
+    // time spent converting bottom blobs to the packing and precision of the layer in ms
+    // included in start and end
+    double convert_time;
+
+    // shapes without data of the bottom blobs as the layer takes them and the top blobs
+    // elemsize / elempack is the storage bits, 32 for fp32, 16 for fp16 or bf16, 8 for int8
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> top_shapes;
+
+    // 16 bit blobs of this layer are bf16 rather than fp16
+    bool bf16_storage;
+
+    // bytes allocated for converted bottom blobs, top blobs and workspace
+    size_t allocated_bytes;
+};
+
+#if NCNN_STDIO
+// write layer profiles in chrome trace event json
+// open in chrome://tracing or ui.perfetto.dev
+// layers running at the same time go to separate tracks
+// return 0 if success
+NCNN_EXPORT int save_chrome_trace(const std::vector<LayerProfile>& profiles, const char* path);
+#endif // NCNN_STDIO
+
+} // namespace ncnn
+
+#endif // NCNN_PROFILER_H
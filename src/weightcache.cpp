@@ -0,0 +1,467 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "weightcache.h"
+
+#include "cpu.h"
+#include "datareader.h"
+#include "layer.h"
+#include "option.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+// "NCWC" in little endian
+static const uint32_t weight_cache_magic = 0x4357434e;
+static const uint32_t weight_cache_version = 1;
+
+// cached weight data is aligned in file so that mapped pages serve it directly
+static const size_t weight_cache_align = 64;
+
+struct weight_cache_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t entry_count;
+    uint32_t reserved;
+};
+
+struct weight_cache_record
+{
+    int32_t layer_index;
+    int32_t slot;
+    int32_t dims;
+    int32_t w;
+    int32_t h;
+    int32_t d;
+    int32_t c;
+    int32_t elempack;
+    uint64_t elemsize;
+    uint64_t cstep;
+    uint64_t size;
+};
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+static uint64_t fnv1a_64(uint64_t h, uint64_t v)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        h ^= (v >> (i * 8)) & 0xff;
+        h *= 0x100000001b3ULL;
+    }
+
+    return h;
+}
+
+static uint64_t get_weight_cache_key(uint64_t model_digest, const Option& opt)
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+
+    h = fnv1a_64(h, model_digest);
+
+#ifdef NCNN_VERSION_STRING
+    // weight layouts may change between releases
+    const char* version = NCNN_VERSION_STRING;
+    const size_t version_length = strlen(version);
+    for (size_t i = 0; i < version_length; i++)
+    {
+        h = fnv1a_64(h, (uint64_t)version[i]);
+    }
+#endif
+    h = fnv1a_64(h, sizeof(void*));
+
+    // options that select the kernel and the packed layout
+    const int option_bits[] = {
+        opt.num_threads,
+        opt.use_winograd_convolution,
+        opt.use_winograd23_convolution,
+        opt.use_winograd43_convolution,
+        opt.use_winograd63_convolution,
+        opt.use_sgemm_convolution,
+        opt.use_int8_inference,
+        opt.use_packing_layout,
+        opt.use_fp16_packed,
+        opt.use_fp16_storage,
+        opt.use_fp16_arithmetic,
+        opt.use_bf16_storage,
+        opt.use_int8_packed,
+        opt.use_int8_storage,
+        opt.use_int8_arithmetic,
+        opt.use_a53_a55_optimized_kernel,
+    };
+    for (size_t i = 0; i < sizeof(option_bits) / sizeof(option_bits[0]); i++)
+    {
+        h = fnv1a_64(h, (uint64_t)option_bits[i]);
+    }
+
+    // isa dispatch and cache size driven tiling
+    const int cpu_bits[] = {
+        cpu_support_arm_edsp(),
+        cpu_support_arm_neon(),
+        cpu_support_arm_vfpv4(),
+        cpu_support_arm_asimdhp(),
+        cpu_support_arm_asimddp(),
+        cpu_support_arm_asimdfhm(),
+        cpu_support_arm_bf16(),
+        cpu_support_arm_i8mm(),
+        cpu_support_arm_sve(),
+        cpu_support_arm_sve2(),
+        cpu_support_arm_svebf16(),
+        cpu_support_arm_svei8mm(),
+        cpu_support_arm_svef32mm(),
+        cpu_support_x86_avx(),
+        cpu_support_x86_fma(),
+        cpu_support_x86_xop(),
+        cpu_support_x86_f16c(),
+        cpu_support_x86_avx2(),
+        cpu_support_x86_avx_vnni(),
+        cpu_support_x86_avx_vnni_int8(),
+        cpu_support_x86_avx_vnni_int16(),
+        cpu_support_x86_avx_ne_convert(),
+        cpu_support_x86_avx512(),
+        cpu_support_x86_avx512_vnni(),
+        cpu_support_x86_avx512_bf16(),
+        cpu_support_x86_avx512_fp16(),
+        cpu_support_loongarch_lsx(),
+        cpu_support_loongarch_lasx(),
+        cpu_support_mips_msa(),
+        cpu_support_loongson_mmi(),
+        cpu_support_riscv_v(),
+        cpu_support_riscv_zfh(),
+        cpu_support_riscv_zvfh(),
+        cpu_support_riscv_xtheadvector(),
+        get_cpu_level2_cache_size(),
+        get_cpu_level3_cache_size(),
+    };
+    for (size_t i = 0; i < sizeof(cpu_bits) / sizeof(cpu_bits[0]); i++)
+    {
+        h = fnv1a_64(h, (uint64_t)cpu_bits[i]);
+    }
+
+    return h;
+}
+
+class WeightCachePrivate
+{
+public:
+    struct weight_cache_entry
+    {
+        int layer_index;
+        int slot;
+        Mat m;
+    };
+
+    int find_layer_index(const Layer* layer) const;
+
+    std::vector<Layer*> layers;
+    uint64_t key;
+    bool reused;
+
+    // entries from the cache file, read-only once bound
+#if NCNN_STDIO
+    DataReaderFromMmap* mapped_reader;
+#endif // NCNN_STDIO
+    uint64_t mapped_key;
+    std::vector<weight_cache_entry> mapped_entries;
+
+    // entries recorded from layer pipelines, possibly created in parallel
+    Mutex recorded_lock;
+    std::vector<weight_cache_entry> recorded_entries;
+};
+
+int WeightCachePrivate::find_layer_index(const Layer* layer) const
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i] == layer)
+            return (int)i;
+    }
+
+    // inner layers created by a layer pipeline are not cached
+    return -1;
+}
+
+WeightCache::WeightCache()
+    : d(new WeightCachePrivate)
+{
+    d->key = 0;
+    d->reused = false;
+#if NCNN_STDIO
+    d->mapped_reader = 0;
+#endif // NCNN_STDIO
+    d->mapped_key = 0;
+}
+
+WeightCache::~WeightCache()
+{
+    clear();
+
+    delete d;
+}
+
+WeightCache::WeightCache(const WeightCache&)
+    : d(0)
+{
+}
+
+WeightCache& WeightCache::operator=(const WeightCache&)
+{
+    return *this;
+}
+
+void WeightCache::clear()
+{
+    d->layers.clear();
+    d->key = 0;
+    d->reused = false;
+
+    d->mapped_entries.clear();
+    d->mapped_key = 0;
+#if NCNN_STDIO
+    delete d->mapped_reader;
+    d->mapped_reader = 0;
+#endif // NCNN_STDIO
+
+    d->recorded_lock.lock();
+    d->recorded_entries.clear();
+    d->recorded_lock.unlock();
+}
+
+#if NCNN_STDIO
+int WeightCache::load(const char* path)
+{
+    clear();
+
+    DataReaderFromMmap* dr = new DataReaderFromMmap(path);
+    if (dr->empty())
+    {
+        delete dr;
+        return -1;
+    }
+
+    weight_cache_header header;
+    if (dr->read(&header, sizeof(header)) != sizeof(header) || header.magic != weight_cache_magic || header.version != weight_cache_version)
+    {
+        NCNN_LOGE("WeightCache %s is not a weight cache file", path);
+        delete dr;
+        return -1;
+    }
+
+    std::vector<weight_cache_record> records(header.entry_count);
+    if (header.entry_count > 0 && dr->read(&records[0], header.entry_count * sizeof(weight_cache_record)) != header.entry_count * sizeof(weight_cache_record))
+    {
+        NCNN_LOGE("WeightCache %s is truncated", path);
+        delete dr;
+        return -1;
+    }
+
+    size_t offset = sizeof(header) + header.entry_count * sizeof(weight_cache_record);
+
+    std::vector<WeightCachePrivate::weight_cache_entry> entries(header.entry_count);
+    for (uint32_t i = 0; i < header.entry_count; i++)
+    {
+        const weight_cache_record& r = records[i];
+
+        const void* padding = 0;
+        const size_t padding_size = alignSize(offset, weight_cache_align) - offset;
+        if (padding_size > 0 && dr->reference(padding_size, &padding) != padding_size)
+        {
+            NCNN_LOGE("WeightCache %s is truncated", path);
+            delete dr;
+            return -1;
+        }
+
+        const void* data = 0;
+        if (dr->reference((size_t)r.size, &data) != (size_t)r.size)
+        {
+            NCNN_LOGE("WeightCache %s is truncated", path);
+            delete dr;
+            return -1;
+        }
+
+        offset += padding_size + (size_t)r.size;
+
+        // the mapping is read-only, layers never write their transformed weights
+        void* ptr = (void*)data;
+
+        Mat m;
+        if (r.dims == 1)
+            m = Mat(r.w, ptr, (size_t)r.elemsize, r.elempack);
+        if (r.dims == 2)
+            m = Mat(r.w, r.h, ptr, (size_t)r.elemsize, r.elempack);
+        if (r.dims == 3)
+            m = Mat(r.w, r.h, r.c, ptr, (size_t)r.elemsize, r.elempack);
+        if (r.dims == 4)
+            m = Mat(r.w, r.h, r.d, r.c, ptr, (size_t)r.elemsize, r.elempack);
+
+        if (m.empty() || m.cstep != (size_t)r.cstep || m.total() * m.elemsize != (size_t)r.size)
+        {
+            NCNN_LOGE("WeightCache %s has bad entry %d", path, (int)i);
+            delete dr;
+            return -1;
+        }
+
+        if ((size_t)ptr % NCNN_MALLOC_ALIGN != 0)
+        {
+            // file read into heap memory without alignment guarantee
+            m = m.clone();
+        }
+
+        entries[i].layer_index = r.layer_index;
+        entries[i].slot = r.slot;
+        entries[i].m = m;
+    }
+
+    d->mapped_reader = dr;
+    d->mapped_key = header.key;
+    d->mapped_entries = entries;
+
+    return 0;
+}
+
+int WeightCache::save(const char* path) const
+{
+    if (d->reused)
+        return 0;
+
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("WeightCache fopen %s failed", path);
+        return -1;
+    }
+
+    const std::vector<WeightCachePrivate::weight_cache_entry>& entries = d->recorded_entries;
+
+    weight_cache_header header;
+    header.magic = weight_cache_magic;
+    header.version = weight_cache_version;
+    header.key = d->key;
+    header.entry_count = (uint32_t)entries.size();
+    header.reserved = 0;
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+    for (size_t i = 0; ok && i < entries.size(); i++)
+    {
+        const Mat& m = entries[i].m;
+
+        weight_cache_record r;
+        r.layer_index = entries[i].layer_index;
+        r.slot = entries[i].slot;
+        r.dims = m.dims;
+        r.w = m.w;
+        r.h = m.h;
+        r.d = m.d;
+        r.c = m.c;
+        r.elempack = m.elempack;
+        r.elemsize = m.elemsize;
+        r.cstep = m.cstep;
+        r.size = m.total() * m.elemsize;
+
+        ok = fwrite(&r, sizeof(r), 1, fp) == 1;
+    }
+
+    size_t offset = sizeof(header) + entries.size() * sizeof(weight_cache_record);
+
+    for (size_t i = 0; ok && i < entries.size(); i++)
+    {
+        const Mat& m = entries[i].m;
+
+        static const unsigned char zeros[weight_cache_align] = {0};
+        const size_t padding_size = alignSize(offset, weight_cache_align) - offset;
+        if (padding_size > 0)
+        {
+            ok = fwrite(zeros, 1, padding_size, fp) == padding_size;
+        }
+
+        const size_t size = m.total() * m.elemsize;
+        ok = ok && fwrite(m.data, 1, size, fp) == size;
+
+        offset += padding_size + size;
+    }
+
+    fclose(fp);
+
+    if (!ok)
+    {
+        NCNN_LOGE("WeightCache write %s failed", path);
+        return -1;
+    }
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+bool WeightCache::reused() const
+{
+    return d->reused;
+}
+
+void WeightCache::bind(uint64_t model_digest, const Option& opt, const std::vector<Layer*>& layers)
+{
+    d->layers = layers;
+    d->key = get_weight_cache_key(model_digest, opt);
+
+    d->recorded_lock.lock();
+    d->recorded_entries.clear();
+    d->recorded_lock.unlock();
+
+    d->reused = !d->mapped_entries.empty() && d->mapped_key == d->key;
+
+    if (!d->reused)
+    {
+        // stale cache of another model, option or cpu
+        d->mapped_entries.clear();
+        d->mapped_key = 0;
+#if NCNN_STDIO
+        delete d->mapped_reader;
+        d->mapped_reader = 0;
+#endif // NCNN_STDIO
+    }
+}
+
+int WeightCache::get(const Layer* layer, int slot, Mat& m) const
+{
+    if (!d->reused)
+        return -1;
+
+    const int layer_index = d->find_layer_index(layer);
+    if (layer_index == -1)
+        return -1;
+
+    for (size_t i = 0; i < d->mapped_entries.size(); i++)
+    {
+        const WeightCachePrivate::weight_cache_entry& e = d->mapped_entries[i];
+        if (e.layer_index == layer_index && e.slot == slot)
+        {
+            m = e.m;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+void WeightCache::put(const Layer* layer, int slot, const Mat& m)
+{
+    if (d->reused || m.empty())
+        return;
+
+    const int layer_index = d->find_layer_index(layer);
+    if (layer_index == -1)
+        return;
+
+    WeightCachePrivate::weight_cache_entry e;
+    e.layer_index = layer_index;
+    e.slot = slot;
+    e.m = m;
+
+    d->recorded_lock.lock();
+    d->recorded_entries.push_back(e);
+    d->recorded_lock.unlock();
+}
+
+} // namespace ncnn
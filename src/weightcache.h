@@ -0,0 +1,67 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_WEIGHTCACHE_H
+#define NCNN_WEIGHTCACHE_H
+
+#include "platform.h"
+
+#include "mat.h"
+
+#include <stdint.h>
+
+namespace ncnn {
+
+class Layer;
+class Option;
+class WeightCachePrivate;
+class NCNN_EXPORT WeightCache
+{
+public:
+    WeightCache();
+    virtual ~WeightCache();
+
+    // drop cached weights and unmap the cache file
+    void clear();
+
+#if NCNN_STDIO
+    // map cache file written by save() on a previous run
+    // cached weights are referenced in the mapped pages instead of copied
+    // so the cache should be retained as long as the net using it
+    // return 0 if success
+    int load(const char* path);
+
+    // write weights transformed while loading the net
+    // nothing is written when the net took its weights from this cache
+    // return 0 if success
+    int save(const char* path) const;
+#endif // NCNN_STDIO
+
+    // return true if the last loaded net took its weights from this cache
+    bool reused() const;
+
+    // called by net before creating layer pipelines
+    // model_digest identifies the layer params and weights
+    // cached weights are reused only if the model, option and cpu features all match
+    void bind(uint64_t model_digest, const Option& opt, const std::vector<Layer*>& layers);
+
+    // called by layer create_pipeline
+    // fetch the transformed weight in slot
+    // return 0 if found
+    int get(const Layer* layer, int slot, Mat& m) const;
+
+    // called by layer create_pipeline
+    // record the transformed weight in slot
+    void put(const Layer* layer, int slot, const Mat& m);
+
+private:
+    WeightCache(const WeightCache&);
+    WeightCache& operator=(const WeightCache&);
+
+private:
+    WeightCachePrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_WEIGHTCACHE_H
@@ -0,0 +1,206 @@
+// Copyright 2025 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdio.h>
+#include <string.h>
+
+#include "allocator.h"
+#include "mat.h"
+
+static int test_size_class_pool_allocator_reuse()
+{
+    ncnn::SizeClassPoolAllocator allocator;
+
+    static const size_t sizes[] = {1, 63, 64, 65, 100, 1000, 4096, 12345, 1000000};
+    const int count = sizeof(sizes) / sizeof(sizes[0]);
+
+    void* ptrs[count];
+    for (int i = 0; i < count; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(sizes[i]);
+        if (!ptrs[i] || ((size_t)ptrs[i] % NCNN_MALLOC_ALIGN) != 0)
+        {
+            fprintf(stderr, "size class pool allocator bad pointer %p for size %d\n", ptrs[i], (int)sizes[i]);
+            return -1;
+        }
+
+        // the whole requested range must be writable
+        memset(ptrs[i], 0xab, sizes[i]);
+    }
+
+    if (allocator.hit_count() != 0 || allocator.miss_count() != (size_t)count || allocator.bytes_held() != 0)
+    {
+        fprintf(stderr, "size class pool allocator first round stats %d %d %d\n", (int)allocator.hit_count(), (int)allocator.miss_count(), (int)allocator.bytes_held());
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    if (allocator.bytes_held() < 1000000)
+    {
+        fprintf(stderr, "size class pool allocator holds %d bytes after free\n", (int)allocator.bytes_held());
+        return -1;
+    }
+
+    // same sizes again, all served from cache
+    for (int i = 0; i < count; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(sizes[i]);
+        memset(ptrs[i], 0xcd, sizes[i]);
+    }
+
+    if (allocator.hit_count() != (size_t)count || allocator.miss_count() != (size_t)count || allocator.bytes_held() != 0)
+    {
+        fprintf(stderr, "size class pool allocator second round stats %d %d %d\n", (int)allocator.hit_count(), (int)allocator.miss_count(), (int)allocator.bytes_held());
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    allocator.clear();
+
+    if (allocator.bytes_held() != 0)
+    {
+        fprintf(stderr, "size class pool allocator holds %d bytes after clear\n", (int)allocator.bytes_held());
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_size_class_pool_allocator_shared()
+{
+    ncnn::SizeClassPoolAllocator allocator;
+    allocator.set_thread_cache_limit(2);
+
+    // overflow the thread cache into the shared freelist and take it back
+    void* ptrs[8];
+    for (int i = 0; i < 8; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(256);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        ptrs[i] = allocator.fastMalloc(256);
+    }
+
+    if (allocator.hit_count() != 8 || allocator.miss_count() != 8)
+    {
+        fprintf(stderr, "size class pool allocator shared freelist stats %d %d\n", (int)allocator.hit_count(), (int)allocator.miss_count());
+        return -1;
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        for (int j = i + 1; j < 8; j++)
+        {
+            if (ptrs[i] == ptrs[j])
+            {
+                fprintf(stderr, "size class pool allocator hands out %p twice\n", ptrs[i]);
+                return -1;
+            }
+        }
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        allocator.fastFree(ptrs[i]);
+    }
+
+    return 0;
+}
+
+#if NCNN_THREADS && !NCNN_SIMPLEOMP
+struct size_class_worker_args
+{
+    ncnn::SizeClassPoolAllocator* allocator;
+    int seed;
+    int ret;
+};
+
+static void* size_class_worker(void* args)
+{
+    size_class_worker_args* wa = (size_class_worker_args*)args;
+
+    for (int i = 0; i < 200; i++)
+    {
+        const int w = 1 + (wa->seed * 7 + i * 13) % 97;
+
+        ncnn::Mat m(w, 3, 5, (size_t)4u, wa->allocator);
+        m.fill((float)(wa->seed + i));
+
+        ncnn::Mat m2 = m.clone(wa->allocator);
+        const float* p = m2.channel(4).row(2);
+        if (p[w - 1] != (float)(wa->seed + i))
+        {
+            wa->ret = -1;
+            return 0;
+        }
+    }
+
+    wa->ret = 0;
+    return 0;
+}
+
+static int test_size_class_pool_allocator_threads()
+{
+    ncnn::SizeClassPoolAllocator allocator;
+    allocator.set_thread_cache_limit(4);
+
+    const int thread_count = 4;
+
+    size_class_worker_args args[thread_count];
+    ncnn::Thread* threads[thread_count];
+    for (int i = 0; i < thread_count; i++)
+    {
+        args[i].allocator = &allocator;
+        args[i].seed = i;
+        args[i].ret = -1;
+        threads[i] = new ncnn::Thread(size_class_worker, &args[i]);
+    }
+
+    int ret = 0;
+    for (int i = 0; i < thread_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+
+        if (args[i].ret != 0)
+        {
+            fprintf(stderr, "size class pool allocator worker %d failed\n", i);
+            ret = -1;
+        }
+    }
+
+    if (allocator.hit_count() + allocator.miss_count() != thread_count * 200 * 2)
+    {
+        fprintf(stderr, "size class pool allocator threads stats %d %d\n", (int)allocator.hit_count(), (int)allocator.miss_count());
+        return -1;
+    }
+
+    return ret;
+}
+#else
+static int test_size_class_pool_allocator_threads()
+{
+    return 0;
+}
+#endif
+
+int main()
+{
+    return 0
+           || test_size_class_pool_allocator_reuse()
+           || test_size_class_pool_allocator_shared()
+           || test_size_class_pool_allocator_threads();
+}
@@ -37,6 +37,37 @@ static int test_convolution3d(int w, int h, int d, int c, int outch, int kernel,
     return ret;
 }
 
+static int test_convolution3d_anisotropic(int w, int h, int d, int c, int outch, int kernel_w, int kernel_h, int kernel_d, int stride_w, int stride_h, int stride_d, int dilation_d, int bias)
+{
+    ncnn::Mat a = RandomMat(w, h, d, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch);       // num_output
+    pd.set(1, kernel_w);    // kernel_w
+    pd.set(11, kernel_h);   // kernel_h
+    pd.set(21, kernel_d);   // kernel_d
+    pd.set(22, dilation_d); // dilation_d
+    pd.set(3, stride_w);    // stride_w
+    pd.set(13, stride_h);   // stride_h
+    pd.set(23, stride_d);   // stride_d
+    pd.set(4, 1);           // pad_w
+    pd.set(5, bias);        // bias_term
+    pd.set(6, outch * c * kernel_w * kernel_h * kernel_d);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomMat(outch * c * kernel_w * kernel_h * kernel_d);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    int ret = test_layer("Convolution3D", pd, weights, a);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_convolution3d_anisotropic failed w=%d h=%d d=%d c=%d outch=%d kernel=%d,%d,%d stride=%d,%d,%d dilation_d=%d bias=%d\n", w, h, d, c, outch, kernel_w, kernel_h, kernel_d, stride_w, stride_h, stride_d, dilation_d, bias);
+    }
+
+    return ret;
+}
+
 static int test_convolution3d_0()
 {
     static const int kdsp[7][4] = {
@@ -75,9 +106,20 @@ static int test_convolution3d_0()
     return 0;
 }
 
+static int test_convolution3d_1()
+{
+    return 0
+           || test_convolution3d_anisotropic(12, 11, 10, 4, 8, 3, 3, 1, 1, 1, 1, 1, 1)
+           || test_convolution3d_anisotropic(12, 11, 10, 8, 16, 3, 3, 1, 2, 2, 1, 1, 0)
+           || test_convolution3d_anisotropic(12, 11, 10, 16, 4, 1, 1, 3, 1, 1, 1, 1, 1)
+           || test_convolution3d_anisotropic(12, 11, 10, 4, 12, 1, 3, 2, 1, 1, 2, 2, 0)
+           || test_convolution3d_anisotropic(12, 11, 10, 3, 8, 3, 1, 4, 1, 2, 1, 1, 1)
+           || test_convolution3d_anisotropic(12, 11, 10, 12, 13, 2, 3, 3, 2, 1, 2, 2, 1);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_convolution3d_0();
+    return test_convolution3d_0() || test_convolution3d_1();
 }
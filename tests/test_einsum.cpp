@@ -149,6 +149,60 @@ static int test_einsum_11()
     return test_einsum(a, "imnj,kmln->ijkl");
 }
 
+static int test_einsum_12()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(16, 13, 6);
+    a[1] = RandomMat(16, 24, 6);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(16, 13, 6);
+    b[1] = RandomMat(24, 13, 6);
+
+    return 0
+           || test_einsum(a, "ijm,ikm->ijk")
+           || test_einsum(b, "imj,imk->ijk");
+}
+
+static int test_einsum_13()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(19, 20);
+    a[1] = RandomMat(17, 20);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(19, 20);
+    b[1] = RandomMat(19, 17);
+
+    return 0
+           || test_einsum(a, "mj,mi->ij")
+           || test_einsum(b, "jm,im->ij");
+}
+
+static int test_einsum_14()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(11, 5, 7);
+    a[1] = RandomMat(9, 11, 5);
+
+    return test_einsum(a, "ikm,kmj->ijk");
+}
+
+static int test_einsum_15()
+{
+    std::vector<ncnn::Mat> a(2);
+    a[0] = RandomMat(10, 16, 3, 2);
+    a[1] = RandomMat(12, 16, 3, 2);
+
+    std::vector<ncnn::Mat> b(2);
+    b[0] = RandomMat(10, 16, 3, 2);
+    b[1] = RandomMat(12, 16, 2, 3);
+
+    return 0
+           || test_einsum(a, "ijmk,ijml->ijkl")
+           || test_einsum(b, "ijmk,jiml->ijkl");
+}
+
 int main()
 {
     SRAND(7767517);
@@ -165,5 +219,9 @@ int main()
            || test_einsum_8()
            || test_einsum_9()
            || test_einsum_10()
-           || test_einsum_11();
+           || test_einsum_11()
+           || test_einsum_12()
+           || test_einsum_13()
+           || test_einsum_14()
+           || test_einsum_15();
 }
@@ -487,9 +487,67 @@ static int test_mat_pixel_affine_1()
            || test_mat_pixel_affine_yuv420sp(220, 340);
 }
 
+static int test_mat_pixel_affine_threads(int w, int h, int type, int num_threads)
+{
+    for (int c = 1; c <= 4; c++)
+    {
+        ncnn::Mat a0 = RandomMat(w, h, c);
+
+        float tm[6];
+        ncnn::get_rotation_matrix(30.f, 0.7f, w / 2, h / 2, tm);
+
+        const int outw = w * 2 / 3;
+        const int outh = h * 3 / 4;
+
+        ncnn::Mat a1 = RandomMat(outw, outh, c);
+        ncnn::Mat a2 = a1.clone();
+
+        ncnn::Option opt;
+        opt.num_threads = num_threads;
+
+        if (c == 1)
+        {
+            ncnn::warpaffine_bilinear_c1(a0, w, h, w, a1, outw, outh, outw, tm, type, 0x01020304);
+            ncnn::warpaffine_bilinear_c1(a0, w, h, w, a2, outw, outh, outw, tm, type, 0x01020304, opt);
+        }
+        if (c == 2)
+        {
+            ncnn::warpaffine_bilinear_c2(a0, w, h, w * 2, a1, outw, outh, outw * 2, tm, type, 0x01020304);
+            ncnn::warpaffine_bilinear_c2(a0, w, h, w * 2, a2, outw, outh, outw * 2, tm, type, 0x01020304, opt);
+        }
+        if (c == 3)
+        {
+            ncnn::warpaffine_bilinear_c3(a0, w, h, w * 3, a1, outw, outh, outw * 3, tm, type, 0x01020304);
+            ncnn::warpaffine_bilinear_c3(a0, w, h, w * 3, a2, outw, outh, outw * 3, tm, type, 0x01020304, opt);
+        }
+        if (c == 4)
+        {
+            ncnn::warpaffine_bilinear_c4(a0, w, h, w * 4, a1, outw, outh, outw * 4, tm, type, 0x01020304);
+            ncnn::warpaffine_bilinear_c4(a0, w, h, w * 4, a2, outw, outh, outw * 4, tm, type, 0x01020304, opt);
+        }
+
+        // splitting rows across threads must not change any pixel
+        if (memcmp(a1, a2, outw * outh * c) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_affine_threads failed w=%d h=%d c=%d type=%d num_threads=%d\n", w, h, c, type, num_threads);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_affine_2()
+{
+    return 0
+           || test_mat_pixel_affine_threads(60, 70, 0, 2)
+           || test_mat_pixel_affine_threads(121, 163, -233, 3)
+           || test_mat_pixel_affine_threads(220, 330, 0, 4);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_mat_pixel_affine_0() || test_mat_pixel_affine_1();
+    return test_mat_pixel_affine_0() || test_mat_pixel_affine_1() || test_mat_pixel_affine_2();
 }
@@ -114,6 +114,193 @@ static int test_mat_pixel_resize(int w, int h, int ch, int target_width, int tar
     return 0;
 }
 
+static void resize_pixels(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, int ch, int resize_type)
+{
+    if (resize_type == 2)
+    {
+        if (ch == 1) ncnn::resize_bilinear_c1(src, srcw, srch, dst, w, h);
+        if (ch == 2) ncnn::resize_bilinear_c2(src, srcw, srch, dst, w, h);
+        if (ch == 3) ncnn::resize_bilinear_c3(src, srcw, srch, dst, w, h);
+        if (ch == 4) ncnn::resize_bilinear_c4(src, srcw, srch, dst, w, h);
+    }
+    if (resize_type == 3)
+    {
+        if (ch == 1) ncnn::resize_bicubic_c1(src, srcw, srch, dst, w, h);
+        if (ch == 2) ncnn::resize_bicubic_c2(src, srcw, srch, dst, w, h);
+        if (ch == 3) ncnn::resize_bicubic_c3(src, srcw, srch, dst, w, h);
+        if (ch == 4) ncnn::resize_bicubic_c4(src, srcw, srch, dst, w, h);
+    }
+    if (resize_type == 4)
+    {
+        if (ch == 1) ncnn::resize_area_c1(src, srcw, srch, dst, w, h);
+        if (ch == 2) ncnn::resize_area_c2(src, srcw, srch, dst, w, h);
+        if (ch == 3) ncnn::resize_area_c3(src, srcw, srch, dst, w, h);
+        if (ch == 4) ncnn::resize_area_c4(src, srcw, srch, dst, w, h);
+    }
+}
+
+static void resize_pixels(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, int ch, int resize_type, const ncnn::Option& opt)
+{
+    if (resize_type == 2)
+    {
+        if (ch == 1) ncnn::resize_bilinear_c1(src, srcw, srch, srcw, dst, w, h, w, opt);
+        if (ch == 2) ncnn::resize_bilinear_c2(src, srcw, srch, srcw * 2, dst, w, h, w * 2, opt);
+        if (ch == 3) ncnn::resize_bilinear_c3(src, srcw, srch, srcw * 3, dst, w, h, w * 3, opt);
+        if (ch == 4) ncnn::resize_bilinear_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4, opt);
+    }
+    if (resize_type == 3)
+    {
+        if (ch == 1) ncnn::resize_bicubic_c1(src, srcw, srch, srcw, dst, w, h, w, opt);
+        if (ch == 2) ncnn::resize_bicubic_c2(src, srcw, srch, srcw * 2, dst, w, h, w * 2, opt);
+        if (ch == 3) ncnn::resize_bicubic_c3(src, srcw, srch, srcw * 3, dst, w, h, w * 3, opt);
+        if (ch == 4) ncnn::resize_bicubic_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4, opt);
+    }
+    if (resize_type == 4)
+    {
+        if (ch == 1) ncnn::resize_area_c1(src, srcw, srch, srcw, dst, w, h, w, opt);
+        if (ch == 2) ncnn::resize_area_c2(src, srcw, srch, srcw * 2, dst, w, h, w * 2, opt);
+        if (ch == 3) ncnn::resize_area_c3(src, srcw, srch, srcw * 3, dst, w, h, w * 3, opt);
+        if (ch == 4) ncnn::resize_area_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4, opt);
+    }
+}
+
+static int test_mat_pixel_resize_bicubic(int w, int h, int ch, int target_width, int target_height)
+{
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    ncnn::Mat b(target_width, target_height, 1, (size_t)ch, ch);
+
+    resize_pixels(a, w, h, b, target_width, target_height, ch, 3);
+
+    ncnn::Mat a2;
+    ncnn::convert_packing(a, a2, 1, opt);
+
+    ncnn::Mat b2;
+    ncnn::convert_packing(b, b2, 1, opt);
+
+    for (int i = 0; i < ch; i++)
+    {
+        ncnn::Mat c = ncnn::Mat::from_pixels(a2.channel(i), ncnn::Mat::PIXEL_GRAY, w, h);
+        ncnn::Mat d = ncnn::Mat::from_pixels(b2.channel(i), ncnn::Mat::PIXEL_GRAY, target_width, target_height);
+
+        ncnn::Mat e;
+        ncnn::resize_bicubic(c, e, target_width, target_height, opt);
+
+        // the pixel resize saturates the overshoot
+        for (int j = 0; j < target_width * target_height; j++)
+        {
+            float v = std::min(std::max(e[j], 0.f), 255.f);
+            if (fabs(v - d[j]) > 1.f)
+            {
+                fprintf(stderr, "test_mat_pixel_resize_bicubic failed w=%d h=%d ch=%d target_width=%d target_height=%d  expect %f but got %f\n", w, h, ch, target_width, target_height, v, d[j]);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_resize_area(int w, int h, int ch, int target_width, int target_height)
+{
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    ncnn::Mat b(target_width, target_height, 1, (size_t)ch, ch);
+
+    resize_pixels(a, w, h, b, target_width, target_height, ch, 4);
+
+    // average of the source area covered by each output pixel
+    const float scale_x = (float)w / target_width;
+    const float scale_y = (float)h / target_height;
+
+    for (int y = 0; y < target_height; y++)
+    {
+        for (int x = 0; x < target_width; x++)
+        {
+            for (int k = 0; k < ch; k++)
+            {
+                float sum = 0.f;
+                for (int sy = 0; sy < h; sy++)
+                {
+                    float cy = std::min(sy + 1.f, (y + 1) * scale_y) - std::max((float)sy, y * scale_y);
+                    if (cy <= 0.f)
+                        continue;
+
+                    for (int sx = 0; sx < w; sx++)
+                    {
+                        float cx = std::min(sx + 1.f, (x + 1) * scale_x) - std::max((float)sx, x * scale_x);
+                        if (cx <= 0.f)
+                            continue;
+
+                        sum += a.row<const unsigned char>(sy)[sx * ch + k] * cx * cy;
+                    }
+                }
+
+                float v = sum / (scale_x * scale_y);
+                float d = b.row<const unsigned char>(y)[x * ch + k];
+                if (fabs(v - d) > 1.f)
+                {
+                    fprintf(stderr, "test_mat_pixel_resize_area failed w=%d h=%d ch=%d target_width=%d target_height=%d  expect %f but got %f\n", w, h, ch, target_width, target_height, v, d);
+                    return -1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_resize_threads(int w, int h, int ch, int target_width, int target_height, int resize_type, int num_threads)
+{
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    ncnn::Mat b(target_width, target_height, 1, (size_t)ch, ch);
+    ncnn::Mat c(target_width, target_height, 1, (size_t)ch, ch);
+
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    resize_pixels(a, w, h, b, target_width, target_height, ch, resize_type);
+    resize_pixels(a, w, h, c, target_width, target_height, ch, resize_type, opt);
+
+    // splitting rows across threads must not change any pixel
+    if (memcmp(b, c, target_width * target_height * ch) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_resize_threads failed w=%d h=%d ch=%d target_width=%d target_height=%d resize_type=%d num_threads=%d\n", w, h, ch, target_width, target_height, resize_type, num_threads);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_resize_type(int w, int h, int type, int target_width, int target_height, int resize_type)
+{
+    const int ch = (type == ncnn::Mat::PIXEL_GRAY) ? 1 : (type == ncnn::Mat::PIXEL_RGB || type == ncnn::Mat::PIXEL_BGR) ? 3 : 4;
+
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    ncnn::Mat b(target_width, target_height, 1, (size_t)ch, ch);
+
+    resize_pixels(a, w, h, b, target_width, target_height, ch, resize_type);
+
+    ncnn::Option opt;
+    opt.num_threads = 2;
+
+    ncnn::Mat c = ncnn::Mat::from_pixels_resize(a, type, w, h, target_width, target_height, resize_type, opt);
+    ncnn::Mat d = ncnn::Mat::from_pixels(b, type, target_width, target_height);
+
+    if (Compare(c, d, 0.f) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_resize_type failed w=%d h=%d type=%d target_width=%d target_height=%d resize_type=%d\n", w, h, type, target_width, target_height, resize_type);
+        return -1;
+    }
+
+    return 0;
+}
+
 static int test_mat_pixel_roi_resize_gray(int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height)
 {
     ncnn::Option opt;
@@ -282,6 +469,116 @@ static int test_mat_pixel_roi_resize_bgra(int w, int h, int roix, int roiy, int
     return 0;
 }
 
+static ncnn::Mat CastBack(const ncnn::Mat& m, int cast_type, const ncnn::Option& opt)
+{
+    ncnn::Mat m_fp32 = m;
+    if (cast_type == 2)
+        ncnn::cast_float16_to_float32(m, m_fp32, opt);
+    if (cast_type == 4)
+        ncnn::cast_bfloat16_to_float32(m, m_fp32, opt);
+
+    ncnn::Mat m_unpacked;
+    ncnn::convert_packing(m_fp32, m_unpacked, 1, opt);
+    return m_unpacked;
+}
+
+static ncnn::Mat CastRoundTrip(const ncnn::Mat& m, int cast_type, const ncnn::Option& opt)
+{
+    ncnn::Mat m_cast = m;
+    if (cast_type == 2)
+        ncnn::cast_float32_to_float16(m, m_cast, opt);
+    if (cast_type == 4)
+        ncnn::cast_float32_to_bfloat16(m, m_cast, opt);
+
+    return CastBack(m_cast, cast_type, opt);
+}
+
+static int test_mat_pixel_roi_resize_normalize(int w, int h, int type, int roix, int roiy, int roiw, int roih, int target_width, int target_height, int elempack, int cast_type, int num_threads)
+{
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    const int type_from = type & ncnn::Mat::PIXEL_FORMAT_MASK;
+    const int ch = type_from == ncnn::Mat::PIXEL_GRAY ? 1 : (type_from == ncnn::Mat::PIXEL_RGB || type_from == ncnn::Mat::PIXEL_BGR) ? 3 : 4;
+
+    const float mean_vals[4] = {104.f, 117.f, 123.f, 127.5f};
+    const float norm_vals[4] = {0.017f, 0.0175f, 0.0171f, 1 / 255.f};
+
+    ncnn::Mat a = RandomMat(w, h, ch);
+
+    for (int i = 0; i < 4; i++)
+    {
+        const float* mean = i & 1 ? mean_vals : 0;
+        const float* norm = i & 2 ? norm_vals : 0;
+
+        ncnn::Mat m = ncnn::Mat::from_pixels_roi_resize_normalize(a, type, w, h, roix, roiy, roiw, roih, target_width, target_height, mean, norm, elempack, cast_type, opt);
+
+        ncnn::Mat b = ncnn::Mat::from_pixels_roi_resize(a, type, w, h, roix, roiy, roiw, roih, target_width, target_height);
+        b.substract_mean_normalize(mean, norm);
+
+        if (m.elempack != elempack || m.elemsize != (size_t)(cast_type == 1 ? 4 : 2) * elempack || Compare(CastRoundTrip(b, cast_type, opt), CastBack(m, cast_type, opt), cast_type == 4 ? 0.01 : 0.001) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_roi_resize_normalize failed w=%d h=%d type=%d roi=[%d %d %d %d] target_width=%d target_height=%d elempack=%d cast_type=%d num_threads=%d mean_norm=%d\n", w, h, type, roix, roiy, roiw, roih, target_width, target_height, elempack, cast_type, num_threads, i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_yuv420sp_roi_resize_normalize(int w, int h, int type, int roix, int roiy, int roiw, int roih, int target_width, int target_height, int elempack, int cast_type, int num_threads)
+{
+    ncnn::Option opt;
+    opt.num_threads = num_threads;
+
+    const float mean_vals[4] = {104.f, 117.f, 123.f, 127.5f};
+    const float norm_vals[4] = {0.017f, 0.0175f, 0.0171f, 1 / 255.f};
+
+    ncnn::Mat a = RandomMat(w, h * 3 / 2, 1);
+
+    // crop the roi from the y and vu planes
+    ncnn::Mat a_roi = RandomMat(roiw, roih * 3 / 2, 1);
+    for (int y = 0; y < roih; y++)
+    {
+        memcpy((unsigned char*)a_roi + y * roiw, (const unsigned char*)a + (roiy + y) * w + roix, roiw);
+    }
+    for (int y = 0; y < roih / 2; y++)
+    {
+        memcpy((unsigned char*)a_roi + roiw * roih + y * roiw, (const unsigned char*)a + w * h + (roiy / 2 + y) * w + roix, roiw);
+    }
+
+    ncnn::Mat a_resized = RandomMat(target_width, target_height * 3 / 2, 1);
+    ncnn::resize_bilinear_yuv420sp(a_roi, roiw, roih, a_resized, target_width, target_height);
+
+    const int rgb_type = type == ncnn::Mat::PIXEL_RGB ? ncnn::Mat::PIXEL_RGB : ncnn::Mat::PIXEL_RGB | (type << ncnn::Mat::PIXEL_CONVERT_SHIFT);
+
+    for (int nv12 = 0; nv12 < 2; nv12++)
+    {
+        ncnn::Mat rgb = RandomMat(target_width, target_height, 3);
+        if (nv12)
+            ncnn::yuv420sp2rgb_nv12(a_resized, target_width, target_height, rgb);
+        else
+            ncnn::yuv420sp2rgb(a_resized, target_width, target_height, rgb);
+
+        ncnn::Mat m;
+        if (nv12)
+            m = ncnn::Mat::from_yuv420sp_nv12_roi_resize_normalize(a, type, w, h, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, opt);
+        else
+            m = ncnn::Mat::from_yuv420sp_roi_resize_normalize(a, type, w, h, roix, roiy, roiw, roih, target_width, target_height, mean_vals, norm_vals, elempack, cast_type, opt);
+
+        ncnn::Mat b = ncnn::Mat::from_pixels(rgb, rgb_type, target_width, target_height);
+        b.substract_mean_normalize(mean_vals, norm_vals);
+
+        if (m.elempack != elempack || Compare(CastRoundTrip(b, cast_type, opt), CastBack(m, cast_type, opt), cast_type == 4 ? 0.01 : 0.001) != 0)
+        {
+            fprintf(stderr, "test_mat_yuv420sp_roi_resize_normalize failed w=%d h=%d type=%d roi=[%d %d %d %d] target_width=%d target_height=%d elempack=%d cast_type=%d num_threads=%d nv12=%d\n", w, h, type, roix, roiy, roiw, roih, target_width, target_height, elempack, cast_type, num_threads, nv12);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
 static int test_mat_pixel_0()
 {
     for (int c = 1; c <= 4; c++)
@@ -291,7 +588,9 @@ static int test_mat_pixel_0()
                   || test_mat_pixel_resize(13, 17, c, 11, 14)
                   || test_mat_pixel_resize(33, 23, c, 5, 6)
                   || test_mat_pixel_resize(5, 4, c, 11, 16)
-                  || test_mat_pixel_resize(23, 11, c, 15, 21);
+                  || test_mat_pixel_resize(23, 11, c, 15, 21)
+                  || test_mat_pixel_resize(67, 45, c, 131, 29)
+                  || test_mat_pixel_resize(120, 97, c, 53, 88);
 
         if (ret != 0)
             return ret;
@@ -320,9 +619,85 @@ static int test_mat_pixel_2()
            || test_mat_pixel_roi_resize_bgra(15, 15, 7, 3, 1, 1, 1, 1);
 }
 
+static int test_mat_pixel_3()
+{
+    return 0
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_GRAY, 1, 1, 13, 13, 10, 11, 1, 1, 1)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_RGB, 2, 1, 11, 11, 22, 13, 1, 1, 2)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_BGR2RGB, 1, 2, 11, 9, 19, 23, 1, 2, 3)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_BGR2GRAY, 0, 0, 16, 16, 7, 5, 1, 4, 1)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_RGB2BGRA, 3, 2, 9, 11, 12, 4, 4, 1, 2)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_GRAY2RGB, 2, 3, 9, 7, 9, 7, 1, 1, 1)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_RGBA, 2, 3, 9, 7, 7, 7, 4, 2, 4)
+           || test_mat_pixel_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_RGBA2RGB, 0, 0, 16, 16, 16, 16, 1, 4, 2)
+           || test_mat_pixel_roi_resize_normalize(15, 15, ncnn::Mat::PIXEL_BGRA2GRAY, 3, 4, 5, 4, 5, 4, 1, 1, 1)
+           || test_mat_pixel_roi_resize_normalize(15, 15, ncnn::Mat::PIXEL_BGRA2RGBA, 4, 5, 6, 7, 33, 31, 4, 4, 3)
+           || test_mat_pixel_roi_resize_normalize(15, 15, ncnn::Mat::PIXEL_BGR, 6, 6, 3, 4, 1, 3, 1, 1, 2)
+           || test_mat_pixel_roi_resize_normalize(15, 15, ncnn::Mat::PIXEL_GRAY2BGRA, 7, 3, 1, 1, 1, 1, 4, 1, 1);
+}
+
+static int test_mat_pixel_4()
+{
+    return 0
+           || test_mat_yuv420sp_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_RGB, 0, 0, 16, 16, 16, 16, 1, 1, 1)
+           || test_mat_yuv420sp_roi_resize_normalize(16, 16, ncnn::Mat::PIXEL_BGR, 2, 4, 10, 8, 20, 12, 1, 2, 2)
+           || test_mat_yuv420sp_roi_resize_normalize(24, 18, ncnn::Mat::PIXEL_GRAY, 4, 2, 14, 12, 6, 8, 1, 1, 3)
+           || test_mat_yuv420sp_roi_resize_normalize(24, 18, ncnn::Mat::PIXEL_RGBA, 6, 0, 18, 18, 10, 6, 4, 4, 2)
+           || test_mat_yuv420sp_roi_resize_normalize(12, 12, ncnn::Mat::PIXEL_BGRA, 2, 2, 6, 6, 18, 14, 4, 1, 1);
+}
+
+static int test_mat_pixel_5()
+{
+    for (int c = 1; c <= 4; c++)
+    {
+        for (int resize_type = 2; resize_type <= 4; resize_type++)
+        {
+            int ret = 0
+                      || test_mat_pixel_resize_threads(24, 48, c, 24, 48, resize_type, 2)
+                      || test_mat_pixel_resize_threads(67, 45, c, 131, 29, resize_type, 3)
+                      || test_mat_pixel_resize_threads(120, 97, c, 53, 88, resize_type, 4)
+                      || test_mat_pixel_resize_threads(13, 17, c, 11, 3, resize_type, 8);
+
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_6()
+{
+    for (int c = 1; c <= 4; c++)
+    {
+        int ret = 0
+                  || test_mat_pixel_resize_bicubic(24, 48, c, 24, 48)
+                  || test_mat_pixel_resize_bicubic(13, 17, c, 11, 14)
+                  || test_mat_pixel_resize_bicubic(33, 23, c, 5, 6)
+                  || test_mat_pixel_resize_bicubic(5, 4, c, 11, 16)
+                  || test_mat_pixel_resize_bicubic(3, 2, c, 7, 5)
+                  || test_mat_pixel_resize_bicubic(67, 45, c, 131, 29)
+                  || test_mat_pixel_resize_area(24, 48, c, 24, 48)
+                  || test_mat_pixel_resize_area(48, 32, c, 12, 8)
+                  || test_mat_pixel_resize_area(13, 17, c, 11, 14)
+                  || test_mat_pixel_resize_area(33, 23, c, 5, 6)
+                  || test_mat_pixel_resize_area(131, 97, c, 29, 17)
+                  || test_mat_pixel_resize_area(320, 240, c, 7, 5);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0
+           || test_mat_pixel_resize_type(33, 23, ncnn::Mat::PIXEL_GRAY, 15, 21, 2)
+           || test_mat_pixel_resize_type(33, 23, ncnn::Mat::PIXEL_RGB, 51, 11, 3)
+           || test_mat_pixel_resize_type(33, 23, ncnn::Mat::PIXEL_BGRA, 15, 7, 4)
+           || test_mat_pixel_resize_type(33, 23, ncnn::Mat::PIXEL_RGBA, 65, 47, 4);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_mat_pixel_0() || test_mat_pixel_1() || test_mat_pixel_2();
+    return test_mat_pixel_0() || test_mat_pixel_1() || test_mat_pixel_2() || test_mat_pixel_3() || test_mat_pixel_4() || test_mat_pixel_5() || test_mat_pixel_6();
 }
@@ -178,11 +178,13 @@ static int test_reduction_0()
     ncnn::Mat a = RandomMat(5, 6, 7, 24);
     ncnn::Mat b = RandomMat(7, 8, 9, 12);
     ncnn::Mat c = RandomMat(3, 4, 5, 13);
+    ncnn::Mat d = RandomMat(2, 3, 4, 32);
 
     return 0
            || test_reduction_nd(a)
            || test_reduction_nd(b)
-           || test_reduction_nd(c);
+           || test_reduction_nd(c)
+           || test_reduction_nd(d);
 }
 
 static int test_reduction_1()
@@ -190,11 +192,13 @@ static int test_reduction_1()
     ncnn::Mat a = RandomMat(5, 7, 24);
     ncnn::Mat b = RandomMat(7, 9, 12);
     ncnn::Mat c = RandomMat(3, 5, 13);
+    ncnn::Mat d = RandomMat(6, 5, 32);
 
     return 0
            || test_reduction_nd(a)
            || test_reduction_nd(b)
-           || test_reduction_nd(c);
+           || test_reduction_nd(c)
+           || test_reduction_nd(d);
 }
 
 static int test_reduction_2()
@@ -202,11 +206,13 @@ static int test_reduction_2()
     ncnn::Mat a = RandomMat(15, 24);
     ncnn::Mat b = RandomMat(17, 12);
     ncnn::Mat c = RandomMat(19, 15);
+    ncnn::Mat d = RandomMat(13, 32);
 
     return 0
            || test_reduction_nd(a)
            || test_reduction_nd(b)
-           || test_reduction_nd(c);
+           || test_reduction_nd(c)
+           || test_reduction_nd(d);
 }
 
 static int test_reduction_3()
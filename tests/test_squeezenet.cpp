@@ -4,6 +4,7 @@
 #include "platform.h"
 #include "net.h"
 #include "testutil.h"
+#include "weightcache.h"
 
 #include <stdio.h>
 
@@ -230,6 +231,345 @@ static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float e
     return check_top2(cls_scores, epsilon);
 }
 
+static int test_squeezenet_arena(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+    squeezenet.opt.use_local_arena_allocator = true;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    // the first pass records blob lifetimes, the following passes run on the planned arena
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Extractor ex = squeezenet.create_extractor();
+
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        ex.extract("prob", out);
+
+        std::vector<float> cls_scores;
+        cls_scores.resize(out.w);
+        for (int j = 0; j < out.w; j++)
+        {
+            cls_scores[j] = out[j];
+        }
+
+        int ret = check_top2(cls_scores, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_arena failed at pass %d\n", i);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_extractor_threads(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    // thread count differs from the one used at load time
+    const int num_threads[3] = {1, 4, 3};
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Extractor ex = squeezenet.create_extractor();
+        ex.set_num_threads(num_threads[i]);
+
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        ex.extract("prob", out);
+
+        std::vector<float> cls_scores;
+        cls_scores.resize(out.w);
+        for (int j = 0; j < out.w; j++)
+        {
+            cls_scores[j] = out[j];
+        }
+
+        int ret = check_top2(cls_scores, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_extractor_threads failed with num_threads=%d\n", num_threads[i]);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_batch(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    std::vector<ncnn::Mat> in_batch(3);
+    for (int i = 0; i < 3; i++)
+    {
+        in_batch[i] = in.clone();
+    }
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+
+    ex.input("data", in_batch);
+
+    std::vector<ncnn::Mat> out_batch;
+    int ret = ex.extract("prob", out_batch);
+    if (ret != 0 || out_batch.size() != 3)
+    {
+        fprintf(stderr, "test_squeezenet_batch extract failed\n");
+        return -1;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        const ncnn::Mat& out = out_batch[i];
+
+        std::vector<float> cls_scores;
+        cls_scores.resize(out.w);
+        for (int j = 0; j < out.w; j++)
+        {
+            cls_scores[j] = out[j];
+        }
+
+        ret = check_top2(cls_scores, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_batch failed at sample %d\n", i);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+static int test_squeezenet_mmap(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    int ret = squeezenet.load_model_mmap(MODEL_DIR "/squeezenet_v1.1.bin");
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_model_mmap failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+
+    ex.input("data", in);
+
+    ncnn::Mat out;
+    ex.extract("prob", out);
+
+    std::vector<float> cls_scores;
+    cls_scores.resize(out.w);
+    for (int j = 0; j < out.w; j++)
+    {
+        cls_scores[j] = out[j];
+    }
+
+    return check_top2(cls_scores, epsilon);
+}
+
+static int test_squeezenet_parallel_pipeline(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+    squeezenet.opt.num_threads = 4;
+    squeezenet.opt.use_parallel_pipeline_creation = true;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    int ret = squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_model with parallel pipeline creation failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+
+    ex.input("data", in);
+
+    ncnn::Mat out;
+    ex.extract("prob", out);
+
+    std::vector<float> cls_scores;
+    cls_scores.resize(out.w);
+    for (int j = 0; j < out.w; j++)
+    {
+        cls_scores[j] = out[j];
+    }
+
+    return check_top2(cls_scores, epsilon);
+}
+
+static int test_squeezenet_weight_cache(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    const char* cachepath = "test_squeezenet_weight_cache.bin";
+
+    // first run transforms the weights and records them
+    {
+        ncnn::WeightCache weight_cache;
+
+        ncnn::Net squeezenet;
+
+        squeezenet.opt = opt;
+        squeezenet.opt.weight_cache = &weight_cache;
+
+        squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+        squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+        if (weight_cache.reused() || weight_cache.save(cachepath) != 0)
+        {
+            fprintf(stderr, "weight cache save failed\n");
+            return -1;
+        }
+    }
+
+    // second run takes them from the cache file
+    ncnn::WeightCache weight_cache;
+    if (weight_cache.load(cachepath) != 0)
+    {
+        fprintf(stderr, "weight cache load failed\n");
+        return -1;
+    }
+
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+    squeezenet.opt.weight_cache = &weight_cache;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    if (!weight_cache.reused())
+    {
+        fprintf(stderr, "weight cache not reused\n");
+        return -1;
+    }
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+
+    ex.input("data", in);
+
+    ncnn::Mat out;
+    ex.extract("prob", out);
+
+    std::vector<float> cls_scores;
+    cls_scores.resize(out.w);
+    for (int j = 0; j < out.w; j++)
+    {
+        cls_scores[j] = out[j];
+    }
+
+    return check_top2(cls_scores, epsilon);
+}
+
+static int test_squeezenet_profiling(const ncnn::Option& opt, float epsilon = 0.001)
+{
+    ncnn::Net squeezenet;
+
+    squeezenet.opt = opt;
+
+    squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+    squeezenet.load_model(MODEL_DIR "/squeezenet_v1.1.bin");
+
+    ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
+
+    const float mean_vals[3] = {104.f, 117.f, 123.f};
+    in.substract_mean_normalize(mean_vals, 0);
+
+    ncnn::Extractor ex = squeezenet.create_extractor();
+    ex.set_profiling(true);
+
+    ex.input("data", in);
+
+    ncnn::Mat out;
+    ex.extract("prob", out);
+
+    // every layer but the input runs once
+    const std::vector<ncnn::LayerProfile>& profiles = ex.layer_profiles();
+    if (profiles.size() + 1 != squeezenet.layers().size())
+    {
+        fprintf(stderr, "layer profiles count %d, expect %d\n", (int)profiles.size(), (int)squeezenet.layers().size() - 1);
+        return -1;
+    }
+
+    for (size_t i = 0; i < profiles.size(); i++)
+    {
+        const ncnn::LayerProfile& lp = profiles[i];
+        const ncnn::Layer* layer = squeezenet.layers()[lp.layer_index];
+        if (lp.end < lp.start || lp.convert_time > lp.end - lp.start || lp.bottom_shapes.size() != layer->bottoms.size() || lp.top_shapes.size() != layer->tops.size())
+        {
+            fprintf(stderr, "layer profile %d is inconsistent\n", lp.layer_index);
+            return -1;
+        }
+    }
+
+    if (ex.save_chrome_trace("test_squeezenet_profiling.json") != 0)
+    {
+        fprintf(stderr, "save_chrome_trace failed\n");
+        return -1;
+    }
+
+    std::vector<float> cls_scores;
+    cls_scores.resize(out.w);
+    for (int j = 0; j < out.w; j++)
+    {
+        cls_scores[j] = out[j];
+    }
+
+    return check_top2(cls_scores, epsilon);
+}
+
 class MyConvolution : public ncnn::Layer
 {
 public:
@@ -503,5 +843,113 @@ int main()
 #endif // NCNN_VULKAN
     }
 
+    for (int i = 0; i < 2; i++)
+    {
+        // run the fire module branches concurrently
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+        opt.use_parallel_layer_scheduling = true;
+        opt.num_threads = 4;
+
+        int ret = test_squeezenet(opt, load_model_types[i], 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet parallel layer scheduling failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_arena(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_arena failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+        opt.num_threads = 2;
+
+        int ret = test_squeezenet_extractor_threads(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_extractor_threads failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_batch(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_batch failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_mmap(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_mmap failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_parallel_pipeline(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_parallel_pipeline failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_weight_cache(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_weight_cache failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Option opt = opts[i];
+        opt.use_vulkan_compute = false;
+
+        int ret = test_squeezenet_profiling(opt, 0.01);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet_profiling failed use_packing_layout=%d\n", opt.use_packing_layout);
+            return ret;
+        }
+    }
+
     return 0;
 }